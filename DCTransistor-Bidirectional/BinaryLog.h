@@ -0,0 +1,213 @@
+#include <Arduino.h>
+
+/*
+    Defines BinaryLog class - structured debug logging that never blocks loop() on Serial.
+
+    Each call packs a fixed-size binary record (time, level, event, four 16-bit arguments) into a lock-free
+    single-producer / single-consumer byte ring. loop() only ever writes to the ring. The ring is drained to Serial
+    by a recurrent function on the ESP8266 scheduler, which runs whenever the sketch yields, and only as many bytes
+    as the UART FIFO has room for - so a debug build keeps production timing. If the ring is full the record is
+    dropped and counted, and an EV_LOG_DROPPED record is logged once there is room again.
+
+    Frame on the wire (16 bytes): 0xA5 sync, millis() (4 bytes LE), level, event, a, b, c, d (int16 LE), XOR of the
+    14 payload bytes. Text from PRINT / PROFILE can share the port - it is plain ASCII and never contains 0xA5.
+    Decode with misc_files/decode_log.py, which reads event names and argument labels from the LogEvent enum below.
+
+    Levels are compile time: LOG_LEVEL in config.h. Calls above it compile to nothing, and with LOG_LEVEL_NONE
+    the log and its ring buffer don't exist at all.
+*/
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN 2
+#define LOG_LEVEL_INFO 3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+  #define LOG_LEVEL LOG_LEVEL_NONE
+#endif
+
+#define LOG_SYNC 0xA5
+#define LOG_PAYLOAD_LEN 14
+#define LOG_FRAME_LEN (LOG_PAYLOAD_LEN + 2)
+
+//Events. decode_log.py parses this enum: one event per line, argument labels in the trailing comment.
+enum LogEvent : uint8_t {
+  EV_LOG_DROPPED, //a=records dropped
+  EV_LOOP_START, //a=loop
+  EV_HTTP_FAILED, //a=http_code
+  EV_FEED_NOT_FOUND, //
+  EV_DESERIALIZE_FAILED, //a=error_code b=doc_size c=doc_capacity d=overflowed
+  EV_TRAIN, //a=line b=direction c=station d=train_id
+  EV_TRAIN_UNMATCHED, //a=direction b=line_code
+  EV_SPECIAL_TRAIN, //a=line b=station c=direction d=ITT
+  EV_LINE_COUNT, //a=line b=trains
+  EV_PARSE_DONE, //a=trains b=failures c=parse_ms
+  EV_FEED_EMPTY, //
+  EV_DATA_FAILURE, //a=failures
+  NUM_LOG_EVENTS
+};
+
+template<uint16_t N>
+class BinaryLog {
+
+  static_assert((N & (N - 1)) == 0, "BinaryLog ring size must be a power of 2");
+  static_assert(N >= 2 * LOG_FRAME_LEN, "BinaryLog ring must hold at least two frames");
+
+  private:
+    uint8_t ring[N];
+    volatile uint16_t head; //Next byte written. Only the producer (log) moves it.
+    volatile uint16_t tail; //Next byte drained. Only the consumer (drain) moves it.
+    uint16_t dropped; //Records dropped since last EV_LOG_DROPPED. Producer only.
+    uint32_t dropped_total;
+
+    uint16_t freeBytes();
+    bool push(uint8_t level, uint8_t event, int16_t a, int16_t b, int16_t c, int16_t d);
+
+  public:
+    BinaryLog();
+
+    //Producer side. Never blocks: returns false and counts a drop if the ring is full.
+    bool log(uint8_t level, uint8_t event, int16_t a = 0, int16_t b = 0, int16_t c = 0, int16_t d = 0);
+
+    //Consumer side. Writes at most max_bytes (e.g. Serial.availableForWrite()). Returns bytes written.
+    size_t drain(Print &out, size_t max_bytes);
+
+    //Getters
+    uint16_t pending(); //Bytes waiting to be drained
+    uint32_t getDropped(); //Records dropped since boot
+
+};//END BinaryLog definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<uint16_t N>
+BinaryLog<N>::BinaryLog(){
+  head = 0;
+  tail = 0;
+  dropped = 0;
+  dropped_total = 0;
+}
+
+template<uint16_t N>
+uint16_t BinaryLog<N>::pending(){
+  return (uint16_t)(head - tail) & (N - 1);
+}
+
+template<uint16_t N>
+uint16_t BinaryLog<N>::freeBytes(){
+  return (N - 1) - pending(); //One byte kept empty so full and empty differ
+}
+
+template<uint16_t N>
+bool BinaryLog<N>::push(uint8_t level, uint8_t event, int16_t a, int16_t b, int16_t c, int16_t d){
+  uint8_t payload[LOG_PAYLOAD_LEN];
+  uint32_t ms = millis();
+  payload[0] = ms;
+  payload[1] = ms >> 8;
+  payload[2] = ms >> 16;
+  payload[3] = ms >> 24;
+  payload[4] = level;
+  payload[5] = event;
+  int16_t args[4] = {a, b, c, d};
+  for(uint8_t i=0; i<4; i++){
+    payload[6 + (2 * i)] = (uint16_t)args[i];
+    payload[7 + (2 * i)] = (uint16_t)args[i] >> 8;
+  }
+
+  uint16_t h = head;
+  uint8_t check = 0;
+  ring[h] = LOG_SYNC;
+  h = (h + 1) & (N - 1);
+  for(uint8_t i=0; i<LOG_PAYLOAD_LEN; i++){
+    ring[h] = payload[i];
+    check ^= payload[i];
+    h = (h + 1) & (N - 1);
+  }
+  ring[h] = check;
+  h = (h + 1) & (N - 1);
+
+  __asm__ __volatile__("" ::: "memory"); //Frame bytes land before the consumer can see the new head
+  head = h;
+  return true;
+}
+
+template<uint16_t N>
+bool BinaryLog<N>::log(uint8_t level, uint8_t event, int16_t a, int16_t b, int16_t c, int16_t d){
+  //Report earlier drops first, if there's room for that and this record
+  if(dropped > 0 && freeBytes() >= 2 * LOG_FRAME_LEN){
+    push(LOG_LEVEL_WARN, EV_LOG_DROPPED, (dropped > 0x7FFF) ? 0x7FFF : dropped, 0, 0, 0);
+    dropped = 0;
+  }
+
+  if(dropped > 0 || freeBytes() < LOG_FRAME_LEN){
+    if(dropped < 0xFFFF){dropped++;}
+    dropped_total++;
+    return false;
+  }
+
+  return push(level, event, a, b, c, d);
+}
+
+template<uint16_t N>
+size_t BinaryLog<N>::drain(Print &out, size_t max_bytes){
+  size_t written = 0;
+  uint16_t t = tail;
+  uint16_t h = head;
+  __asm__ __volatile__("" ::: "memory"); //Read head before the bytes it covers
+
+  while(t != h && written < max_bytes){
+    //Contiguous run up to head or end of ring
+    uint16_t run = (h > t) ? h - t : N - t;
+    if(run > max_bytes - written){run = max_bytes - written;}
+    size_t n = out.write(&ring[t], run);
+    if(n == 0){break;}
+    written += n;
+    t = (t + n) & (N - 1);
+  }
+
+  __asm__ __volatile__("" ::: "memory"); //Finish reading bytes before the producer can reuse them
+  tail = t;
+  return written;
+}
+
+template<uint16_t N>
+uint32_t BinaryLog<N>::getDropped(){
+  return dropped_total;
+}
+
+// END FUNCTION IMPLEMENTATION
+
+
+//Logging macros. Arguments after the event are up to four int16 values (see LogEvent for meanings).
+#if LOG_LEVEL > LOG_LEVEL_NONE
+  #ifndef LOG_RING_BYTES
+    #define LOG_RING_BYTES 1024
+  #endif
+  BinaryLog<LOG_RING_BYTES> binary_log;
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+  #define LOG_ERROR(...) binary_log.log(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+  #define LOG_ERROR(...)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+  #define LOG_WARN(...) binary_log.log(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+  #define LOG_WARN(...)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+  #define LOG_INFO(...) binary_log.log(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+  #define LOG_INFO(...)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+  #define LOG_DEBUG(...) binary_log.log(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+  #define LOG_DEBUG(...)
+#endif
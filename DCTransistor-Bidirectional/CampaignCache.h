@@ -0,0 +1,277 @@
+#include <Arduino.h>
+
+/*
+    Defines CampaignCache class template - special train campaigns (start, end, cars) from appconfig.json, kept in
+    flash with the ETag / Last-Modified the server sent them with.
+
+    Campaigns change a few times a year, but were downloaded and parsed on every special train check. Now each check
+    is a conditional GET (appendConditionalHeaders). On 304 Not Modified the cached list is used as-is, so the
+    board only evaluates campaign dates locally (countActive, activeCars). On 200 the new list replaces it (begin, add, save).
+    If the request fails, the cached list is still used.
+
+    Campaigns that have already ended are not kept. Validators too long for the record are dropped, so that list is
+    simply downloaded again next time.
+
+    Storage is a template parameter with static read / write of the whole record, so tests can use RAM.
+    CampaignFile keeps it in one LittleFS file (FlashFile.h).
+*/
+
+#define CAMPAIGN_CACHE_MAGIC 0x4341 //"CA"
+#define CAMPAIGN_CACHE_FORMAT 1 //Bump when CampaignRecord layout changes
+#define CAMPAIGN_ETAG_LEN 48 //Longest ETag kept, including quotes and NUL
+#define CAMPAIGN_LAST_MODIFIED_LEN 32 //"Wed, 21 Oct 2015 07:28:00 GMT" and NUL
+
+#ifndef EPOXY_DUINO
+  //One file on LittleFS (see FlashFile.h)
+  struct CampaignFile {
+    static bool read(uint8_t* data, size_t len){
+      return readFlashFile(CAMPAIGN_CACHE_FILE, data, len);
+    }
+    static bool write(const uint8_t* data, size_t len){
+      return writeFlashFile(CAMPAIGN_CACHE_FILE, CAMPAIGN_CACHE_FILE ".tmp", data, len);
+    }
+  };
+#endif
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+class CampaignCache {
+
+  private:
+    struct Campaign {
+      int64_t start; //Epoch seconds, as from parse_config_date
+      int64_t end;
+      uint8_t num_cars;
+      uint16_t cars[CARS];
+    };
+
+    struct CampaignRecord {
+      uint16_t magic;
+      uint8_t format;
+      uint8_t max_campaigns;
+      uint8_t max_cars;
+      uint8_t num_campaigns;
+      char etag[CAMPAIGN_ETAG_LEN];
+      char last_modified[CAMPAIGN_LAST_MODIFIED_LEN];
+      Campaign campaigns[CAMPAIGNS];
+      uint32_t crc; //Of everything above
+    };
+
+    CampaignRecord record;
+    bool has_list; //record holds a list from flash or the last download
+    uint32_t written_crc;
+    uint32_t not_modified; //304 responses
+    uint32_t downloads; //Lists parsed from 200 responses
+    uint32_t write_failures;
+
+    uint32_t recordCrc();
+    void copyValidator(char* dest, uint8_t dest_len, const char* value);
+
+  public:
+    CampaignCache();
+
+    bool load(); //Read and check saved list. Call once in setup(), after LittleFS.begin().
+
+    //Append If-None-Match / If-Modified-Since for the cached list (if any) to request headers in buf. Returns new pos, or len if it didn't fit.
+    uint16_t appendConditionalHeaders(char* buf, uint16_t pos, uint16_t len);
+
+    //Replace list from a 200 response: begin() with its validators (or NULL), add() each campaign, then save().
+    void begin(const char* etag, const char* last_modified);
+    bool add(time_t start, time_t end, const uint16_t* cars, uint8_t num_cars, time_t today); //Skips ended campaigns (if today known). False if full.
+    bool save(); //Write list if it changed. Returns true if written.
+
+    void notModified(); //Count a 304
+
+    uint8_t countActive(time_t today); //Campaigns running today
+    uint8_t activeCars(time_t today, uint16_t* cars, uint8_t nth = 0); //Copy cars of nth campaign running today. Returns count, 0 if none.
+    int8_t activeIndex(time_t today, uint8_t nth = 0); //Position in the campaign list of nth campaign running today, or -1
+
+    //Getters
+    bool hasList();
+    uint8_t getCount();
+    const char* getEtag();
+    const char* getLastModified();
+
+    void printMetrics(Print &out);
+
+};//END CampaignCache definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+CampaignCache<Store, CAMPAIGNS, CARS>::CampaignCache(){
+  memset(&record, 0, sizeof(record));
+  has_list = false;
+  written_crc = 0;
+  not_modified = 0;
+  downloads = 0;
+  write_failures = 0;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+uint32_t CampaignCache<Store, CAMPAIGNS, CARS>::recordCrc(){
+  return crc32((const uint8_t*)&record, offsetof(CampaignRecord, crc));
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+bool CampaignCache<Store, CAMPAIGNS, CARS>::load(){
+  has_list = Store::read((uint8_t*)&record, sizeof(record))
+    && record.magic == CAMPAIGN_CACHE_MAGIC && record.format == CAMPAIGN_CACHE_FORMAT
+    && record.max_campaigns == CAMPAIGNS && record.max_cars == CARS
+    && record.num_campaigns <= CAMPAIGNS && record.crc == recordCrc()
+    && record.etag[CAMPAIGN_ETAG_LEN - 1] == '\0' && record.last_modified[CAMPAIGN_LAST_MODIFIED_LEN - 1] == '\0';
+
+  if(has_list){
+    written_crc = record.crc;
+  }
+  else{
+    memset(&record, 0, sizeof(record));
+  }
+  return has_list;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+uint16_t CampaignCache<Store, CAMPAIGNS, CARS>::appendConditionalHeaders(char* buf, uint16_t pos, uint16_t len){
+  if(!has_list){
+    return pos;
+  }
+  if(record.etag[0] != '\0'){
+    pos = appendHttpText(buf, pos, len, PSTR("If-None-Match: "));
+    pos = appendHttpText(buf, pos, len, record.etag);
+    pos = appendHttpText(buf, pos, len, PSTR("\r\n"));
+  }
+  if(record.last_modified[0] != '\0'){
+    pos = appendHttpText(buf, pos, len, PSTR("If-Modified-Since: "));
+    pos = appendHttpText(buf, pos, len, record.last_modified);
+    pos = appendHttpText(buf, pos, len, PSTR("\r\n"));
+  }
+  return pos;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+void CampaignCache<Store, CAMPAIGNS, CARS>::copyValidator(char* dest, uint8_t dest_len, const char* value){
+  memset(dest, 0, dest_len);
+  if(value != NULL && strlen(value) < (size_t)dest_len - 1){ //Filled buffer may be truncated, so don't trust it
+    strcpy(dest, value); /* Flawfinder: ignore */
+  }
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+void CampaignCache<Store, CAMPAIGNS, CARS>::begin(const char* etag, const char* last_modified){
+  memset(&record, 0, sizeof(record)); //Zero padding so equal lists have equal CRCs
+  record.magic = CAMPAIGN_CACHE_MAGIC;
+  record.format = CAMPAIGN_CACHE_FORMAT;
+  record.max_campaigns = CAMPAIGNS;
+  record.max_cars = CARS;
+  copyValidator(record.etag, CAMPAIGN_ETAG_LEN, etag);
+  copyValidator(record.last_modified, CAMPAIGN_LAST_MODIFIED_LEN, last_modified);
+  has_list = true;
+  downloads++;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+bool CampaignCache<Store, CAMPAIGNS, CARS>::add(time_t start, time_t end, const uint16_t* cars, uint8_t num_cars, time_t today){
+  if(today != 0 && end < today){
+    return true; //Over, never needed again
+  }
+  if(record.num_campaigns >= CAMPAIGNS){
+    return false;
+  }
+
+  Campaign &c = record.campaigns[record.num_campaigns++];
+  c.start = start;
+  c.end = end;
+  c.num_cars = (num_cars > CARS) ? CARS : num_cars;
+  for(uint8_t i=0; i<c.num_cars; i++){
+    c.cars[i] = cars[i];
+  }
+  return true;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+bool CampaignCache<Store, CAMPAIGNS, CARS>::save(){
+  record.crc = recordCrc();
+  if(record.crc == written_crc){
+    return false;
+  }
+  if(!Store::write((const uint8_t*)&record, sizeof(record))){
+    write_failures++;
+    return false;
+  }
+  written_crc = record.crc;
+  return true;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+void CampaignCache<Store, CAMPAIGNS, CARS>::notModified(){
+  not_modified++;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+uint8_t CampaignCache<Store, CAMPAIGNS, CARS>::countActive(time_t today){
+  uint8_t active = 0;
+  for(uint8_t i=0; i<record.num_campaigns; i++){
+    active += (record.campaigns[i].start <= today && today <= record.campaigns[i].end);
+  }
+  return active;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+uint8_t CampaignCache<Store, CAMPAIGNS, CARS>::activeCars(time_t today, uint16_t* cars, uint8_t nth){
+  for(uint8_t i=0; i<record.num_campaigns; i++){
+    const Campaign &c = record.campaigns[i];
+    if(c.start <= today && today <= c.end && nth-- == 0){
+      for(uint8_t j=0; j<c.num_cars; j++){
+        cars[j] = c.cars[j];
+      }
+      return c.num_cars;
+    }
+  }
+  return 0;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+int8_t CampaignCache<Store, CAMPAIGNS, CARS>::activeIndex(time_t today, uint8_t nth){
+  for(uint8_t i=0; i<record.num_campaigns; i++){
+    const Campaign &c = record.campaigns[i];
+    if(c.start <= today && today <= c.end && nth-- == 0){
+      return i;
+    }
+  }
+  return -1;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+bool CampaignCache<Store, CAMPAIGNS, CARS>::hasList(){
+  return has_list;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+uint8_t CampaignCache<Store, CAMPAIGNS, CARS>::getCount(){
+  return record.num_campaigns;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+const char* CampaignCache<Store, CAMPAIGNS, CARS>::getEtag(){
+  return record.etag;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+const char* CampaignCache<Store, CAMPAIGNS, CARS>::getLastModified(){
+  return record.last_modified;
+}
+
+template<typename Store, uint8_t CAMPAIGNS, uint8_t CARS>
+void CampaignCache<Store, CAMPAIGNS, CARS>::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_appconfig_not_modified_total counter\ndctransistor_appconfig_not_modified_total "));
+  out.print(not_modified);
+  out.print(F("\n# TYPE dctransistor_appconfig_downloads_total counter\ndctransistor_appconfig_downloads_total "));
+  out.print(downloads);
+  out.print(F("\n# TYPE dctransistor_campaigns_cached gauge\ndctransistor_campaigns_cached "));
+  out.print(record.num_campaigns);
+  out.print(F("\n# TYPE dctransistor_campaign_cache_write_failures_total counter\ndctransistor_campaign_cache_write_failures_total "));
+  out.print(write_failures);
+  out.print('\n');
+}
+
+// END FUNCTION IMPLEMENTATION
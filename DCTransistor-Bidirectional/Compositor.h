@@ -0,0 +1,397 @@
+#include "TrainLine.h"
+#include "ColorLUT.h"
+
+/*
+    Defines Compositor class - builds each frame shown on the board from a small stack of layers
+    and flattens them into the NeoPixel strip once per frame.
+
+    Layers (bottom to top):
+      - Trains:  board-wide LED mask for each line (in all_lines order) of LEDs with a train "at" them
+      - Shared:  stations with trains from more than one line crossfade through each line's color
+      - Special: overlay LEDs for special / promotional trains
+      - Status:  Web, WiFi and Power LEDs at the end of the strip
+
+    Each layer carries a dirty bit. Writes to a layer only mark it dirty, and render() only recomposes
+    dirty layers, only writes pixels that changed, and only calls strip.show() if something changed.
+    Status changes are therefore cheap and are batched into the next scheduled render().
+
+    Layers hold full 8-bit colors. Gamma and brightness (ColorLUT.h) are applied once per pixel on the way
+    to the strip, so shared stations and special trains can crossfade between colors without losing resolution.
+
+    After each frame is composed, total LED current is estimated from the final frame. If it is over
+    LED_POWER_BUDGET_MA, every pixel is scaled down so the board stays within the supply budget.
+*/
+
+//Layer dirty bits
+#define LAYER_TRAINS  0x01
+#define LAYER_SHARED  0x02
+#define LAYER_SPECIAL 0x04
+#define LAYER_STATUS  0x08
+
+#define MAX_OVERLAY_LEDS 8 //Max number of LEDs special train overlay can hold
+#define NUM_STATION_LEDS (LED_COUNT - NUM_STATUS_LEDS) //LEDs before the status LEDs at the end of the strip
+
+//Channel sums for current estimate are packed two to a 32-bit word, 16 bits each
+static_assert(LED_COUNT <= 257, "Current estimate channel sums overflow 16 bits for more than 257 LEDs");
+
+//Per-channel gamma + brightness tables, built at compile time
+constexpr ColorLUT<GAMMA_RED_X10, LED_BRIGHTNESS> red_lut{};
+constexpr ColorLUT<GAMMA_GREEN_X10, LED_BRIGHTNESS> green_lut{};
+constexpr ColorLUT<GAMMA_BLUE_X10, LED_BRIGHTNESS> blue_lut{};
+
+class Compositor {
+
+  private:
+    // ----- VARIABLES -----
+    Adafruit_NeoPixel* strip;
+
+    //Static layer data
+    uint32_t line_colors[NUM_LINES]; //LED color for each line, in all_lines order
+    uint8_t num_lines;
+
+    //Layer contents
+    BitSet<NUM_STATION_LEDS> line_leds[NUM_LINES]; //For each line, bit k set if line has a train at LED k
+    BitSet<NUM_STATION_LEDS> shared_leds; //Bit k set if more than one line has a train at LED k
+    uint8_t overlay_leds[MAX_OVERLAY_LEDS]; //LED index for each special overlay pixel
+    const uint32_t* overlay_palettes[MAX_OVERLAY_LEDS]; //Colors each special overlay pixel fades through
+    uint8_t overlay_palette_counts[MAX_OVERLAY_LEDS];
+    uint8_t num_overlay;
+    uint32_t status_colors[NUM_STATUS_LEDS]; //Colors for Web, WiFi, and Power LEDs (in strip order)
+
+    //Frame state
+    uint32_t frame[LED_COUNT]; //Last composed color of every LED (after gamma and brightness, before power limit)
+    uint8_t dirty; //Bitmask of LAYER_* values changed since last render
+    uint32_t frame_count; //Number of frames rendered
+
+    //Animation position for the current frame, shared by every animated layer
+    uint32_t fade_step; //Number of FADE_MS periods since boot
+    uint16_t fade_t; //Crossfade amount from current to next color (0-256)
+
+    //Power limiting
+    uint16_t limit_scale; //Scale applied to every pixel to stay in power budget (256 = no limit)
+    uint32_t frame_current_ma; //Estimated current of composed frame before limiting
+    uint32_t limited_current_ma; //Estimated current actually drawn after limiting
+
+    // ----- FUNCTIONS -----
+    uint32_t stationColor(uint8_t led);
+    uint32_t paletteColor(const uint32_t* palette, uint8_t count);
+    bool writePixel(uint8_t led, uint32_t color);
+    void showPixel(uint8_t led);
+    uint32_t estimateCurrent();
+
+  public:
+
+    //Constructor
+    Compositor(Adafruit_NeoPixel &led_strip);
+
+    //Setup
+    void begin(const uint32_t* colors, uint8_t lines);
+
+    //Layer writes
+    void clearTrains();
+    template<uint16_t N>
+    void addTrains(uint8_t line_idx, const BitSet<N> &state, const uint8_t* leds, uint8_t num_stations);
+    void clearOverlay();
+    void setOverlay(uint8_t led, const uint32_t* palette, uint8_t count);
+    void setStatus(uint8_t led, uint32_t color);
+
+    //Flatten dirty layers into strip and show if anything changed. Returns true if strip was updated.
+    bool render();
+
+    //Keep rendering animated layers every FRAME_MS for the given number of milliseconds (replaces delay())
+    //If given, idle is called once per frame (e.g. to answer web requests) and counts toward the frame time.
+    void wait(uint32_t ms, void (*idle)() = NULL);
+
+    //Getters
+    uint32_t getFrameCount();
+    uint8_t getDirtyLayers(); //LAYER_* bits waiting for the next render
+    uint32_t getCurrentEstimate(); //Estimated mA drawn by LEDs in last frame, after power limiting
+    uint32_t getUnlimitedCurrentEstimate(); //Estimated mA last frame would draw without power limiting
+    uint16_t getLimitScale(); //Brightness scale applied by power limit (256 = not limiting)
+
+    void printMetrics(Print &out);
+
+};//END Compositor definition
+
+Compositor::Compositor(Adafruit_NeoPixel &led_strip){
+  strip = &led_strip;
+  num_lines = 0;
+  num_overlay = 0;
+  frame_count = 0;
+  fade_step = 0;
+  fade_t = 0;
+  limit_scale = 256;
+  frame_current_ma = 0;
+  limited_current_ma = 0;
+
+  memset(status_colors, 0, sizeof(status_colors));
+  memset(frame, 0, sizeof(frame));
+
+  //Force a full composition on first render
+  dirty = LAYER_TRAINS | LAYER_SPECIAL | LAYER_STATUS;
+}
+
+//Set line colors (in all_lines order, which also sets priority of lines that are not multiplexed)
+void Compositor::begin(const uint32_t* colors, uint8_t lines){
+  num_lines = lines;
+  for(uint8_t l=0; l<lines && l<NUM_LINES; l++){
+    line_colors[l] = colors[l];
+  }
+  dirty |= LAYER_TRAINS;
+}
+
+//Clear base train layer. Call before setting each line's trains for a new frame.
+void Compositor::clearTrains(){
+  for(uint8_t l=0; l<NUM_LINES; l++){
+    line_leds[l].clear();
+  }
+  shared_leds.clear();
+  dirty |= LAYER_TRAINS;
+}
+
+//Add a line's trains (index in all_lines) by scattering its station state onto the board through its LED list.
+template<uint16_t N>
+void Compositor::addTrains(uint8_t line_idx, const BitSet<N> &state, const uint8_t* leds, uint8_t num_stations){
+
+  if(line_idx >= NUM_LINES){
+    return;
+  }
+
+  BitSet<NUM_STATION_LEDS> added;
+  state.scatter(leds, num_stations, added);
+
+  //LEDs already lit by another line become shared
+  for(uint8_t l=0; l<NUM_LINES; l++){
+    if(l != line_idx){
+      shared_leds |= (added & line_leds[l]);
+    }
+  }
+
+  line_leds[line_idx] |= added;
+  dirty |= LAYER_TRAINS;
+}
+
+//Remove all special train overlay pixels
+void Compositor::clearOverlay(){
+  if(num_overlay > 0){
+    num_overlay = 0;
+    dirty |= LAYER_SPECIAL;
+  }
+}
+
+//Add a special train overlay pixel that fades through the given colors. Ignored if overlay is full.
+void Compositor::setOverlay(uint8_t led, const uint32_t* palette, uint8_t count){
+  if(num_overlay >= MAX_OVERLAY_LEDS || led >= NUM_STATION_LEDS || count == 0){
+    return;
+  }
+  overlay_leds[num_overlay] = led;
+  overlay_palettes[num_overlay] = palette;
+  overlay_palette_counts[num_overlay] = count;
+  num_overlay++;
+  dirty |= LAYER_SPECIAL;
+}
+
+//Set one of the board status LEDs (WEB_LED, WIFI_LED, PWR_LED). Only marks status layer dirty on change.
+void Compositor::setStatus(uint8_t led, uint32_t color){
+  if(led < NUM_STATION_LEDS || led >= LED_COUNT){
+    return;
+  }
+  uint8_t idx = led - NUM_STATION_LEDS;
+  if(status_colors[idx] != color){
+    status_colors[idx] = color;
+    dirty |= LAYER_STATUS;
+  }
+}
+
+//Get color of a palette for the current frame, crossfading from one color to the next.
+//Palette may be in flash (e.g. SPECIAL_TRAIN_HEX) or DRAM.
+uint32_t Compositor::paletteColor(const uint32_t* palette, uint8_t count){
+  if(count == 1){
+    return readFlashWord(palette, 0);
+  }
+  uint8_t cur = fade_step % count;
+  uint8_t next = (cur + 1) % count;
+  return blendColor(readFlashWord(palette, cur), readFlashWord(palette, next), fade_t);
+}
+
+//Get color of a station LED from train layer, crossfading through each line's color at shared stations.
+uint32_t Compositor::stationColor(uint8_t led){
+
+  //Collect colors of lines at station in all_lines order. First line wins if not multiplexing.
+  uint32_t colors[NUM_LINES];
+  uint8_t count = 0;
+  for(uint8_t l=0; l<num_lines; l++){
+    if(line_leds[l].isSet(led)){
+      colors[count++] = line_colors[l];
+      if(!MULTIPLEX_SHARED_STATIONS){break;}
+    }
+  }
+
+  if(count == 0){
+    return 0;
+  }
+  return paletteColor(colors, count);
+}
+
+//Apply gamma and brightness to a composed pixel and write it to the strip only if it changed. Returns true on change.
+bool Compositor::writePixel(uint8_t led, uint32_t color){
+
+  uint8_t r = red_lut[(color >> 16) & 0xFF];
+  uint8_t g = green_lut[(color >> 8) & 0xFF];
+  uint8_t b = blue_lut[color & 0xFF];
+  uint32_t out = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+
+  if(frame[led] == out){
+    return false;
+  }
+  frame[led] = out;
+  showPixel(led);
+  return true;
+}
+
+//Send a composed pixel to the strip, scaled down if power limiting
+void Compositor::showPixel(uint8_t led){
+  uint32_t out = frame[led];
+  if(limit_scale < 256){
+    out = blendColor(0, out, limit_scale);
+  }
+  strip->setPixelColor(led, (out >> 16) & 0xFF, (out >> 8) & 0xFF, out & 0xFF);
+}
+
+//Estimate current (mA) of the composed frame in one pass. Red and blue are summed together in one
+//32-bit accumulator (16 bits each), green in another, so the loop is just masks, shifts, and adds.
+uint32_t Compositor::estimateCurrent(){
+  uint32_t rb_sum = 0;
+  uint32_t g_sum = 0;
+  for(uint16_t k=0; k<LED_COUNT; k++){
+    rb_sum += frame[k] & 0x00FF00FF;
+    g_sum += (frame[k] >> 8) & 0xFF;
+  }
+  uint32_t channel_sum = (rb_sum >> 16) + (rb_sum & 0xFFFF) + g_sum;
+
+  //Each channel draws LED_CHANNEL_UA at full (255) brightness, plus a constant idle draw per LED
+  uint32_t active_ua = (channel_sum * LED_CHANNEL_UA) / 255;
+  return (active_ua + (LED_COUNT * LED_IDLE_UA)) / 1000;
+}
+
+//Flatten dirty layers into the strip, bottom to top, and show once.
+bool Compositor::render(){
+
+  //Get animation position for this frame. Hold each color for half of FADE_MS, then crossfade to the next.
+  uint32_t now = millis();
+  uint16_t phase = now % FADE_MS;
+  fade_step = now / FADE_MS;
+  fade_t = (phase < FADE_MS/2) ? 0 : (uint16_t)(((uint32_t)(phase - FADE_MS/2) * 256) / (FADE_MS/2));
+
+  //Shared stations and special trains animate, so keep them dirty while any exist
+  if(MULTIPLEX_SHARED_STATIONS && shared_leds.any()){
+    dirty |= LAYER_SHARED;
+  }
+  if(num_overlay > 0){
+    dirty |= LAYER_SPECIAL;
+  }
+
+  bool changed = false;
+
+  //Any change under the special overlay requires recomposing the station LEDs
+  if(dirty & (LAYER_TRAINS | LAYER_SHARED | LAYER_SPECIAL)){
+
+    for(uint8_t k=0; k<NUM_STATION_LEDS; k++){
+
+      uint32_t color = stationColor(k);
+
+      for(uint8_t o=0; o<num_overlay; o++){
+        if(overlay_leds[o] == k){
+          color = paletteColor(overlay_palettes[o], overlay_palette_counts[o]);
+        }
+      }
+
+      changed |= writePixel(k, color);
+    }
+  }
+
+  if(dirty & LAYER_STATUS){
+    for(uint8_t s=0; s<NUM_STATUS_LEDS; s++){
+      changed |= writePixel(NUM_STATION_LEDS + s, status_colors[s]);
+    }
+  }
+
+  //Estimate frame current and scale every pixel down if over budget. Idle current can't be limited.
+  if(changed){
+    frame_current_ma = estimateCurrent();
+
+    uint32_t idle_ma = (LED_COUNT * LED_IDLE_UA) / 1000;
+    uint16_t new_scale = 256;
+    if(frame_current_ma > LED_POWER_BUDGET_MA && LED_POWER_BUDGET_MA > idle_ma){
+      new_scale = ((LED_POWER_BUDGET_MA - idle_ma) * 256) / (frame_current_ma - idle_ma);
+    }
+
+    //Every pixel needs rewriting when scale changes, not just ones that changed this frame
+    if(new_scale != limit_scale){
+      limit_scale = new_scale;
+      for(uint16_t k=0; k<LED_COUNT; k++){
+        showPixel(k);
+      }
+    }
+
+    limited_current_ma = idle_ma + (((frame_current_ma - idle_ma) * limit_scale) >> 8);
+  }
+
+  dirty = 0;
+  frame_count++;
+
+  if(changed){
+    PROFILE_SCOPE(PROF_SHOW);
+    strip->show();
+  }
+
+  return changed;
+}//END render
+
+//Render animated layers at FRAME_MS intervals until ms have passed
+void Compositor::wait(uint32_t ms, void (*idle)()){
+  uint32_t start = millis();
+  while(millis() - start < ms){
+    render();
+    if(idle != NULL){
+      idle();
+    }
+    uint32_t elapsed = millis() - start;
+    if(elapsed < ms){
+      delay(min((uint32_t)FRAME_MS, ms - elapsed));
+      yield_monitor.markYield(); //delay() yields
+    }
+  }
+}
+
+uint32_t Compositor::getFrameCount(){
+  return frame_count;
+}
+
+uint8_t Compositor::getDirtyLayers(){
+  return dirty;
+}
+
+uint32_t Compositor::getCurrentEstimate(){
+  return limited_current_ma;
+}
+
+uint32_t Compositor::getUnlimitedCurrentEstimate(){
+  return frame_current_ma;
+}
+
+uint16_t Compositor::getLimitScale(){
+  return limit_scale;
+}
+
+void Compositor::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_led_current_ma gauge\ndctransistor_led_current_ma "));
+  out.print(limited_current_ma);
+  out.print(F("\n# TYPE dctransistor_led_current_unlimited_ma gauge\ndctransistor_led_current_unlimited_ma "));
+  out.print(frame_current_ma);
+  out.print(F("\n# TYPE dctransistor_led_limit_scale gauge\ndctransistor_led_limit_scale "));
+  out.print(limit_scale);
+  out.print('\n');
+}
+
+// END FUNCTION IMPLEMENTATION
@@ -0,0 +1,109 @@
+#include <Arduino.h>
+
+/*
+    Defines CarSet class template - a special train's car numbers, sorted, for matching the "Cars" string of each
+    consist on the special train endpoint ("7000.7001-7002.7003").
+
+    matches() scans the string once, reading each car number in place and looking it up by binary search. It stops
+    at the first car that isn't special, so the many ordinary consists cost a few characters each. No copy of the
+    string and no strtok / atoi.
+
+    A consist matches when every car read before the first non-special car is special, and that many cars were read
+    as the set holds (same rule as the old strtok loop).
+*/
+
+template<uint8_t N>
+class CarSet {
+
+  private:
+    uint16_t cars[N]; //Sorted ascending
+    uint8_t num_cars;
+
+  public:
+    CarSet();
+
+    void set(const uint16_t* car_numbers, uint8_t n); //Load (up to N) cars in any order
+    bool contains(uint16_t car);
+    bool matches(const char* consist); //True if consist's Cars string is this special train. NULL never matches.
+
+    uint8_t getCount();
+
+};//END CarSet definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<uint8_t N>
+CarSet<N>::CarSet(){
+  num_cars = 0;
+}
+
+template<uint8_t N>
+void CarSet<N>::set(const uint16_t* car_numbers, uint8_t n){
+  num_cars = (n > N) ? N : n;
+
+  //Insertion sort - at most a handful of cars
+  for(uint8_t i=0; i<num_cars; i++){
+    uint16_t car = car_numbers[i];
+    uint8_t j = i;
+    while(j > 0 && cars[j-1] > car){
+      cars[j] = cars[j-1];
+      j--;
+    }
+    cars[j] = car;
+  }
+}
+
+template<uint8_t N>
+bool CarSet<N>::contains(uint16_t car){
+  uint8_t lo = 0;
+  uint8_t hi = num_cars;
+  while(lo < hi){
+    uint8_t mid = (lo + hi) / 2;
+    if(cars[mid] < car){
+      lo = mid + 1;
+    }
+    else{
+      hi = mid;
+    }
+  }
+  return lo < num_cars && cars[lo] == car;
+}
+
+template<uint8_t N>
+bool CarSet<N>::matches(const char* consist){
+  if(consist == NULL || num_cars == 0){
+    return false;
+  }
+
+  uint8_t matched = 0;
+  const char* c = consist;
+  while(*c != '\0'){
+
+    //Skip delimiters ('.' between cars of a pair, '-' between pairs)
+    if(*c < '0' || *c > '9'){
+      c++;
+      continue;
+    }
+
+    uint32_t car = 0;
+    while(*c >= '0' && *c <= '9'){
+      car = car * 10 + (*c - '0');
+      c++;
+    }
+
+    if(car > 0xFFFF || !contains(car)){
+      break;
+    }
+    matched++;
+  }
+
+  return matched == num_cars;
+}
+
+template<uint8_t N>
+uint8_t CarSet<N>::getCount(){
+  return num_cars;
+}
+
+// END FUNCTION IMPLEMENTATION
@@ -13,30 +13,60 @@
  * (c) Logan Arkema, 7/28/2024
 */
 
-#include "TrainLine.h"
+#include "auto_update.h"
+#include "Compositor.h"
+#include "TrainFeed.h"
+#include "MetricsPage.h"
+#include "FlightRecorder.h"
+#include "WarmStart.h"
+#include "DeferredTasks.h"
 
 //Global object variables
 Adafruit_NeoPixel strip(LED_COUNT, LED_PIN, NEO_GRB + NEO_KHZ800); //object to control colors of all LEDs (i.e. a "strip" of WS2812Bs)
+Compositor compositor(strip); //Layered frame model. All LED writes go through compositor and are shown once per render.
 WiFiManager wifi_manager; //WiFi manager to auto-connect to wifi
-WiFiClientSecure client; //One client used to connect to all webservers. HTTP client defined in auto_update.h
-HTTPClient https;
+WiFiClientSecure client; //One client used to connect to all webservers. Static request buffers defined in auto_update.h
+
+HeapTelemetry<HEAP_TELEMETRY_SAMPLES> heap_telemetry; //Heap samples at each phase of loop. Reported over Serial and metrics endpoint.
+
+ESP8266WebServer metrics_server(METRICS_PORT); //Serves /metrics (and /profile) from preformatted pages
+MetricsPage<METRICS_PAGE_LEN> metrics_page; //Formatted once per loop, after render
+FetchStats fetch_stats; //Latency, failures and redundant polls of the train data source
+FreshnessStats freshness_stats; //Lag from newest WMATA position time to frame that showed it
+char reset_reason[32] = {0}; //Why board last reset, read once at boot
+
+FlightRecorder<RtcStore, FLIGHT_RECORDS> flight_recorder; //Last loops in RTC memory, survives resets
+MetricsPage<FLIGHT_PAGE_LEN> flight_page; //Previous boot's flight records. Formatted once in setup.
+
+WarmStart<LittleFSStore, NUM_LINES, NUM_DIRECTIONS, MAX_LINE_STATIONS> warm_start(WARM_SAVE_SEC * 1000UL); //Last live frame in flash, shown at boot
+uint32_t first_frame_ms = 0; //millis() when trains were first shown, saved or live
+uint32_t first_live_frame_ms = 0; //millis() when live trains were first shown
+
+DeferredTasks<2> background_tasks; //Update and special train checks, run after a frame is shown
+
+#ifdef PROFILE
+  MetricsPage<PROFILE_PAGE_LEN> profile_page;
+#endif
 
 uint8_t data_failure_count; //Count failures getting live data
 uint32_t total_run_count; //Count total iterations of run time
 
-int16_t special_train_id = -1; //Constant to get the TrainID of a special train. If no special train, -1
+SpecialTrains<MAX_SPECIAL_TRAINS> special_trains; //TrainIDs (ITT) and palettes of special trains running now, and where each was last seen
+static_assert(MAX_OVERLAY_LEDS >= MAX_SPECIAL_TRAINS, "Every special train needs an overlay LED: raise MAX_OVERLAY_LEDS in Compositor.h");
 
 //Define JSON Deserialization objects to initialize in setup and use in every loop
 StaticJsonDocument<JSON_FILTER_SIZE> train_pos_filter; 
-const uint16_t json_size = JSON_DOC_SIZE; //space to allocate for data FROM WMATA API. Change to 3072 without Line Code, 2048 for just CircuitIDs
+
+//TrainLine specialization for this board
+typedef TrainLine<NUM_DIRECTIONS, MAX_LINE_STATIONS> BoardLine;
 
 //Create objects representing each line
-TrainLine* redline = new TrainLine(NUM_RD_STATIONS, rstation_codes, "Red", RD_HEX_COLOR, rd_led_array_0, rd_led_array_1, RD_END_TRK_0, RD_END_TRK_1);
-TrainLine* blueline = new TrainLine(NUM_BL_STATIONS, bstation_codes, "Blue", BL_HEX_COLOR, bl_led_array_0, bl_led_array_1, BL_END_TRK_0, BL_END_TRK_1);
-TrainLine* orangeline = new TrainLine(NUM_OR_STATIONS, ostation_codes, "Orange", OR_HEX_COLOR, or_led_array_0, or_led_array_1, OR_END_TRK_0, OR_END_TRK_1);
-TrainLine* silverline = new TrainLine(NUM_SV_STATIONS, sstation_codes, "Silver", SV_HEX_COLOR, sv_led_array_0, sv_led_array_1, SV_END_TRK_0, SV_END_TRK_1);
-TrainLine* yellowline = new TrainLine(NUM_YL_STATIONS, ystations_codes, "Yellow", YL_HEX_COLOR, yl_led_array_0, yl_led_array_1, YL_END_TRK_0, YL_END_TRK_1);
-TrainLine* greenline = new TrainLine(NUM_GN_STATIONS, gstation_codes, "Green", GN_HEX_COLOR, gn_led_array_0, gn_led_array_1, GN_END_TRK_0, GN_END_TRK_1);
+BoardLine* redline = new BoardLine(NUM_RD_STATIONS, rstation_codes, "Red", RD_HEX_COLOR, RD_END_TRK_0, RD_END_TRK_1, rd_led_array_0, rd_led_array_1);
+BoardLine* blueline = new BoardLine(NUM_BL_STATIONS, bstation_codes, "Blue", BL_HEX_COLOR, BL_END_TRK_0, BL_END_TRK_1, bl_led_array_0, bl_led_array_1);
+BoardLine* orangeline = new BoardLine(NUM_OR_STATIONS, ostation_codes, "Orange", OR_HEX_COLOR, OR_END_TRK_0, OR_END_TRK_1, or_led_array_0, or_led_array_1);
+BoardLine* silverline = new BoardLine(NUM_SV_STATIONS, sstation_codes, "Silver", SV_HEX_COLOR, SV_END_TRK_0, SV_END_TRK_1, sv_led_array_0, sv_led_array_1);
+BoardLine* yellowline = new BoardLine(NUM_YL_STATIONS, ystations_codes, "Yellow", YL_HEX_COLOR, YL_END_TRK_0, YL_END_TRK_1, yl_led_array_0, yl_led_array_1);
+BoardLine* greenline = new BoardLine(NUM_GN_STATIONS, gstation_codes, "Green", GN_HEX_COLOR, GN_END_TRK_0, GN_END_TRK_1, gn_led_array_0, gn_led_array_1);
 
 /*
 * VERSION 1.0 TrainLine objects and api key daa
@@ -54,8 +84,171 @@ TrainLine* greenline = new TrainLine(NUM_GN_STATIONS, gstation_codes, "Green", G
 //String wmata_api_keys[3] = {SECRET_WMATA_API_KEY_0, SECRET_WMATA_API_KEY_1, SECRET_WMATA_API_KEY_2};
 
 //Create an array to hold all train lines to iterate through
-TrainLine* all_lines[NUM_LINES] = {orangeline, silverline, blueline, yellowline, greenline, redline};
+BoardLine* all_lines[NUM_LINES] = {orangeline, silverline, blueline, yellowline, greenline, redline};
+
+
+/***********************************************/
+/*            HEAP TELEMETRY HELPERS           */
+/***********************************************/
+
+//Record free heap, largest free block and fragmentation for a phase of loop()
+void sample_heap(HeapPhase phase){
+  uint32_t free_heap = 0;
+  uint32_t max_block = 0;
+  uint8_t fragmentation = 0;
+  ESP.getHeapStats(&free_heap, &max_block, &fragmentation);
+  heap_telemetry.record(phase, free_heap, max_block, fragmentation);
+  flight_recorder.noteHeap(free_heap, fragmentation);
+}
+
+//Passed to parseTrainFeed to sample once JSON parsing is under way
+void sample_heap_mid_parse(){
+  sample_heap(HEAP_MID_PARSE);
+}
+
+//Enter a phase of setup() / loop(): mark it in the flight recorder and charge later yield gaps to it.
+//The running gap ends here, so a blocking call (e.g. the TLS handshake before parsing) is charged to the phase
+//that made it, not the next one. A stretch spanning two phases shows as one gap in each.
+void enter_phase(ProfilePhase phase){
+  flight_recorder.setPhase(phase);
+  yield_monitor.markYield();
+  yield_monitor.setPhase(phase);
+}
+
+/***********************************************/
+/*              DISPLAY HELPERS                */
+/***********************************************/
+
+//Put every line's trains and each special train on the board into the compositor. Shown on next render.
+void composite_trains(){
+  compositor.clearTrains();
+  for(uint8_t l=0; l<NUM_LINES; l++){
+    compositor.addTrains(l, all_lines[l]->getState(0), all_lines[l]->getLEDs(0), all_lines[l]->getTotalNumStations());
+    compositor.addTrains(l, all_lines[l]->getState(1), all_lines[l]->getLEDs(1), all_lines[l]->getTotalNumStations());
+  }
+
+  //Give each special train seen in the latest feed its campaign's palette
+  compositor.clearOverlay();
+  for(uint8_t i=0; i<special_trains.getCount(); i++){
+    int8_t line = special_trains.getLine(i);
+    if(line == -1){
+      continue;
+    }
+
+    #ifdef PRINT
+      Serial.printf("Setting special train LED\n");
+      Serial.printf("Train ID: %d;   Train Index: %d;   Train Dir: %d\n", special_trains.getId(i), special_trains.getIndex(i), special_trains.getDir(i));
+    #endif
+
+    uint8_t palette = special_trains.getPalette(i) % NUM_SPECIAL_PALETTES;
+    uint8_t special_led = all_lines[line]->getLEDForIndex(special_trains.getIndex(i), special_trains.getDir(i));
+    compositor.setOverlay(special_led, SPECIAL_PALETTES[palette], SPECIAL_PALETTE_COUNTS[palette]);
+  }
+}
+
+/***********************************************/
+/*              BACKGROUND TASKS               */
+/***********************************************/
+
+//Train feed filter only asks for ITT once there are special trains
+void apply_special_trains(){
+  if(special_trains.getCount() > 0){
+    train_pos_filter["attributes"]["ITT"] = true; //Was just ["TrainId"]
+  }
+}
+
+void task_check_update(){
+  enter_phase(PROF_CHECK_UPDATE);
+  check_for_update(client);
+}
+
+//Check for special campaigns running today, and retrieve the TrainID of each one's train
+void task_check_special(){
+  enter_phase(PROF_CHECK_SPECIAL);
+  check_for_special_trains(client, special_trains);
+  apply_special_trains();
+}
+
+/***********************************************/
+/*              METRICS ENDPOINT               */
+/***********************************************/
+
+//Each line's state from previous poll, to spot polls that returned the same positions
+BitSet<MAX_LINE_STATIONS> previous_states[NUM_LINES][NUM_DIRECTIONS];
+
+//True if every line has the same trains as last poll. Saves current state for next poll.
+bool trains_unchanged(){
+  bool same = true;
+  for(uint8_t l=0; l<NUM_LINES; l++){
+    for(uint8_t dir=0; dir<NUM_DIRECTIONS; dir++){
+      if(previous_states[l][dir] != all_lines[l]->getState(dir)){
+        same = false;
+        previous_states[l][dir] = all_lines[l]->getState(dir);
+      }
+    }
+  }
+  return same;
+}
+
+//Scrapes only copy out the page formatted in loop(), so they never hold up a render or poll
+void handle_metrics(){
+  metrics_server.send(200, "text/plain; version=0.0.4", metrics_page.c_str(), metrics_page.length());
+}
+
+void handle_flight(){
+  metrics_server.send(200, "text/plain", flight_page.c_str(), flight_page.length());
+}
+
+#ifdef PROFILE
+  void handle_profile(){
+    metrics_server.send(200, "text/plain", profile_page.c_str(), profile_page.length());
+  }
+#endif
+
+//True if the feed has been failing long enough (or never went live since boot) that waiting for live trains could
+//strand the board, e.g. a stale WMATA pin that only an update can fix
+bool feed_stuck(){
+  return data_failure_count >= FEED_STUCK_FAILURES || (first_live_frame_ms == 0 && millis() >= FEED_STUCK_SEC * 1000UL);
+}
+
+//Answer any waiting web requests. Passed to compositor.wait so scrapes are answered between frames.
+void serve_metrics(){
+  metrics_server.handleClient();
+}
+
+//Format previous boot's flight records with why the board reset. Only changes on reboot.
+void format_flight_page(){
+  rst_info* info = ESP.getResetInfoPtr();
+  CrashInfo crash = {reset_reason, info->exccause, info->epc1, info->excvaddr};
+  flight_page.begin();
+  flight_recorder.printReport(flight_page, crash, profile_phase_names, NUM_PROFILE_PHASES);
 
+  #ifdef PRINT
+    Serial.print(flight_page.c_str());
+  #endif
+}
+
+//Format pages served by the metrics endpoint from this loop's state
+void update_metrics_page(){
+  BoardStatus status = {VERSION, reset_reason, (uint32_t)(millis() / 1000), tls_handshakes, tls_handshake_failures, first_frame_ms, first_live_frame_ms};
+  formatMetrics(metrics_page, status, all_lines, NUM_LINES, fetch_stats, freshness_stats, heap_telemetry);
+  compositor.printMetrics(metrics_page);
+  yield_monitor.printMetrics(metrics_page);
+  warm_start.printMetrics(metrics_page);
+  wall_clock.printMetrics(metrics_page);
+  campaign_cache.printMetrics(metrics_page);
+  special_trains.printMetrics(metrics_page);
+  background_tasks.printMetrics(metrics_page);
+  tls_pins.printMetrics(metrics_page);
+  tls_buffers.printMetrics(metrics_page);
+  update_manifest.printMetrics(metrics_page);
+  ota.printMetrics(metrics_page);
+
+  #ifdef PROFILE
+    profile_page.begin();
+    loop_profiler.printReport(profile_page);
+  #endif
+}
 
 /***********************************************/
 /*                SETUP CODE                   */
@@ -64,16 +257,52 @@ TrainLine* all_lines[NUM_LINES] = {orangeline, silverline, blueline, yellowline,
 //SETUP WIFI CONNECTION
 void setup() {
 
-  #ifdef PRINT
+  PROFILE_SCOPE(PROF_SETUP);
+
+  #if defined(PRINT) || defined(PROFILE) || LOG_LEVEL > LOG_LEVEL_NONE
     Serial.begin(BAUD_RATE); //NodeMCU ESP8266 runs on 9600 baud rate. Defined in config.
   #endif
 
+  //Drain binary log to Serial whenever the sketch yields, without waiting on the UART
+  #if LOG_LEVEL > LOG_LEVEL_NONE
+    schedule_recurrent_function_us([](){
+      binary_log.drain(Serial, Serial.availableForWrite());
+      return true;
+    }, LOG_DRAIN_US);
+  #endif
+
+  //Read back last boot's flight records before anything overwrites them, then record setup as loop 0
+  flight_recorder.begin();
+  flight_recorder.beginLoop(0);
+  enter_phase(PROF_SETUP);
+  yield_monitor.setBudget(YIELD_BUDGET_US);
+
   //Set LED strip settings, turn power light on and Wifi to Yellow.
-  strip.begin();
-  strip.setBrightness(LED_BRIGHTNESS);
-  strip.setPixelColor(PWR_LED,GN_HEX_COLOR);
-  strip.setPixelColor(WIFI_LED, YL_HEX_COLOR);
-  strip.show(); 
+  strip.begin(); //Brightness and gamma applied by compositor, not strip.setBrightness()
+
+  //Give compositor each line's color in all_lines order (also priority order for shared stations)
+  uint32_t line_colors[NUM_LINES];
+  for(uint8_t l=0; l<NUM_LINES; l++){
+    line_colors[l] = all_lines[l]->getLEDColor();
+  }
+  compositor.begin(line_colors, NUM_LINES);
+
+  compositor.setStatus(PWR_LED, GN_HEX_COLOR);
+  compositor.setStatus(WIFI_LED, YL_HEX_COLOR);
+
+  //Show last saved frame while WiFi connects and live data is fetched. Lines are cleared once it's in the
+  //compositor, so the first live loop starts from scratch.
+  LittleFS.begin();
+  campaign_cache.load();
+  if(warm_start.load()){
+    warm_start.restore(all_lines, special_trains);
+    composite_trains();
+    for(uint8_t l=0; l<NUM_LINES; l++){
+      all_lines[l]->clearState();
+    }
+    first_frame_ms = millis();
+  }
+  compositor.render();
 
   #ifdef PRINT
     Serial.println("Connecting to WiFi");
@@ -86,29 +315,40 @@ void setup() {
     #ifdef PRINT
       Serial.println("Wifi Connected");
     #endif
-    strip.setPixelColor(WIFI_LED, GN_HEX_COLOR);
-    strip.show();
+    compositor.setStatus(WIFI_LED, GN_HEX_COLOR);
+    compositor.render();
   }
 
-  //After connecting to WiFi, check for software update and download if possible
+  //Start SNTP in background. Freshness isn't measured until it syncs.
+  configTime(0, 0, NTP_SERVER_1, NTP_SERVER_2);
+
+  //Start metrics endpoint. Reset reason is a String, so copied once here rather than on every scrape.
+  strncpy(reset_reason, ESP.getResetReason().c_str(), sizeof(reset_reason) - 1); /* Flawfinder: ignore */
+  format_flight_page();
+  metrics_server.on("/metrics", handle_metrics);
+  metrics_server.on("/flight", handle_flight);
+  #ifdef PROFILE
+    metrics_server.on("/profile", handle_profile);
+  #endif
+  metrics_server.begin();
+
+  add_tls_hosts();
+
+  //Software update and special train checks run from loop() once the first frame is shown, then every few hours.
+  //An update found is downloaded between frames (see ota_slice), then flashed on reboot after a live frame is saved.
   if(AUTOUPDATE){
-    strip.setPixelColor(WEB_LED, BL_HEX_COLOR);
-    strip.show();
-    check_for_update(client);
+    background_tasks.add("check_update", task_check_update, UPDATE_CHECK_HOURS * 3600000UL, true);
   }
+  background_tasks.add("check_special", task_check_special, SPECIAL_TRAIN_CHECK_HOURS * 3600000UL, true);
 
-  //Check if there is a special campaign, and retrieve its TrainID if so (or -1 if no special)
-  special_train_id = check_for_special_train(client);
-
-  // Set Yello Web LED while checking for special trains
-  strip.setPixelColor(WEB_LED, YL_HEX_COLOR);
-  strip.show();
+  // Set Yellow Web LED until first poll of train data
+  compositor.setStatus(WEB_LED, YL_HEX_COLOR);
+  compositor.render();
 
   //Set HTTPS connection settings in prep for main loop WMATA API
   client.setTimeout(15000); //recommended default
   client.flush();
   client.stopAll();
-  https.useHTTP10(true); //enables more efficient Json deserialization per https://arduinojson.org/v6/how-to/use-arduinojson-with-httpclient/
 
   //Initialize mutli-loop counters
   data_failure_count = 0;
@@ -125,15 +365,18 @@ void setup() {
   train_pos_filter["attributes"]["TRKID"] = true;
   train_pos_filter["attributes"]["TRACKLINE"] = true;
   train_pos_filter["attributes"]["TRIP_DIRECTION"] = true;
+  train_pos_filter["attributes"]["ETIME"] = true;
 
-  if(special_train_id != -1){
-    train_pos_filter["attributes"]["ITT"] = true; //Was just ["TrainId"]
-  }
+  apply_special_trains(); //Restored by warm start, if any
   
   //Leave setup and turn Web led yellow
   #ifdef PRINT
     Serial.println("Leaving setup");
+    Serial.printf("Heap - Free: %u, Largest Block: %u, Fragmentation: %u%%\n", ESP.getFreeHeap(), ESP.getMaxFreeBlockSize(), ESP.getHeapFragmentation());
   #endif
+  sample_heap(HEAP_POST_SETUP);
+
+  flight_recorder.endLoop();
 
 }//END SETUP
 
@@ -144,198 +387,95 @@ void setup() {
 // the loop function runs over and over again forever
 void loop() {
 
-  #ifdef PRINT
-    Serial.println("---- NEW LOOP ----");
-  #endif
+  PROFILE_START(loop_timer, PROF_LOOP);
+  yield_monitor.markYield(); //Core yields between calls to loop()
 
-  bool getting_live_trains = true;
+  LOG_INFO(EV_LOOP_START, total_run_count + 1);
 
-  //Connect and confirm HTTPS connection to api.wmata.com. If not, set LED red.
-  client.setFingerprint(DATA_SOURCE_FINGERPRINT);
-  if(!https.begin(client, DATA_SOURCE_ENDPOINT)){
-    strip.setPixelColor(WEB_LED, RD_HEX_COLOR);
-    strip.show();
-    getting_live_trains = false;
-
-    #ifdef PRINT
-      Serial.println("HTTPS connection failed");
-    #endif
-  }
-
-  //Use one of three WMATA API Keys to stay under usage quota. Actuall randomness not important, just variance in key usage.
-  //https.addHeader("api_key", wmata_api_keys[random(3)]); /* Flawfinder: ignore */
+  bool getting_live_trains = true;
 
-  //Request train data from server. If unsuccessful, set LED red. If successful, deserialize the JSON data returned by the API
-  int httpCode = https.GET();
+  heap_telemetry.nextLoop();
+  flight_recorder.beginLoop(total_run_count + 1);
+  sample_heap(HEAP_PRE_TLS);
+
+  //Connect and confirm HTTPS connection to data source and request train data. If unsuccessful, set LED red.
+  //Request and response headers use static buffers (see auto_update.h), so no heap allocation.
+  uint32_t fetch_start = millis();
+  enter_phase(PROF_HANDSHAKE);
+  int httpCode = https_get(client, PSTR(DATA_SOURCE_ENDPOINT), NULL);
+  flight_recorder.setFetch(httpCode, millis() - fetch_start);
+  sample_heap(HEAP_POST_HANDSHAKE);
   if (httpCode < 200 || httpCode >= 300) {
-    strip.setPixelColor(WEB_LED, RD_HEX_COLOR);
-    strip.show();
+    compositor.setStatus(WEB_LED, RD_HEX_COLOR);
+    flight_recorder.addFlags(FLIGHT_ERR_HTTP);
 
     getting_live_trains = false;
-
-    #ifdef PRINT
-      Serial.println("GET Request failed");
-      Serial.println(httpCode);
-    #endif
+    LOG_ERROR(EV_HTTP_FAILED, httpCode);
   }
 
+  //Use one of three WMATA API Keys to stay under usage quota. Actuall randomness not important, just variance in key usage.
+  //https.addHeader("api_key", wmata_api_keys[random(3)]); /* Flawfinder: ignore */
 
-  //large scoped vars to track the presence of special trains
-  uint8_t special_train_index = 0;
-  uint8_t special_train_dir = 0;
-  TrainLine* special_train_line = NULL;
+  uint64_t newest_position_ms = 0; //Newest ETIME in response, for freshness metric
 
   //counts for active trains across all lines
   uint8_t countfail=0;
   uint8_t total_count=0;
 
-  //Use chunk filtering to only deserialize one train object at a time
+  //Only load each train object into the static JSON document at a time to preserve RAM by iterating through TCP stream.
+  //WifiClient is actual consistent source of https stream.
   // https://arduinojson.org/v6/how-to/deserialize-a-very-large-document/
-  uint16_t json_size = JSON_DOC_SIZE;
-  DynamicJsonDocument doc(json_size);
-
-  //Only load each train object into a JSON document at a time to preserve RAM by iterating through TCP stream.
-  //WifiClient is actual consistent source of https stream. If can't find, create error. 
-  if(!client.find("\"features\":[")){     // VERSION 1.0: client.find("\"TrainPositions\":[")
-    strip.setPixelColor(WEB_LED, RD_HEX_COLOR);
-    strip.show();
-    getting_live_trains = false;
- 
-    #ifdef PRINT
-      Serial.println("Unable to find '\"TrainPositions\":[' in HTTP response.");
-    #endif
-  };
-
-  #ifdef PRINT
-    Serial.println("Begin loop through trains");
-  #endif
-
-  do {
-
-    DeserializationError error = deserializeJson(doc, client, DeserializationOption::Filter(train_pos_filter));
-
-    if (error) {
+  uint32_t parse_start = millis();
+  enter_phase(PROF_DESERIALIZE);
+  if(getting_live_trains){
+    TrainFeedResult feed = parseTrainFeed(client, json_arena, train_pos_filter, all_lines, NUM_LINES, special_trains, sample_heap_mid_parse);
 
-      strip.setPixelColor(WEB_LED, RD_HEX_COLOR);
-      strip.show();
+    if(!feed.ok){
+      compositor.setStatus(WEB_LED, RD_HEX_COLOR);
       getting_live_trains = false;
-
-      #ifdef PRINT
-        Serial.printf("JSON Deserialization Failed: %s\n", error.f_str());
-        Serial.printf("Intended JSON Document Size: %d\n", json_size);
-        Serial.printf("JSON Doc Size: %d\n", doc.size());
-        Serial.printf("Actual JSON Document Size: %d\n", doc.capacity());
-        Serial.printf("HTTP Response Code %d\n", httpCode);
-        Serial.printf("HTTP Body Size: %d\n", https.getSize());
-        //Serial.printf("Overflowed? %s\n", doc.overflowed());
-      #endif
+      flight_recorder.addFlags(FLIGHT_ERR_PARSE);
+    }
+    if(feed.unmatched > 0){
+      flight_recorder.addFlags(FLIGHT_ERR_UNMATCHED);
     }
 
-    //Only work on trains that are on a line. JsonObject removes key if value is null.
-    else if(doc["attributes"]["TRACKLINE"]){ // VERSION 1.0: Check  doc["LineCode"]
-
-      //Isolate variables from JsonObject returned by API
-      const char* trkID = doc["attributes"]["TRKID"].as<const char*>();
-      const uint8_t train_dir = doc["attributes"]["TRIP_DIRECTION"].as<unsigned short>();
-      const char* train_line = doc["attributes"]["TRACKLINE"].as<const char*>();
-
-      // Version 1.0 object names
-      /*
-      const uint16_t circID = doc["CircuitId"].as<unsigned int>();
-      const uint8_t train_dir = doc["DirectionNum"].as<unsigned short>();
-      const char* train_line = doc["LineCode"].as<const char*>();
-      */
-
-      int16_t trainID = -1;
-
-      if (special_train_id != -1){
-        trainID = doc["attributes"]["ITT"].as<int16_t>();
-      }
-
-      // Current TrainLocation tracking variables
-      const char line_char = train_line[0]; //get first character of line, as switch statements work on chars but not strings.
-      int res = -1; //store result of setting each train
-      TrainLine* cur_train_line = NULL; //store which TrainLine object has current line
-
-      #ifdef PRINT
-        Serial.printf("Line: %s, Direction: %d, Circuit: %s, ", train_line, train_dir, trkID); //circID); //continued after station determined
-      #endif
-
-      // Find the line the train is on by color, and update that line with the train.
-      for (uint8_t i=0; i<NUM_LINES; i++){
-        if (strcmp(all_lines[i]->getColor(), train_line) == 0){
-          cur_train_line = all_lines[i];
-          res = cur_train_line->setTrainStateByCode(trkID, train_dir-1); //setTrainState(cirID, train_dir);
-          break;
-        }
-      }
-
-      //If current line not set among all lines, update failure count
-      if (cur_train_line == NULL){
-        countfail++;
-      }
-
-      #ifdef PRINT
-        Serial.printf("Station Index: %d\n", res); //Finish debugging / output info
-      #endif
-
-      // Check for special train. If special train is -1, ensure it fails.
-      if( special_train_id != -1 && special_train_id == trainID ){
-
-        special_train_index = res;
-        special_train_line = cur_train_line;
-        special_train_dir = train_dir-1;
-
-        #ifdef PRINT
-          Serial.printf("Setting Special Train on line: %c index: %d\n", line_char, res);
-        #endif
-      }
-
-    }//end if train is on a line
-
-    doc.clear();
-
-  } while (client.findUntil("," , "]")); //Iterate through end of Json Array.
+    countfail = feed.unmatched;
+    newest_position_ms = feed.newest_ms;
+    wall_clock.setFromFeed(feed.newest_ms); //Date for special train campaigns, without a request of its own
+  }
 
-  https.end();
+  client.stop();
 
-  // Get total output by adding trains, and print totals if printing debug output
+  // Get total output by adding trains, and log totals
   for (uint8_t i=0; i<NUM_LINES; i++){
     total_count+=all_lines[i]->getTrainCount();
-    #ifdef PRINT
-      Serial.printf("%s Count: %d\n", all_lines[i]->getColor(), all_lines[i]->getTrainCount());
-    #endif
+    LOG_DEBUG(EV_LINE_COUNT, i, all_lines[i]->getTrainCount());
   }
 
-  #ifdef PRINT
-    Serial.printf("Total Count: %d\n", total_count);
-    Serial.printf("Fail Count: %d\n", countfail);
-  #endif
+  LOG_INFO(EV_PARSE_DONE, total_count, countfail, millis() - parse_start);
  
   // If Data API returns empty array, show failure
+  flight_recorder.setParse(millis() - parse_start, total_count);
   if (total_count == 0){ //Was `doc["TrainPositions"].size()` when loading entire doc at once
-    strip.setPixelColor(WEB_LED, RD_HEX_COLOR);
-    strip.show();
+    compositor.setStatus(WEB_LED, RD_HEX_COLOR);
     getting_live_trains = false;
-
-    #ifdef PRINT
-      Serial.println("Empty Train Positions Array");
-    #endif
+    flight_recorder.addFlags(FLIGHT_ERR_EMPTY);
+    LOG_WARN(EV_FEED_EMPTY);
   }
 
+  //Compare before setEndLED adds its own state
+  fetch_stats.record(millis() - fetch_start, getting_live_trains, getting_live_trains && trains_unchanged());
+
   //If no error, set Web pixel to green and reset data failure count.
   if (getting_live_trains){
-    strip.setPixelColor(WEB_LED, GN_HEX_COLOR);
-    strip.show();
+    compositor.setStatus(WEB_LED, GN_HEX_COLOR);
     data_failure_count = 0;
   }
 
   // Pattern display to default to if there is an error with live data
   else {
 
-    #ifdef PRINT
-      Serial.printf("Failure Count: %d\n", data_failure_count);
-    #endif
+    LOG_WARN(EV_DATA_FAILURE, data_failure_count);
 
     // Put trains on the board in increments of 3 (one train every three cycles)
     uint8_t start_time = data_failure_count % 3;
@@ -358,9 +498,10 @@ void loop() {
         all_lines[l]->defaultShiftDisplay(0, (start_time == 0));
         all_lines[l]->defaultShiftDisplay(1, (start_time == 0));
       }
+      YIELD_POINT();
     }
 
-    if (data_failure_count == 255) {data_failure_count = 3;} //reset to prevent overflow
+    if (data_failure_count == 255) {data_failure_count = 3 * ((FEED_STUCK_FAILURES + 2) / 3);} //reset to prevent overflow, keeping the pattern phase and the feed stuck
 
     data_failure_count++;
 
@@ -368,57 +509,70 @@ void loop() {
 
   //Trains at the end of each line are handled differently (to avoid lingering LEDs).
   //Check each line's last station and set the LED as appropriate.
+  PROFILE_START(end_led_timer, PROF_SET_END_LED);
+  enter_phase(PROF_SET_END_LED);
   for(uint8_t l=0; l < NUM_LINES; l++){
     all_lines[l]->setEndLED();
   }
+  PROFILE_STOP(end_led_timer);
   // } // END live train data
 
 
 
   //For each LED, check if there is a train at the station represented by that LED.
   //If so, turn the station's LED that line's color. If no trains, turn the LED off.
+  //Stations with trains from more than one line are multiplexed by the compositor.
   #ifdef PRINT
     Serial.printf("Setting Strip LEDs\n");
   #endif
   
-  for(uint8_t k=0; k<strip.numPixels()-3; k++){ //do not turn off board status LEDs at end of "strip."
-    bool ledOn = false;
+  PROFILE_START(composite_timer, PROF_COMPOSITE);
+  enter_phase(PROF_COMPOSITE);
+  composite_trains();
 
-    for(uint8_t l=0; l<NUM_LINES; l++){
-      if(all_lines[l]->trainAtLED(k)){
-        ledOn = true;
-        strip.setPixelColor(k, all_lines[l]->getLEDColor());
-        break;
-      }
-    }//end check for every line on a single LED
-
-    //If no trains at station, turn LED off
-    if(!ledOn){
-      strip.setPixelColor(k, 0); //turn LED off
-    }
-
-  }//end loop through each LED
-
-  //If setting special LED color for a special train, do so, assuming the train is active. 
-  if(special_train_id != -1){
+  #ifdef PRINT
+    Serial.printf("Updating Strip with new State\n");
+  #endif
 
-    #ifdef PRINT
-      Serial.printf("Setting special train LED\n");
-      Serial.printf("Train ID: %d;   Train Index: %d;   Train Dir: %d\n", special_train_id, special_train_index, special_train_dir);
-    #endif
+  //Update the board with new state of the system. Flattens all layers (including status LEDs) and shows once.
+  compositor.render();
+  PROFILE_STOP(composite_timer);
+  sample_heap(HEAP_POST_RENDER);
+  if(getting_live_trains){
+    freshness_stats.record(newest_position_ms, sntp_epoch_ms());
+    warm_start.update(all_lines, special_trains);
 
-    if(special_train_line != NULL){
-      uint8_t special_led = special_train_line->getLEDForIndex(special_train_index, special_train_dir);
-      strip.setPixelColor(special_led, SPECIAL_TRAIN_HEX[total_run_count % SPECIAL_TRAIN_HEX_COUNT]);
+    if(first_live_frame_ms == 0){
+      first_live_frame_ms = millis();
+      if(first_frame_ms == 0){first_frame_ms = first_live_frame_ms;}
     }
   }
 
+  //Quiet moment to boot a downloaded update: this frame is live and saved, so warm start shows it again at boot.
+  //A board whose feed is stuck boots it anyway, since the new image may be what fixes the feed.
+  //Web LED turns blue while the new image is copied into place.
+  if(ota.isReady() && (getting_live_trains || feed_stuck())){
+    warm_start.flush();
+    compositor.setStatus(WEB_LED, BL_HEX_COLOR);
+    compositor.render();
+    ESP.restart();
+  }
+  update_metrics_page();
+
   #ifdef PRINT
-    Serial.printf("Updating Strip with new State\n");
+    Serial.printf("LED Current Estimate: %d mA (%d mA unlimited, scale %d/256)\n",
+      compositor.getCurrentEstimate(), compositor.getUnlimitedCurrentEstimate(), compositor.getLimitScale());
+
+    if(total_run_count % HEAP_REPORT_LOOPS == 0){
+      heap_telemetry.printReport(Serial);
+    }
   #endif
 
-  //Update the board with new state of the system
-  strip.show();
+  #ifdef PROFILE
+    if(total_run_count % PROFILE_REPORT_LOOPS == 0){
+      loop_profiler.printReport(Serial);
+    }
+  #endif
 
   // If there is a special train with multiple colors (pride), make it strobe.
   // VERSION 1.0 CODE TO DO STROBE PRE-UPDATE
@@ -442,15 +596,11 @@ void loop() {
     }
   }
 
-  //Update overall run counts and do time-based checks for special trains and board update. Count should never actually be when it reaches checks.
+  //Update overall run count. Frame is already shown, so run at most one due check (board update or special train).
+  //Checks wait for the first live frame, so they never hold up the board's first real trains after boot, unless the feed is stuck.
   total_run_count++;
-
-  if (AUTOUPDATE && total_run_count % ((UPDATE_CHECK_HOURS * 3600) / WAIT_SEC) == 0){
-    check_for_update(client);
-  }
-
-  if ( total_run_count % ((SPECIAL_TRAIN_CHECK_HOURS * 3600) / WAIT_SEC) == 0){
-    special_train_id = check_for_special_train(client);
+  if(first_live_frame_ms != 0 || feed_stuck()){
+    background_tasks.runNext();
   }
 
   if (total_run_count == (48 * 3600) / WAIT_SEC){
@@ -460,6 +610,18 @@ void loop() {
   #ifdef PRINT
     Serial.printf("End of loop\n");
   #endif
+
+  flight_recorder.endLoop();
+  PROFILE_STOP(loop_timer);
+
+  //No wait between polls on this board, so answer any scrapes once per loop
+  serve_metrics();
+
+  //Likewise write a few slices of any update being downloaded, then free client for next poll
+  for(uint8_t slice=0; slice<OTA_SLICES_PER_LOOP && ota.isActive(); slice++){
+    ota_slice(client);
+  }
+  ota_pause(client);
     
   // Wait set number of seconds (default 15) until next loop and API call. If strobing, waiting done already.
   //delay(WAIT_SEC * 1000);
@@ -0,0 +1,147 @@
+#include <Arduino.h>
+
+/*
+    Defines DeferredTasks class template - slow, occasional work (update check, special train check) that runs
+    from loop() after the frame is shown, instead of before it.
+
+    Each task has a period and can start pending, so boot checks run once the first frame is up rather than in
+    setup(). runNext() runs at most one pending task per call, oldest due first, so two HTTPS checks never land in
+    the same loop. A task that was due while another ran just waits a loop.
+
+    Periods are in milliseconds of uptime (unsigned subtraction handles millis() wrap).
+*/
+
+template<uint8_t N>
+class DeferredTasks {
+
+  private:
+    struct Task {
+      const char* name;
+      void (*run)();
+      uint32_t period_ms; //0 = only when triggered
+      uint32_t due_since; //millis() task became due, if pending
+      bool pending;
+      uint32_t last_start; //millis() of last run (or add)
+      uint32_t runs;
+      uint32_t last_ms; //How long last run took
+    };
+
+    Task tasks[N];
+    uint8_t num_tasks;
+
+  public:
+    DeferredTasks();
+
+    //Add a task. Returns its id, or -1 if full. If pending, it runs on the first runNext() call.
+    int8_t add(const char* name, void (*run)(), uint32_t period_ms, bool pending);
+    void trigger(uint8_t id); //Make task pending now
+
+    bool runNext(); //Run the longest-pending due task, if any. Returns true if one ran.
+
+    //Getters
+    bool isPending(uint8_t id);
+    uint32_t getRuns(uint8_t id);
+    uint32_t getLastMs(uint8_t id);
+
+    void printMetrics(Print &out);
+
+};//END DeferredTasks definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<uint8_t N>
+DeferredTasks<N>::DeferredTasks(){
+  num_tasks = 0;
+}
+
+template<uint8_t N>
+int8_t DeferredTasks<N>::add(const char* name, void (*run)(), uint32_t period_ms, bool pending){
+  if(num_tasks >= N){
+    return -1;
+  }
+  Task &t = tasks[num_tasks];
+  t.name = name;
+  t.run = run;
+  t.period_ms = period_ms;
+  t.pending = pending;
+  t.due_since = millis();
+  t.last_start = millis();
+  t.runs = 0;
+  t.last_ms = 0;
+  return num_tasks++;
+}
+
+template<uint8_t N>
+void DeferredTasks<N>::trigger(uint8_t id){
+  if(id < num_tasks && !tasks[id].pending){
+    tasks[id].pending = true;
+    tasks[id].due_since = millis();
+  }
+}
+
+template<uint8_t N>
+bool DeferredTasks<N>::runNext(){
+  uint32_t now = millis();
+  int8_t next = -1;
+
+  for(uint8_t i=0; i<num_tasks; i++){
+    Task &t = tasks[i];
+    if(!t.pending && t.period_ms != 0 && now - t.last_start >= t.period_ms){
+      t.pending = true;
+      t.due_since = t.last_start + t.period_ms;
+    }
+    if(t.pending && (next == -1 || (int32_t)(t.due_since - tasks[next].due_since) < 0)){
+      next = i;
+    }
+  }
+
+  if(next == -1){
+    return false;
+  }
+
+  Task &t = tasks[next];
+  t.pending = false;
+  t.last_start = now;
+  t.run();
+  t.last_ms = millis() - now;
+  t.runs++;
+  return true;
+}
+
+template<uint8_t N>
+bool DeferredTasks<N>::isPending(uint8_t id){
+  return id < num_tasks && tasks[id].pending;
+}
+
+template<uint8_t N>
+uint32_t DeferredTasks<N>::getRuns(uint8_t id){
+  return (id < num_tasks) ? tasks[id].runs : 0;
+}
+
+template<uint8_t N>
+uint32_t DeferredTasks<N>::getLastMs(uint8_t id){
+  return (id < num_tasks) ? tasks[id].last_ms : 0;
+}
+
+template<uint8_t N>
+void DeferredTasks<N>::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_task_runs_total counter\n"));
+  for(uint8_t i=0; i<num_tasks; i++){
+    out.print(F("dctransistor_task_runs_total{task=\""));
+    out.print(tasks[i].name);
+    out.print(F("\"} "));
+    out.print(tasks[i].runs);
+    out.print('\n');
+  }
+  out.print(F("# TYPE dctransistor_task_last_duration_ms gauge\n"));
+  for(uint8_t i=0; i<num_tasks; i++){
+    out.print(F("dctransistor_task_last_duration_ms{task=\""));
+    out.print(tasks[i].name);
+    out.print(F("\"} "));
+    out.print(tasks[i].last_ms);
+    out.print('\n');
+  }
+}
+
+// END FUNCTION IMPLEMENTATION
@@ -0,0 +1,53 @@
+#include <Arduino.h>
+
+/*
+    Helpers for static board data kept in flash (PROGMEM) instead of DRAM.
+
+    On the ESP8266, plain const tables and string literals are copied into DRAM at boot. Station codes, LED maps
+    and color palettes are declared FLASH_TABLE in config.h and read back through the accessors below.
+
+    Flash can only be read a 32-bit aligned word at a time. Every station code is stored in its own 4-byte,
+    word-aligned slot (3 letters + NUL), so matching a code is one pgm_read_dword and one integer compare
+    instead of a byte-by-byte strcmp_P.
+
+    The pgm_read_* accessors also work on DRAM pointers, so callers can pass either.
+*/
+
+//Place a const table in flash, aligned so word reads are a single load
+#define FLASH_TABLE PROGMEM __attribute__((aligned(4)))
+
+//WMATA station code (e.g. "A01") padded to one aligned word
+#define STATION_CODE_LEN 4
+typedef char StationCode[STATION_CODE_LEN];
+
+//Pack a DRAM station code string into the same word layout as a StationCode table entry.
+//Returns 0 (matches no station) if code is empty or longer than 3 characters.
+inline uint32_t packStationCode(const char* code){
+  char padded[STATION_CODE_LEN] = {0};
+  for(uint8_t i=0; i<STATION_CODE_LEN; i++){
+    if(code[i] == '\0'){
+      if(i == 0){return 0;}
+      uint32_t word;
+      memcpy(&word, padded, sizeof(word));
+      return word;
+    }
+    if(i == STATION_CODE_LEN-1){return 0;}
+    padded[i] = code[i];
+  }
+  return 0;
+}
+
+//Read station code i from a flash table as one packed word
+inline uint32_t readStationCode(const StationCode* codes, uint8_t i){
+  return pgm_read_dword(codes[i]);
+}
+
+//Read entry i from a flash byte table (e.g. LED maps)
+inline uint8_t readFlashByte(const uint8_t* table, uint8_t i){
+  return pgm_read_byte(table + i);
+}
+
+//Read entry i from a flash word table (e.g. color palettes)
+inline uint32_t readFlashWord(const uint32_t* table, uint8_t i){
+  return pgm_read_dword(table + i);
+}
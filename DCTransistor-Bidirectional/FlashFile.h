@@ -0,0 +1,42 @@
+#include <Arduino.h>
+
+/*
+    Small binary records kept in LittleFS (warm start frame, cached special train campaigns).
+
+    crc32() checks a record on load. Writes go to a temporary file that is then renamed over the old one, so a reset
+    mid-write keeps the old record. LittleFS.begin() must be called first.
+
+    crc32() compiles on Desktop (using EpoxyDuino) for unit tests; the file functions are Arduino only.
+*/
+
+//CRC-32 (IEEE, reflected), bitwise - records are small and written rarely
+uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0){
+  crc = ~crc;
+  for(size_t i=0; i<len; i++){
+    crc ^= data[i];
+    for(uint8_t b=0; b<8; b++){
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+#ifndef EPOXY_DUINO
+  //Read len bytes of file at path. Returns false if missing or too short.
+  bool readFlashFile(const char* path, uint8_t* data, size_t len){
+    File f = LittleFS.open(path, "r");
+    if(!f){return false;}
+    size_t n = f.read(data, len);
+    f.close();
+    return n == len;
+  }
+
+  //Replace file at path with len bytes of data. tmp_path is written first, then renamed over path.
+  bool writeFlashFile(const char* path, const char* tmp_path, const uint8_t* data, size_t len){
+    File f = LittleFS.open(tmp_path, "w");
+    if(!f){return false;}
+    size_t n = f.write(data, len);
+    f.close();
+    return n == len && LittleFS.rename(tmp_path, path);
+  }
+#endif
@@ -0,0 +1,294 @@
+#include <Arduino.h>
+
+/*
+    Defines FlightRecorder class template - a ring buffer of the last N loops kept in RTC user memory, which
+    survives watchdog resets, exceptions and ESP.restart() (but not power loss). On the next boot the previous
+    boot's records are read back, so a crash mid-handshake still leaves the loops leading up to it.
+
+    Each record is 16 bytes: loop number, HTTP code, fetch / parse / loop times, minimum heap, trains shown,
+    error flags, and the phase (ProfilePhase, LoopProfiler.h) the loop was last in. A loop's record is written
+    with FLIGHT_IN_PROGRESS set when it starts, each phase change rewrites a single word, and endLoop() writes
+    the finished record. begin() clears the ring after reading it back, so a record still marked in progress on
+    boot is always the last boot's loop that never finished.
+
+    Storage is a template parameter with static read / write of 4-byte blocks, so tests can use RAM.
+    RtcStore uses ESP.rtcUserMemoryRead/Write, starting after the 32 blocks reserved for OTA.
+*/
+
+#define FLIGHT_MAGIC 0xF17E //Marks header as written by this firmware (RTC memory is random after power loss)
+
+//Error flags for a loop
+#define FLIGHT_IN_PROGRESS 0x01 //Loop started but endLoop() never ran
+#define FLIGHT_ERR_HTTP    0x02 //Data source request failed or returned non-2xx
+#define FLIGHT_ERR_PARSE   0x04 //Train array missing or a train failed to deserialize
+#define FLIGHT_ERR_EMPTY   0x08 //No trains on any line
+#define FLIGHT_ERR_UNMATCHED 0x10 //A train's line matched no TrainLine
+
+//One loop. Word 3 (trains, flags, phase, fragmentation) is rewritten alone on each phase change.
+struct FlightRecord {
+  uint16_t loop;
+  int16_t http_code;
+  uint16_t fetch_ms; //Connect, handshake and response headers
+  uint16_t parse_ms;
+  uint16_t loop_ms;
+  uint16_t heap_min;
+  uint8_t trains;
+  uint8_t flags;
+  uint8_t phase;
+  uint8_t fragmentation_max;
+};
+
+static_assert(sizeof(FlightRecord) == 16, "FlightRecord must be 4 RTC blocks");
+
+//Why the board last reset. Filled from ESP.getResetInfoPtr() on the board.
+struct CrashInfo {
+  const char* reason;
+  uint32_t exccause;
+  uint32_t epc1;
+  uint32_t excvaddr;
+};
+
+#ifndef EPOXY_DUINO
+  //RTC user memory. Blocks 0-31 are used by OTA, 32-127 are free.
+  struct RtcStore {
+    static const uint8_t FIRST_BLOCK = 32;
+    static bool read(uint8_t block, uint32_t* data, size_t bytes){
+      return ESP.rtcUserMemoryRead(FIRST_BLOCK + block, data, bytes);
+    }
+    static bool write(uint8_t block, uint32_t* data, size_t bytes){
+      return ESP.rtcUserMemoryWrite(FIRST_BLOCK + block, data, bytes);
+    }
+  };
+#endif
+
+template<typename Store, uint8_t N>
+class FlightRecorder {
+
+  static_assert(2 + (N * 4) <= 96, "Flight records don't fit in RTC user memory");
+
+  private:
+    static const uint8_t HEADER_BLOCKS = 2;
+    static const uint8_t RECORD_BLOCKS = sizeof(FlightRecord) / 4;
+
+    //Header: magic, next slot and record count packed in one block, boot count in the other
+    uint32_t header[HEADER_BLOCKS];
+    uint8_t next;
+    uint8_t count;
+
+    FlightRecord current;
+    uint32_t loop_start;
+
+    //Previous boot, oldest first
+    FlightRecord previous[N];
+    uint8_t num_previous;
+    uint32_t previous_boots;
+
+    uint8_t blockOf(uint8_t slot){ return HEADER_BLOCKS + (slot * RECORD_BLOCKS); }
+    void writeHeader();
+    void writeCurrent();
+
+  public:
+    FlightRecorder();
+
+    void begin(); //Read back previous boot and start a new ring. Call once, early in setup().
+
+    //Recording, in loop order
+    void beginLoop(uint16_t loop);
+    void setPhase(uint8_t phase); //Cheap - one block write
+    void noteHeap(uint32_t free_heap, uint8_t fragmentation);
+    void setFetch(int16_t http_code, uint32_t ms);
+    void setParse(uint32_t ms, uint8_t trains);
+    void addFlags(uint8_t flags);
+    void endLoop();
+
+    //Previous boot
+    uint8_t getPreviousCount();
+    const FlightRecord& getPrevious(uint8_t i); //0 = oldest
+    uint32_t getBootCount(); //Boots since RTC memory was last cleared (power loss)
+
+    void printReport(Print &out, const CrashInfo &crash, const char* const phase_names[], uint8_t num_phases);
+
+};//END FlightRecorder definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<typename Store, uint8_t N>
+FlightRecorder<Store, N>::FlightRecorder(){
+  next = 0;
+  count = 0;
+  num_previous = 0;
+  previous_boots = 0;
+  loop_start = 0;
+  header[0] = 0;
+  header[1] = 0;
+  memset(&current, 0, sizeof(current));
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::begin(){
+  num_previous = 0;
+  previous_boots = 0;
+
+  Store::read(0, header, sizeof(header));
+  uint8_t old_next = (header[0] >> 8) & 0xFF;
+  uint8_t old_count = header[0] & 0xFF;
+
+  if((header[0] >> 16) == FLIGHT_MAGIC && old_next < N && old_count <= N){
+    previous_boots = header[1];
+
+    //Slot being written when the board reset, if it was. When the ring was full it replaced the oldest record.
+    FlightRecord last;
+    Store::read(blockOf(old_next), (uint32_t*)&last, sizeof(FlightRecord));
+    bool in_progress = last.flags & FLIGHT_IN_PROGRESS;
+    uint8_t finished = (in_progress && old_count == N) ? N - 1 : old_count;
+
+    //Finished records oldest first, then the unfinished one
+    uint8_t first = (old_next + N - finished) % N;
+    for(uint8_t i=0; i<finished; i++){
+      Store::read(blockOf((first + i) % N), (uint32_t*)&previous[num_previous], sizeof(FlightRecord));
+      num_previous++;
+    }
+    if(in_progress){
+      previous[num_previous++] = last;
+    }
+  }
+
+  //Clear the ring. Otherwise a boot that ends between loops leaves an earlier boot's unfinished record at its next
+  //slot, and the boot after it would report that as its own. Loop numbers can't tell them apart (every boot starts at 0).
+  FlightRecord empty;
+  memset(&empty, 0, sizeof(empty));
+  for(uint8_t i=0; i<N; i++){
+    Store::write(blockOf(i), (uint32_t*)&empty, sizeof(FlightRecord));
+  }
+
+  next = 0;
+  count = 0;
+  header[1] = previous_boots + 1;
+  writeHeader();
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::writeHeader(){
+  header[0] = ((uint32_t)FLIGHT_MAGIC << 16) | ((uint32_t)next << 8) | count;
+  Store::write(0, header, sizeof(header));
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::writeCurrent(){
+  Store::write(blockOf(next), (uint32_t*)&current, sizeof(FlightRecord));
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::beginLoop(uint16_t loop){
+  memset(&current, 0, sizeof(current));
+  current.loop = loop;
+  current.heap_min = 0xFFFF;
+  current.flags = FLIGHT_IN_PROGRESS;
+  loop_start = millis();
+  writeCurrent();
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::setPhase(uint8_t phase){
+  current.phase = phase;
+  Store::write(blockOf(next) + 3, ((uint32_t*)&current) + 3, 4);
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::noteHeap(uint32_t free_heap, uint8_t fragmentation){
+  uint16_t free16 = (free_heap > 0xFFFF) ? 0xFFFF : free_heap;
+  if(free16 < current.heap_min){current.heap_min = free16;}
+  if(fragmentation > current.fragmentation_max){current.fragmentation_max = fragmentation;}
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::setFetch(int16_t http_code, uint32_t ms){
+  current.http_code = http_code;
+  current.fetch_ms = (ms > 0xFFFF) ? 0xFFFF : ms;
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::setParse(uint32_t ms, uint8_t trains){
+  current.parse_ms = (ms > 0xFFFF) ? 0xFFFF : ms;
+  current.trains = trains;
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::addFlags(uint8_t flags){
+  current.flags |= flags;
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::endLoop(){
+  uint32_t ms = millis() - loop_start;
+  current.loop_ms = (ms > 0xFFFF) ? 0xFFFF : ms;
+  current.flags &= ~FLIGHT_IN_PROGRESS;
+  writeCurrent();
+
+  next = (next + 1) % N;
+  if(count < N){count++;}
+  writeHeader();
+}
+
+template<typename Store, uint8_t N>
+uint8_t FlightRecorder<Store, N>::getPreviousCount(){
+  return num_previous;
+}
+
+template<typename Store, uint8_t N>
+const FlightRecord& FlightRecorder<Store, N>::getPrevious(uint8_t i){
+  return previous[i];
+}
+
+template<typename Store, uint8_t N>
+uint32_t FlightRecorder<Store, N>::getBootCount(){
+  return header[1];
+}
+
+template<typename Store, uint8_t N>
+void FlightRecorder<Store, N>::printReport(Print &out, const CrashInfo &crash, const char* const phase_names[], uint8_t num_phases){
+  out.print(F("boot "));
+  out.print(getBootCount());
+  out.print(F(" reset="));
+  out.print(crash.reason);
+  out.print(F(" exccause="));
+  out.print(crash.exccause);
+  out.print(F(" epc1=0x"));
+  out.print(crash.epc1, HEX);
+  out.print(F(" excvaddr=0x"));
+  out.print(crash.excvaddr, HEX);
+  out.print('\n');
+
+  out.print(F("loop http fetch_ms parse_ms loop_ms heap_min frag_max trains flags phase\n"));
+  for(uint8_t i=0; i<num_previous; i++){
+    const FlightRecord &r = previous[i];
+    out.print(r.loop);
+    out.print(' ');
+    out.print(r.http_code);
+    out.print(' ');
+    out.print(r.fetch_ms);
+    out.print(' ');
+    out.print(r.parse_ms);
+    out.print(' ');
+    out.print(r.loop_ms);
+    out.print(' ');
+    out.print(r.heap_min);
+    out.print(' ');
+    out.print(r.fragmentation_max);
+    out.print(' ');
+    out.print(r.trains);
+    out.print(F(" 0x"));
+    out.print(r.flags, HEX);
+    out.print(' ');
+    if(r.phase < num_phases){
+      out.print(phase_names[r.phase]);
+    }
+    else{
+      out.print(r.phase);
+    }
+    out.print('\n');
+  }
+}
+
+// END FUNCTION IMPLEMENTATION
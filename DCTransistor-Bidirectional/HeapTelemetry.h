@@ -0,0 +1,237 @@
+#include <Arduino.h>
+
+/*
+    Defines HeapTelemetry class template - records free heap, largest free block and fragmentation at fixed points
+    ("phases") of every loop, to size JSON_DOC_SIZE and BearSSL buffers from real data and catch slow leaks before they reset the board.
+
+    Keeps the last N samples in a ring buffer, plus per-phase min / max and board-wide low-water marks since boot.
+    Samples are 8 bytes and recording one is a handful of compares, so it can run every loop.
+
+    Values are passed in (from ESP.getHeapStats() on the board), so the class compiles on Desktop (using EpoxyDuino) and Arduino.
+*/
+
+//Points in loop() where heap is sampled
+enum HeapPhase : uint8_t {
+  HEAP_PRE_TLS = 0,       //Before connecting to data source
+  HEAP_POST_HANDSHAKE,    //TLS session up and response headers read (BearSSL buffers allocated)
+  HEAP_MID_PARSE,         //After first train object parsed
+  HEAP_POST_RENDER,       //After frame shown, connection closed
+  HEAP_POST_SETUP,        //Once, at end of setup(): free heap at boot, after globals, WiFi and the web server
+  NUM_HEAP_PHASES
+};
+
+const char* const heap_phase_names[NUM_HEAP_PHASES] = {"pre_tls", "post_handshake", "mid_parse", "post_render", "post_setup"};
+
+//One heap sample. Free heap and block sizes fit 16 bits on ESP8266 (~50KB heap).
+struct HeapSample {
+  uint16_t loop; //Low 16 bits of loop count when taken
+  uint16_t free_heap;
+  uint16_t max_block;
+  uint8_t fragmentation; //Percent
+  uint8_t phase;
+};
+
+//Min / max of each value for one phase since boot
+struct HeapPhaseStats {
+  uint16_t min_free;
+  uint16_t max_free;
+  uint16_t min_block;
+  uint8_t max_fragmentation;
+  uint32_t count;
+};
+
+template<uint8_t N>
+class HeapTelemetry {
+
+  private:
+    HeapSample ring[N];
+    uint8_t next; //Index next sample is written to
+    uint8_t size; //Number of valid samples in ring
+    HeapPhaseStats phases[NUM_HEAP_PHASES];
+    uint16_t loop_count;
+
+    static uint16_t clamp16(uint32_t value){
+      return (value > 0xFFFF) ? 0xFFFF : value;
+    }
+
+  public:
+    HeapTelemetry();
+
+    void reset();
+    void nextLoop(); //Call once at start of each loop so samples can be grouped
+    void record(HeapPhase phase, uint32_t free_heap, uint32_t max_block, uint8_t fragmentation);
+
+    //Getters
+    uint8_t getSampleCount();
+    const HeapSample& getSample(uint8_t age); //0 = most recent
+    const HeapPhaseStats& getPhaseStats(HeapPhase phase);
+    uint16_t getLowWaterFree(); //Lowest free heap seen in any phase
+    uint16_t getLowWaterBlock(); //Smallest largest-free-block seen in any phase (what a big allocation can count on)
+    uint8_t getHighWaterFragmentation();
+
+    //Output
+    void printReport(Print &out); //Human readable, one line per phase plus most recent loop
+    void printMetrics(Print &out); //Prometheus text format, for metrics endpoint
+
+};//END HeapTelemetry definition
+
+template<uint8_t N>
+HeapTelemetry<N>::HeapTelemetry(){
+  reset();
+}
+
+template<uint8_t N>
+void HeapTelemetry<N>::reset(){
+  next = 0;
+  size = 0;
+  loop_count = 0;
+  for(uint8_t p=0; p<NUM_HEAP_PHASES; p++){
+    phases[p].min_free = 0xFFFF;
+    phases[p].max_free = 0;
+    phases[p].min_block = 0xFFFF;
+    phases[p].max_fragmentation = 0;
+    phases[p].count = 0;
+  }
+}
+
+template<uint8_t N>
+void HeapTelemetry<N>::nextLoop(){
+  loop_count++;
+}
+
+template<uint8_t N>
+void HeapTelemetry<N>::record(HeapPhase phase, uint32_t free_heap, uint32_t max_block, uint8_t fragmentation){
+  if(phase >= NUM_HEAP_PHASES){
+    return;
+  }
+
+  HeapSample &sample = ring[next];
+  sample.loop = loop_count;
+  sample.free_heap = clamp16(free_heap);
+  sample.max_block = clamp16(max_block);
+  sample.fragmentation = fragmentation;
+  sample.phase = phase;
+
+  next = (next + 1) % N;
+  if(size < N){size++;}
+
+  HeapPhaseStats &stats = phases[phase];
+  if(sample.free_heap < stats.min_free){stats.min_free = sample.free_heap;}
+  if(sample.free_heap > stats.max_free){stats.max_free = sample.free_heap;}
+  if(sample.max_block < stats.min_block){stats.min_block = sample.max_block;}
+  if(fragmentation > stats.max_fragmentation){stats.max_fragmentation = fragmentation;}
+  stats.count++;
+}
+
+template<uint8_t N>
+uint8_t HeapTelemetry<N>::getSampleCount(){
+  return size;
+}
+
+template<uint8_t N>
+const HeapSample& HeapTelemetry<N>::getSample(uint8_t age){
+  if(age >= size){age = size - 1;}
+  return ring[(next + N - 1 - age) % N];
+}
+
+template<uint8_t N>
+const HeapPhaseStats& HeapTelemetry<N>::getPhaseStats(HeapPhase phase){
+  return phases[phase];
+}
+
+template<uint8_t N>
+uint16_t HeapTelemetry<N>::getLowWaterFree(){
+  uint16_t low = 0xFFFF;
+  for(uint8_t p=0; p<NUM_HEAP_PHASES; p++){
+    if(phases[p].count > 0 && phases[p].min_free < low){low = phases[p].min_free;}
+  }
+  return low;
+}
+
+template<uint8_t N>
+uint16_t HeapTelemetry<N>::getLowWaterBlock(){
+  uint16_t low = 0xFFFF;
+  for(uint8_t p=0; p<NUM_HEAP_PHASES; p++){
+    if(phases[p].count > 0 && phases[p].min_block < low){low = phases[p].min_block;}
+  }
+  return low;
+}
+
+template<uint8_t N>
+uint8_t HeapTelemetry<N>::getHighWaterFragmentation(){
+  uint8_t high = 0;
+  for(uint8_t p=0; p<NUM_HEAP_PHASES; p++){
+    if(phases[p].max_fragmentation > high){high = phases[p].max_fragmentation;}
+  }
+  return high;
+}
+
+template<uint8_t N>
+void HeapTelemetry<N>::printReport(Print &out){
+  out.print(F("Heap low-water - Free: "));
+  out.print(getLowWaterFree());
+  out.print(F(", Largest Block: "));
+  out.print(getLowWaterBlock());
+  out.print(F(", Fragmentation high-water: "));
+  out.print(getHighWaterFragmentation());
+  out.println('%');
+
+  for(uint8_t p=0; p<NUM_HEAP_PHASES; p++){
+    if(phases[p].count == 0){continue;}
+    out.print(F("  "));
+    out.print(heap_phase_names[p]);
+    out.print(F(" - Free: "));
+    out.print(phases[p].min_free);
+    out.print('-');
+    out.print(phases[p].max_free);
+    out.print(F(", Min Block: "));
+    out.print(phases[p].min_block);
+    out.print(F(", Max Frag: "));
+    out.print(phases[p].max_fragmentation);
+    out.println('%');
+  }
+
+  //Most recent loop, oldest phase first
+  for(int8_t age=NUM_HEAP_PHASES-1; age>=0; age--){
+    if(age >= size){continue;}
+    const HeapSample &sample = getSample(age);
+    if(sample.loop != loop_count){continue;}
+    out.print(F("  last "));
+    out.print(heap_phase_names[sample.phase]);
+    out.print(F(": "));
+    out.print(sample.free_heap);
+    out.print('/');
+    out.print(sample.max_block);
+    out.print('/');
+    out.print(sample.fragmentation);
+    out.println('%');
+  }
+}
+
+template<uint8_t N>
+void HeapTelemetry<N>::printMetrics(Print &out){
+  static const char* const metric_names[4] = {
+    "dctransistor_heap_free_min_bytes", "dctransistor_heap_free_max_bytes",
+    "dctransistor_heap_block_min_bytes", "dctransistor_heap_fragmentation_max_percent"
+  };
+
+  for(uint8_t m=0; m<4; m++){
+    out.print(F("# TYPE "));
+    out.print(metric_names[m]);
+    out.print(F(" gauge\n"));
+
+    for(uint8_t p=0; p<NUM_HEAP_PHASES; p++){
+      if(phases[p].count == 0){continue;}
+
+      uint16_t value = (m == 0) ? phases[p].min_free : (m == 1) ? phases[p].max_free : (m == 2) ? phases[p].min_block : phases[p].max_fragmentation;
+
+      //Prometheus text format needs bare \n line endings, so no println
+      out.print(metric_names[m]);
+      out.print(F("{phase=\""));
+      out.print(heap_phase_names[p]);
+      out.print(F("\"} "));
+      out.print(value);
+      out.print('\n');
+    }
+  }
+}
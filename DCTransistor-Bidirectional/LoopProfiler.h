@@ -0,0 +1,195 @@
+#include <Arduino.h>
+
+/*
+    Defines LoopProfiler class - micros() timing of each phase of setup(), loop(), check_for_update and
+    check_for_special_trains, aggregated into fixed log-scale histograms so a slow loop can be traced to
+    DNS, the TLS handshake, time to first byte, scanning for the train array, deserialization, setEndLED,
+    compositing or strip.show().
+
+    Bucket b holds durations in [2^b, 2^(b+1)) microseconds (bucket 0 also holds 0), and the last bucket holds
+    everything longer. Recording a duration is a count-leading-zeros and an increment, so timers can wrap
+    code that runs per train.
+
+    Instrumentation is only compiled in when PROFILE is defined (config.h). Otherwise PROFILE_SCOPE, PROFILE_START
+    and PROFILE_STOP expand to nothing and no profiler object exists, so a release build pays nothing.
+
+    printReport() output is one line per phase, read by misc_files/render_profile.py:
+      #PROFILE <buckets>
+      <phase> count=<n> total_us=<sum> min_us=<min> max_us=<max> hist=<b0>,<b1>,...
+      #END
+*/
+
+#define PROFILE_BUCKETS 24 //Last bucket starts at 2^23 us (~8.4s)
+
+//Timed phases. Nested phases overlap their parents (e.g. composite includes show).
+enum ProfilePhase : uint8_t {
+  PROF_SETUP = 0,        //All of setup()
+  PROF_LOOP,             //loop() up to compositor.wait()
+  PROF_DNS,              //Host lookup before connecting
+  PROF_HANDSHAKE,        //TCP connect and TLS handshake
+  PROF_TTFB,             //Sending request until status line read
+  PROF_FIND,             //Scanning response body for train array
+  PROF_DESERIALIZE,      //deserializeJson of one train object
+  PROF_SET_END_LED,      //setEndLED for every line
+  PROF_COMPOSITE,        //Building and rendering a frame in loop()
+  PROF_SHOW,             //strip.show() inside any render()
+  PROF_CHECK_UPDATE,     //check_for_update()
+  PROF_CHECK_SPECIAL,    //check_for_special_trains()
+  NUM_PROFILE_PHASES
+};
+
+const char* const profile_phase_names[NUM_PROFILE_PHASES] = {
+  "setup", "loop", "dns", "handshake", "ttfb", "find", "deserialize", "set_end_led", "composite", "show", "check_update", "check_special"
+};
+
+//Histogram and summary of one phase since boot
+struct PhaseHistogram {
+  uint32_t count;
+  uint64_t total_us;
+  uint32_t min_us;
+  uint32_t max_us;
+  uint32_t buckets[PROFILE_BUCKETS];
+};
+
+class LoopProfiler {
+
+  private:
+    PhaseHistogram phases[NUM_PROFILE_PHASES];
+
+  public:
+    LoopProfiler();
+
+    void reset();
+    void record(ProfilePhase phase, uint32_t us);
+
+    //Getters
+    const PhaseHistogram& getPhase(ProfilePhase phase);
+    static uint8_t bucketFor(uint32_t us); //Histogram bucket a duration falls in
+
+    //Output
+    void printReport(Print &out);
+
+};//END LoopProfiler definition
+
+//Times from construction until stop() or destruction, whichever comes first, and records into profiler.
+class ScopedTimer {
+
+  private:
+    LoopProfiler &profiler;
+    ProfilePhase phase;
+    uint32_t start;
+    bool running;
+
+  public:
+    ScopedTimer(LoopProfiler &profiler, ProfilePhase phase);
+    ~ScopedTimer();
+
+    void stop();
+
+};//END ScopedTimer definition
+
+
+// FUNCTION IMPLEMENTATION
+
+LoopProfiler::LoopProfiler(){
+  reset();
+}
+
+void LoopProfiler::reset(){
+  for(uint8_t p=0; p<NUM_PROFILE_PHASES; p++){
+    phases[p].count = 0;
+    phases[p].total_us = 0;
+    phases[p].min_us = 0xFFFFFFFF;
+    phases[p].max_us = 0;
+    for(uint8_t b=0; b<PROFILE_BUCKETS; b++){
+      phases[p].buckets[b] = 0;
+    }
+  }
+}
+
+uint8_t LoopProfiler::bucketFor(uint32_t us){
+  if(us < 2){
+    return 0;
+  }
+  uint8_t bucket = 31 - __builtin_clz(us); //floor(log2(us))
+  return (bucket < PROFILE_BUCKETS) ? bucket : PROFILE_BUCKETS - 1;
+}
+
+void LoopProfiler::record(ProfilePhase phase, uint32_t us){
+  if(phase >= NUM_PROFILE_PHASES){
+    return;
+  }
+
+  PhaseHistogram &hist = phases[phase];
+  hist.count++;
+  hist.total_us += us;
+  if(us < hist.min_us){hist.min_us = us;}
+  if(us > hist.max_us){hist.max_us = us;}
+  hist.buckets[bucketFor(us)]++;
+}
+
+const PhaseHistogram& LoopProfiler::getPhase(ProfilePhase phase){
+  return phases[phase];
+}
+
+void LoopProfiler::printReport(Print &out){
+  out.print(F("#PROFILE "));
+  out.print(PROFILE_BUCKETS);
+  out.print('\n');
+
+  for(uint8_t p=0; p<NUM_PROFILE_PHASES; p++){
+    const PhaseHistogram &hist = phases[p];
+    if(hist.count == 0){continue;}
+
+    out.print(profile_phase_names[p]);
+    out.print(F(" count="));
+    out.print(hist.count);
+    out.print(F(" total_us="));
+    out.print((unsigned long long)hist.total_us);
+    out.print(F(" min_us="));
+    out.print(hist.min_us);
+    out.print(F(" max_us="));
+    out.print(hist.max_us);
+    out.print(F(" hist="));
+
+    for(uint8_t b=0; b<PROFILE_BUCKETS; b++){
+      if(b > 0){out.print(',');}
+      out.print(hist.buckets[b]);
+    }
+    out.print('\n');
+  }
+
+  out.print(F("#END\n"));
+}
+
+ScopedTimer::ScopedTimer(LoopProfiler &profiler, ProfilePhase phase) : profiler(profiler), phase(phase), start(micros()), running(true) {}
+
+ScopedTimer::~ScopedTimer(){
+  stop();
+}
+
+void ScopedTimer::stop(){
+  if(running){
+    profiler.record(phase, micros() - start); //Unsigned subtraction handles micros() wrap
+    running = false;
+  }
+}
+
+// END FUNCTION IMPLEMENTATION
+
+
+//Instrumentation macros. Only PROFILE builds create the profiler and timers.
+#ifdef PROFILE
+  LoopProfiler loop_profiler;
+
+  #define PROFILE_CONCAT_(a, b) a##b
+  #define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+  #define PROFILE_SCOPE(phase) ScopedTimer PROFILE_CONCAT(profile_timer_, __LINE__)(loop_profiler, phase) //Time rest of enclosing block
+  #define PROFILE_START(timer, phase) ScopedTimer timer(loop_profiler, phase) //Named timer, stopped with PROFILE_STOP or end of block
+  #define PROFILE_STOP(timer) timer.stop()
+#else
+  #define PROFILE_SCOPE(phase)
+  #define PROFILE_START(timer, phase)
+  #define PROFILE_STOP(timer)
+#endif
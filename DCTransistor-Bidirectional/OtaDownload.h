@@ -0,0 +1,307 @@
+#include <Arduino.h>
+
+/*
+    Defines OtaDownload class template - a firmware image downloaded in small slices between frames, instead of
+    ESPhttpUpdate.update() holding the board for the whole download and flash write.
+
+    begin() takes the image's hash (published next to the image) and waits for the first response. Each slice
+    opens (or continues) a Range request from getOffset(); the first response's size goes to setSize(), which
+    starts the sink. receive() then writes only bytes already buffered by the client, at most max_bytes per call,
+    so a slice never waits on the network. When a connection drops or is closed for the next train feed poll,
+    interrupted() counts it and the next slice picks up at getOffset().
+
+    Once every byte is written the sink verifies the hash and the download is ready. The caller reboots at a
+    quiet moment (after the next live frame is saved for warm start). A failed download is dropped whole and
+    tried again at the next update check.
+
+    Slice durations are recorded by the caller (noteSlice) as display stall time, alongside throughput.
+
+    Sink is a template parameter with static begin / write / end / abort, so tests can use RAM. A sink whose
+    output can run ahead of its input (DeltaPatch) limits input with room(), and receive() calls pump() to write
+    the rest while room() is 0, counting it toward max_bytes. Other sinks return 0xFFFF and 0.
+    UpdaterSink writes to the update partition with the core's Updater, which checks an MD5 in end().
+*/
+
+#define OTA_HASH_LEN 65 //Longest hash kept as hex, including NUL (SHA-256)
+#define OTA_CHUNK_LEN 512 //Bytes read from client per write to sink
+
+#ifndef EPOXY_DUINO
+  //Update partition, through the core's Updater (see Updater.h). Takes an MD5 as 32 hex characters.
+  struct UpdaterSink {
+    static bool begin(uint32_t size, const char* hash){
+      return Update.begin(size) && Update.setMD5(hash);
+    }
+    static size_t write(const uint8_t* data, size_t len){
+      return Update.write((uint8_t*)data, len);
+    }
+    static bool end(){
+      return Update.end();
+    }
+    static void abort(){
+      if(Update.isRunning()){
+        Update.end(true); //Incomplete image fails its MD5, so nothing is marked for boot
+      }
+    }
+    static uint16_t room(){
+      return 0xFFFF; //Writes whatever it's given
+    }
+    static uint16_t pump(uint16_t max_bytes){
+      return 0;
+    }
+  };
+#endif
+
+enum OtaState : uint8_t {
+  OTA_IDLE,
+  OTA_STARTING, //Hash known, waiting for size from first response
+  OTA_DOWNLOADING,
+  OTA_READY, //Written and verified, waiting to reboot
+  OTA_FAILED
+};
+
+template<typename Sink>
+class OtaDownload {
+
+  private:
+    OtaState state;
+    char hash[OTA_HASH_LEN];
+    uint32_t size;
+    uint32_t offset; //Bytes written to sink so far
+    uint32_t start_ms; //millis() at begin()
+    uint32_t done_ms; //Elapsed ms when ready or failed
+
+    uint32_t slices;
+    uint32_t stall_ms_total; //Time spent in slices, i.e. frames held up
+    uint32_t stall_ms_max;
+    uint32_t resumes; //Connections that ended before image did
+    uint32_t failures;
+
+    void finish();
+
+  public:
+    OtaDownload();
+
+    bool begin(const char* image_hash); //Start a new download. False if one is already under way or hash is too long.
+    bool setSize(uint32_t image_size); //Size from first response. Starts sink.
+    uint16_t receive(Stream &in, uint16_t max_bytes); //Write up to max_bytes already available from in. Returns bytes written.
+    void interrupted(); //Connection closed before image was complete. Next slice resumes from getOffset().
+    void fail(); //Drop download (bad response, size changed, ...)
+    void noteSlice(uint32_t ms); //Time one slice took, including any connect
+
+    //Getters
+    OtaState getState();
+    bool isActive(); //Starting or downloading
+    bool needsInput(); //Active, and not every byte has been received (sink may still be writing after the last one)
+    bool isReady();
+    uint32_t getOffset();
+    uint32_t getSize();
+    uint32_t getBytesPerSec(); //Average since begin(), including time between slices
+
+    void printMetrics(Print &out);
+
+};//END OtaDownload definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<typename Sink>
+OtaDownload<Sink>::OtaDownload(){
+  state = OTA_IDLE;
+  hash[0] = '\0';
+  size = 0;
+  offset = 0;
+  start_ms = 0;
+  done_ms = 0;
+  slices = 0;
+  stall_ms_total = 0;
+  stall_ms_max = 0;
+  resumes = 0;
+  failures = 0;
+}
+
+template<typename Sink>
+bool OtaDownload<Sink>::begin(const char* image_hash){
+  if(isActive() || state == OTA_READY || strlen(image_hash) >= OTA_HASH_LEN){
+    return false;
+  }
+  strcpy(hash, image_hash); /* Flawfinder: ignore */
+  state = OTA_STARTING;
+  size = 0;
+  offset = 0;
+  start_ms = millis();
+  done_ms = 0;
+  return true;
+}
+
+template<typename Sink>
+bool OtaDownload<Sink>::setSize(uint32_t image_size){
+  if(state != OTA_STARTING){
+    return state == OTA_DOWNLOADING && image_size == size; //Resumed response must be for the same image
+  }
+  if(image_size == 0 || !Sink::begin(image_size, hash)){
+    fail();
+    return false;
+  }
+  size = image_size;
+  state = OTA_DOWNLOADING;
+  return true;
+}
+
+template<typename Sink>
+uint16_t OtaDownload<Sink>::receive(Stream &in, uint16_t max_bytes){
+  if(state != OTA_DOWNLOADING){
+    return 0;
+  }
+
+  uint8_t chunk[OTA_CHUNK_LEN];
+  uint16_t written = 0;
+  while(written < max_bytes){
+
+    //Sink still has output from earlier input to write (e.g. a delta copy), which counts toward max_bytes
+    uint16_t room = Sink::room();
+    if(room == 0){
+      uint16_t pumped = Sink::pump(max_bytes - written);
+      if(pumped == 0){
+        fail();
+        return written;
+      }
+      written += pumped;
+      continue;
+    }
+
+    if(offset >= size){
+      break;
+    }
+    int available = in.available();
+    if(available <= 0){
+      break;
+    }
+    uint32_t want = size - offset;
+    if(want > (uint32_t)(max_bytes - written)){want = max_bytes - written;}
+    if(want > (uint32_t)available){want = available;}
+    if(want > room){want = room;}
+    if(want > OTA_CHUNK_LEN){want = OTA_CHUNK_LEN;}
+
+    size_t got = in.readBytes(chunk, want);
+    if(got == 0){
+      break;
+    }
+    if(Sink::write(chunk, got) != got){
+      fail();
+      return written;
+    }
+    offset += got;
+    written += got;
+  }
+
+  if(offset == size && Sink::room() > 0){
+    finish();
+  }
+  return written;
+}
+
+template<typename Sink>
+void OtaDownload<Sink>::finish(){
+  if(Sink::end()){
+    state = OTA_READY;
+    done_ms = millis() - start_ms;
+  }
+  else{
+    state = OTA_FAILED;
+    done_ms = millis() - start_ms;
+    failures++;
+  }
+}
+
+template<typename Sink>
+void OtaDownload<Sink>::interrupted(){
+  if(isActive()){
+    resumes++;
+  }
+}
+
+template<typename Sink>
+void OtaDownload<Sink>::fail(){
+  if(!isActive()){
+    return;
+  }
+  if(state == OTA_DOWNLOADING){
+    Sink::abort();
+  }
+  state = OTA_FAILED;
+  done_ms = millis() - start_ms;
+  failures++;
+}
+
+template<typename Sink>
+void OtaDownload<Sink>::noteSlice(uint32_t ms){
+  slices++;
+  stall_ms_total += ms;
+  if(ms > stall_ms_max){
+    stall_ms_max = ms;
+  }
+}
+
+template<typename Sink>
+OtaState OtaDownload<Sink>::getState(){
+  return state;
+}
+
+template<typename Sink>
+bool OtaDownload<Sink>::isActive(){
+  return state == OTA_STARTING || state == OTA_DOWNLOADING;
+}
+
+template<typename Sink>
+bool OtaDownload<Sink>::needsInput(){
+  return state == OTA_STARTING || (state == OTA_DOWNLOADING && offset < size);
+}
+
+template<typename Sink>
+bool OtaDownload<Sink>::isReady(){
+  return state == OTA_READY;
+}
+
+template<typename Sink>
+uint32_t OtaDownload<Sink>::getOffset(){
+  return offset;
+}
+
+template<typename Sink>
+uint32_t OtaDownload<Sink>::getSize(){
+  return size;
+}
+
+template<typename Sink>
+uint32_t OtaDownload<Sink>::getBytesPerSec(){
+  if(state == OTA_IDLE){
+    return 0;
+  }
+  uint32_t elapsed = isActive() ? millis() - start_ms : done_ms;
+  return (elapsed == 0) ? 0 : (uint32_t)(((uint64_t)offset * 1000) / elapsed);
+}
+
+template<typename Sink>
+void OtaDownload<Sink>::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_ota_state gauge\ndctransistor_ota_state "));
+  out.print(state);
+  out.print(F("\n# TYPE dctransistor_ota_bytes gauge\ndctransistor_ota_bytes "));
+  out.print(offset);
+  out.print(F("\n# TYPE dctransistor_ota_size_bytes gauge\ndctransistor_ota_size_bytes "));
+  out.print(size);
+  out.print(F("\n# TYPE dctransistor_ota_throughput_bytes_per_sec gauge\ndctransistor_ota_throughput_bytes_per_sec "));
+  out.print(getBytesPerSec());
+  out.print(F("\n# TYPE dctransistor_ota_slices_total counter\ndctransistor_ota_slices_total "));
+  out.print(slices);
+  out.print(F("\n# TYPE dctransistor_ota_stall_ms_total counter\ndctransistor_ota_stall_ms_total "));
+  out.print(stall_ms_total);
+  out.print(F("\n# TYPE dctransistor_ota_stall_max_ms gauge\ndctransistor_ota_stall_max_ms "));
+  out.print(stall_ms_max);
+  out.print(F("\n# TYPE dctransistor_ota_resumes_total counter\ndctransistor_ota_resumes_total "));
+  out.print(resumes);
+  out.print(F("\n# TYPE dctransistor_ota_failures_total counter\ndctransistor_ota_failures_total "));
+  out.print(failures);
+  out.print('\n');
+}
+
+// END FUNCTION IMPLEMENTATION
@@ -0,0 +1,219 @@
+#include <Arduino.h>
+
+/*
+    Defines TlsPins class template - a small set of pinned certificate fingerprints per host, so a certificate
+    rotation doesn't mean setInsecure() and a second handshake on every connection.
+
+    Each host has up to TLS_PINS_PER_HOST SHA-1 fingerprints (config.h): the current one, the ones it replaced,
+    and any known upcoming one added by hand. The update-fingerprints workflow puts a newly seen fingerprint first
+    and drops the oldest. connect() tries the pin that matched last time first, so a board makes one handshake per
+    connection. Only when a host's certificate has changed does one connection try the other pins (a mismatch fails
+    at the server's certificate, before any key exchange), and the pin that matches is tried first from then on.
+
+    Hosts added with allow_insecure (the update host) fall back to no certificate check only when no pin matches, so
+    a board that missed several rotations can still download the firmware with current pins.
+
+    Client is a template parameter of connect() (setFingerprint / connect / getLastSSLError / setInsecure), so tests
+    can stand in for WiFiClientSecure. Pins are in flash; each host keeps its counters for the metrics endpoint.
+*/
+
+#define TLS_FINGERPRINT_LEN 20 //SHA-1
+#define TLS_PINS_PER_HOST 3 //Keep in sync with update-fingerprints workflow
+#define TLS_PIN_MISMATCH 62 //BR_ERR_X509_NOT_TRUSTED: certificate didn't match fingerprint
+
+enum TlsConnectResult : uint8_t {
+  TLS_CONNECTED,
+  TLS_CONNECT_FAILED, //Network, DNS or handshake error other than a pin mismatch
+  TLS_NO_PIN_MATCHED,
+  TLS_UNKNOWN_HOST //No pins for host
+};
+
+//Parse the nth fingerprint from a (flash) list of hex bytes. Separators between bytes and pins are ignored
+//("AA BB ..., CC:DD ..."). Returns false if the list has fewer than n+1 whole fingerprints.
+bool parseTlsPin(PGM_P pins, uint8_t n, uint8_t* fingerprint){
+  uint16_t skip = (uint16_t)n * TLS_FINGERPRINT_LEN;
+  uint8_t got = 0;
+  int8_t high = -1;
+  char c;
+  for(uint16_t i=0; got < TLS_FINGERPRINT_LEN && (c = pgm_read_byte(pins + i)) != '\0'; i++){
+    int8_t digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+    if(digit < 0){
+      high = -1; //Separator
+      continue;
+    }
+    if(high < 0){
+      high = digit;
+      continue;
+    }
+    if(skip > 0){
+      skip--;
+    }
+    else{
+      fingerprint[got++] = (uint8_t)((high << 4) | digit);
+    }
+    high = -1;
+  }
+  return got == TLS_FINGERPRINT_LEN;
+}
+
+template<uint8_t N>
+class TlsPins {
+
+  private:
+    struct Host {
+      const char* name;
+      PGM_P pins;
+      uint8_t num_pins;
+      uint8_t preferred; //Pin that matched last
+      bool allow_insecure;
+      uint32_t pin_misses; //Handshakes that failed on a stale pin before another one matched
+      uint32_t no_match; //Connections where no pin matched
+      uint32_t insecure; //Connections made without a certificate check
+    };
+    Host hosts[N];
+    uint8_t num_hosts;
+
+    Host* find(const char* host);
+
+  public:
+    TlsPins();
+
+    bool add(const char* host, PGM_P pins, bool allow_insecure = false); //False if full, or pins has no whole fingerprint
+    template<typename Client> TlsConnectResult connect(Client &client, const char* host, uint16_t port);
+
+    //Getters
+    uint8_t getNumPins(const char* host);
+    uint8_t getPreferred(const char* host);
+    uint32_t getPinMisses(const char* host);
+
+    void printMetrics(Print &out);
+
+};//END TlsPins definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<uint8_t N>
+TlsPins<N>::TlsPins(){
+  num_hosts = 0;
+}
+
+template<uint8_t N>
+bool TlsPins<N>::add(const char* host, PGM_P pins, bool allow_insecure){
+  if(num_hosts >= N){
+    return false;
+  }
+  uint8_t fingerprint[TLS_FINGERPRINT_LEN];
+  uint8_t num_pins = 0;
+  while(num_pins < TLS_PINS_PER_HOST && parseTlsPin(pins, num_pins, fingerprint)){
+    num_pins++;
+  }
+  if(num_pins == 0){
+    return false;
+  }
+  hosts[num_hosts] = {host, pins, num_pins, 0, allow_insecure, 0, 0, 0};
+  num_hosts++;
+  return true;
+}
+
+template<uint8_t N>
+typename TlsPins<N>::Host* TlsPins<N>::find(const char* host){
+  for(uint8_t i=0; i<num_hosts; i++){
+    if(strcmp(hosts[i].name, host) == 0){
+      return &hosts[i];
+    }
+  }
+  return NULL;
+}
+
+template<uint8_t N>
+template<typename Client>
+TlsConnectResult TlsPins<N>::connect(Client &client, const char* host, uint16_t port){
+  Host* h = find(host);
+  if(h == NULL){
+    return TLS_UNKNOWN_HOST;
+  }
+
+  uint8_t fingerprint[TLS_FINGERPRINT_LEN];
+  for(uint8_t tried=0; tried<h->num_pins; tried++){
+    uint8_t pin = (h->preferred + tried) % h->num_pins;
+    parseTlsPin(h->pins, pin, fingerprint);
+    client.setFingerprint(fingerprint);
+    if(client.connect(host, port)){
+      h->pin_misses += tried;
+      h->preferred = pin;
+      return TLS_CONNECTED;
+    }
+    if(client.getLastSSLError() != TLS_PIN_MISMATCH){
+      h->pin_misses += tried;
+      return TLS_CONNECT_FAILED; //Other pins wouldn't help
+    }
+  }
+  h->pin_misses += h->num_pins;
+  h->no_match++;
+
+  if(h->allow_insecure){
+    client.setInsecure();
+    if(client.connect(host, port)){
+      h->insecure++;
+      return TLS_CONNECTED;
+    }
+  }
+  return TLS_NO_PIN_MATCHED;
+}
+
+template<uint8_t N>
+uint8_t TlsPins<N>::getNumPins(const char* host){
+  Host* h = find(host);
+  return (h == NULL) ? 0 : h->num_pins;
+}
+
+template<uint8_t N>
+uint8_t TlsPins<N>::getPreferred(const char* host){
+  Host* h = find(host);
+  return (h == NULL) ? 0 : h->preferred;
+}
+
+template<uint8_t N>
+uint32_t TlsPins<N>::getPinMisses(const char* host){
+  Host* h = find(host);
+  return (h == NULL) ? 0 : h->pin_misses;
+}
+
+template<uint8_t N>
+void TlsPins<N>::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_tls_pin_misses_total counter\n"));
+  for(uint8_t i=0; i<num_hosts; i++){
+    out.print(F("dctransistor_tls_pin_misses_total{host=\""));
+    out.print(hosts[i].name);
+    out.print(F("\"} "));
+    out.print(hosts[i].pin_misses);
+    out.print('\n');
+  }
+  out.print(F("# TYPE dctransistor_tls_pin_no_match_total counter\n"));
+  for(uint8_t i=0; i<num_hosts; i++){
+    out.print(F("dctransistor_tls_pin_no_match_total{host=\""));
+    out.print(hosts[i].name);
+    out.print(F("\"} "));
+    out.print(hosts[i].no_match);
+    out.print('\n');
+  }
+  out.print(F("# TYPE dctransistor_tls_insecure_connects_total counter\n"));
+  for(uint8_t i=0; i<num_hosts; i++){
+    out.print(F("dctransistor_tls_insecure_connects_total{host=\""));
+    out.print(hosts[i].name);
+    out.print(F("\"} "));
+    out.print(hosts[i].insecure);
+    out.print('\n');
+  }
+  out.print(F("# TYPE dctransistor_tls_pin_index gauge\n"));
+  for(uint8_t i=0; i<num_hosts; i++){
+    out.print(F("dctransistor_tls_pin_index{host=\""));
+    out.print(hosts[i].name);
+    out.print(F("\"} "));
+    out.print(hosts[i].preferred);
+    out.print('\n');
+  }
+}
+
+// END FUNCTION IMPLEMENTATION
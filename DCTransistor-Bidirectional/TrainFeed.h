@@ -0,0 +1,119 @@
+#include <ArduinoJson.h>
+
+/*
+    Parses a train position response from the GIS TRAIN_LOC endpoint and sets each TrainLine's state from it.
+
+    The body is read straight off the stream one train object ("feature") at a time, so only one train is ever held in the
+    JSON document no matter how many are running. With a StaticJsonDocument (json_arena in auto_update.h) a full parse
+    makes no heap allocations.
+
+    Debug output goes to the binary log (BinaryLog.h), not Serial, so parsing takes as long in debug builds as in production.
+
+    Shared by both boards.
+*/
+
+//Summary of one parsed response
+struct TrainFeedResult {
+  bool ok; //false if train array missing or any train failed to parse
+  uint8_t unmatched; //trains on a line that no TrainLine matched
+  uint8_t specials_seen; //special trains seen (where each is goes into the SpecialTrains passed in)
+  uint64_t newest_ms; //newest ETIME of any train, in epoch milliseconds (0 if none had one)
+};
+
+//ETIME is epoch time. Values too large to be seconds are taken as already in milliseconds.
+inline uint64_t etimeToMs(double etime){
+  if(etime <= 0){return 0;}
+  return (etime < 100000000000.0) ? (uint64_t)(etime * 1000) : (uint64_t)etime;
+}
+
+//Parse every train in stream into lines, and record where each of specials is. doc is reused for each train;
+//filter selects TRKID, TRACKLINE, TRIP_DIRECTION, ETIME (and ITT when there are special trains).
+//If given, first_train is called once after the first train object is parsed (e.g. to sample heap mid-parse).
+template<typename Line, typename Specials>
+TrainFeedResult parseTrainFeed(Stream &stream, JsonDocument &doc, JsonDocument &filter, Line* const lines[], uint8_t num_lines, Specials &specials, void (*first_train)() = NULL){
+
+  TrainFeedResult result = {true, 0, 0, 0};
+  specials.clearSightings();
+
+  //Skip to array of train objects. If can't find, create error.
+  PROFILE_START(find_timer, PROF_FIND);
+  if(!stream.find((char*)"\"features\":[")){     // VERSION 1.0: find("\"TrainPositions\":[")
+    LOG_ERROR(EV_FEED_NOT_FOUND);
+    result.ok = false;
+    return result;
+  }
+  PROFILE_STOP(find_timer);
+
+  do {
+
+    PROFILE_START(deserialize_timer, PROF_DESERIALIZE);
+    DeserializationError error = deserializeJson(doc, stream, DeserializationOption::Filter(filter));
+    PROFILE_STOP(deserialize_timer);
+
+    if(first_train != NULL){
+      first_train();
+      first_train = NULL;
+    }
+
+    //Track newest upstream position time for freshness metric. Empty after an error, so reads as 0.
+    uint64_t position_ms = etimeToMs(doc["attributes"]["ETIME"].as<double>());
+    if(position_ms > result.newest_ms){
+      result.newest_ms = position_ms;
+    }
+
+    if (error) {
+      result.ok = false;
+
+      LOG_ERROR(EV_DESERIALIZE_FAILED, error.code(), doc.size(), doc.capacity(), doc.overflowed());
+    }
+
+    //Only work on trains that are on a line. JsonObject removes key if value is null.
+    else if(doc["attributes"]["TRACKLINE"]){ // VERSION 1.0: Check  doc["LineCode"]
+
+      //Isolate variables from JsonObject returned by API
+      const char* trkID = doc["attributes"]["TRKID"].as<const char*>();
+      const uint8_t train_dir = doc["attributes"]["TRIP_DIRECTION"].as<unsigned short>();
+      const char* train_line = doc["attributes"]["TRACKLINE"].as<const char*>();
+
+      int16_t trainID = -1;
+      if (specials.getCount() > 0){
+        trainID = doc["attributes"]["ITT"].as<int16_t>();
+      }
+
+      int res = -1; //store result of setting each train
+      int8_t line_idx = -1; //store which TrainLine object has current line
+
+      // Find the line the train is on by color, and update that line with the train.
+      for (uint8_t i=0; i<num_lines; i++){
+        if (strcmp(lines[i]->getColor(), train_line) == 0){
+          line_idx = i;
+          res = lines[i]->setTrainStateByCode(trkID, train_dir-1);
+          break;
+        }
+      }
+
+      //If current line not set among all lines, update failure count
+      if (line_idx == -1){
+        result.unmatched++;
+        LOG_WARN(EV_TRAIN_UNMATCHED, train_dir, train_line[0]);
+      }
+
+      LOG_DEBUG(EV_TRAIN, line_idx, train_dir, res, trainID);
+
+      // Check for special trains, by ITT. Only counts if it's at a station on the board.
+      int8_t special = (trainID == -1) ? -1 : specials.find(trainID);
+      if(special != -1 && line_idx != -1 && res >= 0){
+        specials.sight(special, line_idx, res, train_dir-1);
+        result.specials_seen++;
+        LOG_INFO(EV_SPECIAL_TRAIN, line_idx, res, train_dir-1, trainID);
+      }
+
+    }//end if train is on a line
+
+    doc.clear();
+    YIELD_POINT(); //Keep WiFi stack and soft watchdog fed through long train arrays
+
+  } while (stream.findUntil((char*)",", (char*)"]")); //Iterate through end of Json Array.
+
+  return result;
+}
@@ -0,0 +1,133 @@
+#include <Arduino.h>
+
+/*
+    Defines WallClock class - today's date without a request of its own.
+
+    The main train feed already carries WMATA's clock: every train has an ETIME, and parseTrainFeed keeps the newest
+    one. Each live loop hands it to setFromFeed(), and epochMs() advances the last one by millis() since it arrived.
+    Before the first good feed, epochMs() falls back to SNTP, then to the Date header of any HTTP response passed to
+    setFromHttpDate().
+
+    Accurate to seconds (feed time trails the real clock by however old the newest position is), which is plenty to
+    pick a special train campaign by date.
+*/
+
+enum ClockSource : uint8_t {
+  CLOCK_NONE,
+  CLOCK_FEED, //Newest ETIME from train feed
+  CLOCK_SNTP,
+  CLOCK_HTTP_DATE //Date header of a response
+};
+
+//Days from 1970-01-01 to year-month-day (proleptic Gregorian). From Howard Hinnant's days_from_civil.
+int32_t daysFromCivil(int16_t y, uint8_t m, uint8_t d){
+  y -= m <= 2;
+  const int16_t era = (y >= 0 ? y : y - 399) / 400;
+  const uint16_t yoe = (uint16_t)(y - era * 400);
+  const uint16_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const uint32_t doe = (uint32_t)yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return (int32_t)era * 146097 + (int32_t)doe - 719468;
+}
+
+//Parse an RFC 7231 IMF-fixdate ("Sun, 06 Nov 1994 08:49:37 GMT") to epoch seconds. Returns 0 if malformed.
+time_t parseHttpDate(const char* date){
+  static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  char month[4] = {0}; /* Flawfinder: ignore */
+  unsigned int day, year, hour, minute, second;
+
+  const char* comma = strchr(date, ',');
+  if(comma == NULL || sscanf(comma + 1, " %u %3s %u %u:%u:%u", &day, month, &year, &hour, &minute, &second) != 6){
+    return 0;
+  }
+
+  const char* found = strstr(months, month);
+  if(strlen(month) != 3 || found == NULL || (found - months) % 3 != 0){
+    return 0;
+  }
+  uint8_t m = (found - months) / 3 + 1;
+  if(day < 1 || day > 31 || year < 1970 || hour > 23 || minute > 59 || second > 60){
+    return 0;
+  }
+
+  return (time_t)daysFromCivil(year, m, day) * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+class WallClock {
+
+  private:
+    uint64_t feed_ms; //Newest ETIME harvested, epoch ms
+    uint32_t feed_at; //millis() when harvested
+    uint64_t date_ms; //Last Date header, epoch ms
+    uint32_t date_at;
+    ClockSource last_source; //Source of last epochMs() result
+
+  public:
+    WallClock();
+
+    void setFromFeed(uint64_t newest_ms); //Newest ETIME of a parsed feed, in epoch ms. Ignored if 0.
+    bool setFromHttpDate(const char* date); //Date header value. Returns false if it didn't parse.
+
+    uint64_t epochMs(uint64_t sntp_ms); //Current epoch ms from best source (sntp_ms is 0 if SNTP hasn't synced), or 0 if none
+    ClockSource getSource();
+
+    void printMetrics(Print &out);
+
+};//END WallClock definition
+
+
+// FUNCTION IMPLEMENTATION
+
+WallClock::WallClock(){
+  feed_ms = 0;
+  feed_at = 0;
+  date_ms = 0;
+  date_at = 0;
+  last_source = CLOCK_NONE;
+}
+
+void WallClock::setFromFeed(uint64_t newest_ms){
+  if(newest_ms == 0){
+    return;
+  }
+  feed_ms = newest_ms;
+  feed_at = millis();
+}
+
+bool WallClock::setFromHttpDate(const char* date){
+  time_t seconds = parseHttpDate(date);
+  if(seconds == 0){
+    return false;
+  }
+  date_ms = (uint64_t)seconds * 1000;
+  date_at = millis();
+  return true;
+}
+
+uint64_t WallClock::epochMs(uint64_t sntp_ms){
+  if(feed_ms != 0){
+    last_source = CLOCK_FEED;
+    return feed_ms + (uint32_t)(millis() - feed_at);
+  }
+  if(sntp_ms != 0){
+    last_source = CLOCK_SNTP;
+    return sntp_ms;
+  }
+  if(date_ms != 0){
+    last_source = CLOCK_HTTP_DATE;
+    return date_ms + (uint32_t)(millis() - date_at);
+  }
+  last_source = CLOCK_NONE;
+  return 0;
+}
+
+ClockSource WallClock::getSource(){
+  return last_source;
+}
+
+void WallClock::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_clock_source gauge\ndctransistor_clock_source "));
+  out.print(last_source);
+  out.print('\n');
+}
+
+// END FUNCTION IMPLEMENTATION
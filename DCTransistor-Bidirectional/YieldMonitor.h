@@ -0,0 +1,169 @@
+#include <Arduino.h>
+
+/*
+    Defines YieldMonitor class - cooperative yield points that also measure the longest stretch of code that ran
+    without yielding, per phase (ProfilePhase, LoopProfiler.h).
+
+    Long stretches without yield() starve the WiFi stack and, past ~3 seconds, trip the soft watchdog. The train
+    parse loop and the fallback display both loop over every train or line, so they call YIELD_POINT() each pass.
+    Code that yields some other way (delay(), returning from loop()) calls markYield() so the gap restarts.
+    Library calls that yield internally (TLS handshake, stream reads) are invisible here, so gaps spanning them
+    are an upper bound on the real time between yields.
+
+    Each gap is charged to the phase current when it ends. Gaps longer than the budget (setBudget()) are counted,
+    and passed to an optional handler. With YIELD_BUDGET_ASSERT defined (host tests only), the default handler prints
+    the phase and gap and aborts, so any code path over budget fails the test run.
+*/
+
+#ifndef DEFAULT_YIELD_BUDGET_US
+  #define DEFAULT_YIELD_BUDGET_US 50000 //Budget until setBudget() is called. Define before including to change it in tests.
+#endif
+
+class YieldMonitor {
+
+  private:
+    uint32_t last_yield; //micros() of last yield
+    uint8_t phase;
+    uint32_t budget_us;
+    void (*on_exceeded)(uint8_t phase, uint32_t gap_us);
+
+    uint32_t max_gap[NUM_PROFILE_PHASES]; //Longest gap ending in each phase since boot
+    uint32_t over_budget[NUM_PROFILE_PHASES]; //Gaps over budget ending in each phase
+
+    void endGap();
+
+  public:
+    YieldMonitor();
+
+    void reset(); //Clear stats and start a new gap now
+    void setBudget(uint32_t us, void (*handler)(uint8_t phase, uint32_t gap_us) = NULL);
+    void setPhase(uint8_t new_phase);
+
+    void yieldPoint(); //Measure gap, then yield()
+    void markYield(); //Measure gap for a yield that already happened (delay(), end of loop())
+
+    //Getters
+    uint32_t getMaxGap(uint8_t phase);
+    uint32_t getOverBudget(uint8_t phase);
+    uint32_t getMaxGapAll(); //Longest gap in any phase
+
+    void printMetrics(Print &out);
+
+};//END YieldMonitor definition
+
+
+// FUNCTION IMPLEMENTATION
+
+#ifdef YIELD_BUDGET_ASSERT
+  //Host emulator only - fail loudly so the test run fails
+  void yieldBudgetAbort(uint8_t phase, uint32_t gap_us){
+    Serial.print(F("Yield budget exceeded in phase "));
+    Serial.print(profile_phase_names[phase]);
+    Serial.print(F(": "));
+    Serial.print(gap_us);
+    Serial.println(F(" us"));
+    abort();
+  }
+#endif
+
+YieldMonitor::YieldMonitor(){
+  budget_us = DEFAULT_YIELD_BUDGET_US;
+  #ifdef YIELD_BUDGET_ASSERT
+    on_exceeded = yieldBudgetAbort;
+  #else
+    on_exceeded = NULL;
+  #endif
+  reset();
+}
+
+void YieldMonitor::reset(){
+  last_yield = micros();
+  phase = PROF_SETUP;
+  for(uint8_t p=0; p<NUM_PROFILE_PHASES; p++){
+    max_gap[p] = 0;
+    over_budget[p] = 0;
+  }
+}
+
+void YieldMonitor::setBudget(uint32_t us, void (*handler)(uint8_t phase, uint32_t gap_us)){
+  budget_us = us;
+  if(handler != NULL){
+    on_exceeded = handler;
+  }
+}
+
+void YieldMonitor::setPhase(uint8_t new_phase){
+  if(new_phase < NUM_PROFILE_PHASES){
+    phase = new_phase;
+  }
+}
+
+void YieldMonitor::endGap(){
+  uint32_t now = micros();
+  uint32_t gap = now - last_yield;
+  if(gap > max_gap[phase]){
+    max_gap[phase] = gap;
+  }
+  if(gap > budget_us){
+    over_budget[phase]++;
+    if(on_exceeded != NULL){
+      on_exceeded(phase, gap);
+    }
+  }
+}
+
+void YieldMonitor::yieldPoint(){
+  endGap();
+  yield();
+  last_yield = micros();
+}
+
+void YieldMonitor::markYield(){
+  endGap();
+  last_yield = micros();
+}
+
+uint32_t YieldMonitor::getMaxGap(uint8_t p){
+  return max_gap[p];
+}
+
+uint32_t YieldMonitor::getOverBudget(uint8_t p){
+  return over_budget[p];
+}
+
+uint32_t YieldMonitor::getMaxGapAll(){
+  uint32_t longest = 0;
+  for(uint8_t p=0; p<NUM_PROFILE_PHASES; p++){
+    if(max_gap[p] > longest){longest = max_gap[p];}
+  }
+  return longest;
+}
+
+void YieldMonitor::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_yield_gap_max_us gauge\n"));
+  for(uint8_t p=0; p<NUM_PROFILE_PHASES; p++){
+    if(max_gap[p] == 0){continue;}
+    out.print(F("dctransistor_yield_gap_max_us{phase=\""));
+    out.print(profile_phase_names[p]);
+    out.print(F("\"} "));
+    out.print(max_gap[p]);
+    out.print('\n');
+  }
+
+  out.print(F("# TYPE dctransistor_yield_over_budget_total counter\n"));
+  for(uint8_t p=0; p<NUM_PROFILE_PHASES; p++){
+    if(over_budget[p] == 0){continue;}
+    out.print(F("dctransistor_yield_over_budget_total{phase=\""));
+    out.print(profile_phase_names[p]);
+    out.print(F("\"} "));
+    out.print(over_budget[p]);
+    out.print('\n');
+  }
+}
+
+// END FUNCTION IMPLEMENTATION
+
+
+YieldMonitor yield_monitor;
+
+#define YIELD_POINT() yield_monitor.yieldPoint()
@@ -0,0 +1,150 @@
+#include <Arduino.h>
+
+/*
+    Defines BitSet class template - fixed-width set of N bits stored in 32-bit words.
+
+    Replaces the single uint64_t each TrainLine used for state (which capped a line at 64 stations and needed
+    "uint64_t one = 1" before every shift to avoid overflowing on the Silver line). Every operation works a word
+    at a time, so for N <= 32 it compiles down to the same single-register ops as a plain integer.
+
+    Also used for board-wide LED masks in the Compositor, where N is the number of LEDs.
+*/
+
+template<uint16_t N>
+class BitSet {
+
+  public:
+    static const uint16_t NUM_WORDS = (N + 31) / 32;
+
+  private:
+    uint32_t words[NUM_WORDS];
+
+    //Bits in last word that are part of the set. Keeps shifts from pushing bits past N.
+    static uint32_t lastWordMask(){
+      return (N % 32 == 0) ? 0xFFFFFFFF : ((uint32_t)1 << (N % 32)) - 1;
+    }
+
+  public:
+
+    BitSet(){
+      clear();
+    }
+
+    void clear(){
+      for(uint16_t w=0; w<NUM_WORDS; w++){words[w] = 0;}
+    }
+
+    void set(uint16_t i){
+      if(i < N){words[i >> 5] |= (uint32_t)1 << (i & 31);}
+    }
+
+    void reset(uint16_t i){
+      if(i < N){words[i >> 5] &= ~((uint32_t)1 << (i & 31));}
+    }
+
+    bool isSet(uint16_t i) const {
+      return (i < N) && (words[i >> 5] & ((uint32_t)1 << (i & 31)));
+    }
+
+    bool any() const {
+      for(uint16_t w=0; w<NUM_WORDS; w++){
+        if(words[w]){return true;}
+      }
+      return false;
+    }
+
+    //Raw 32-bit words, for saving a set and restoring it later
+    uint32_t getWord(uint16_t w) const {
+      return (w < NUM_WORDS) ? words[w] : 0;
+    }
+
+    void setWord(uint16_t w, uint32_t value){
+      if(w < NUM_WORDS){words[w] = (w == NUM_WORDS - 1) ? (value & lastWordMask()) : value;}
+    }
+
+    //Number of set bits
+    uint16_t count() const {
+      uint16_t total = 0;
+      for(uint16_t w=0; w<NUM_WORDS; w++){total += __builtin_popcount(words[w]);}
+      return total;
+    }
+
+    //Move every bit up one index (bit i -> bit i+1). Bit 0 becomes 0 and bit N-1 is dropped.
+    void shiftUp(){
+      for(int16_t w=NUM_WORDS-1; w>0; w--){
+        words[w] = (words[w] << 1) | (words[w-1] >> 31);
+      }
+      words[0] <<= 1;
+      words[NUM_WORDS-1] &= lastWordMask();
+    }
+
+    //Index of lowest set bit, or -1 if none
+    int16_t findFirst() const {
+      return findFrom(0);
+    }
+
+    //Index of lowest set bit after i, or -1 if none
+    int16_t findNext(uint16_t i) const {
+      return findFrom(i + 1);
+    }
+
+    //Index of lowest set bit at or after i, or -1 if none
+    int16_t findFrom(uint16_t i) const {
+      if(i >= N){return -1;}
+
+      uint16_t w = i >> 5;
+      uint32_t word = words[w] & (0xFFFFFFFF << (i & 31));
+      while(true){
+        if(word){
+          return (w << 5) + __builtin_ctz(word);
+        }
+        if(++w >= NUM_WORDS){
+          return -1;
+        }
+        word = words[w];
+      }
+    }
+
+    //For each set bit i below count, set bit map[i] in out. Turns a line's station state into board-wide LED bits.
+    //map may be in flash (PROGMEM) or DRAM.
+    template<uint16_t M>
+    void scatter(const uint8_t* map, uint8_t count, BitSet<M> &out) const {
+      for(int16_t i=findFirst(); i != -1 && i < count; i=findNext(i)){
+        out.set(pgm_read_byte(map + i));
+      }
+    }
+
+    BitSet& operator|=(const BitSet &other){
+      for(uint16_t w=0; w<NUM_WORDS; w++){words[w] |= other.words[w];}
+      return *this;
+    }
+
+    BitSet& operator&=(const BitSet &other){
+      for(uint16_t w=0; w<NUM_WORDS; w++){words[w] &= other.words[w];}
+      return *this;
+    }
+
+    BitSet operator&(const BitSet &other) const {
+      BitSet out = *this;
+      out &= other;
+      return out;
+    }
+
+    BitSet operator|(const BitSet &other) const {
+      BitSet out = *this;
+      out |= other;
+      return out;
+    }
+
+    bool operator==(const BitSet &other) const {
+      for(uint16_t w=0; w<NUM_WORDS; w++){
+        if(words[w] != other.words[w]){return false;}
+      }
+      return true;
+    }
+
+    bool operator!=(const BitSet &other) const {
+      return !(*this == other);
+    }
+
+};//END BitSet definition
@@ -0,0 +1,71 @@
+#include <Arduino.h>
+
+/*
+    Color math used by the Compositor when flattening layers into the strip.
+
+    ColorLUT builds a 256-entry gamma + brightness table for one color channel at compile time.
+    Colors are kept at full 8-bit resolution in every layer and only scaled once, on the way to the strip,
+    so fades and crossfades keep their gradients instead of being rounded away by strip.setBrightness().
+
+    blendColor is a fixed-point crossfade between two 0x00RRGGBB colors. Red and blue are blended together
+    in one 32-bit multiply, green in a second, so it costs two multiplies per pixel.
+*/
+
+//Natural log for building tables at compile time. Reduces x to [0.5, 1) then uses atanh series.
+constexpr double lutLn(double x){
+  int e = 0;
+  while(x >= 1.0){x /= 2.0; e++;}
+  while(x < 0.5){x *= 2.0; e--;}
+
+  double y = (x - 1.0) / (x + 1.0);
+  double y2 = y * y;
+  double term = y;
+  double sum = 0;
+  for(int k=1; k<40; k+=2){
+    sum += term / k;
+    term *= y2;
+  }
+  return (2.0 * sum) + (e * 0.69314718055994530942);
+}
+
+//e^z for building tables at compile time. Halves z until small, uses Taylor series, then squares back up.
+constexpr double lutExp(double z){
+  int k = 0;
+  while(z < -0.5 || z > 0.5){z /= 2.0; k++;}
+
+  double sum = 1.0;
+  double term = 1.0;
+  for(int n=1; n<20; n++){
+    term *= z / n;
+    sum += term;
+  }
+  while(k-- > 0){sum *= sum;}
+  return sum;
+}
+
+//Gamma + brightness table for one channel. Gamma given in tenths (22 = 2.2, 10 = linear).
+//Brightness matches Adafruit_NeoPixel::setBrightness() scaling, so a linear table reproduces the old output exactly.
+template<uint8_t GAMMA_X10, uint8_t BRIGHTNESS>
+struct ColorLUT {
+  uint8_t table[256];
+
+  constexpr ColorLUT() : table() {
+    for(int i=0; i<256; i++){
+      double corrected = (i == 0) ? 0.0 : 255.0 * lutExp(lutLn(i / 255.0) * GAMMA_X10 / 10.0);
+      uint16_t gamma_val = (uint16_t)(corrected + 0.5);
+      table[i] = (uint8_t)((gamma_val * (BRIGHTNESS + 1)) >> 8);
+    }
+  }
+
+  uint8_t operator[](uint8_t i) const {
+    return table[i];
+  }
+};
+
+//Crossfade from color a to color b. t is 0 (all a) to 256 (all b).
+inline uint32_t blendColor(uint32_t a, uint32_t b, uint16_t t){
+  uint32_t inv = 256 - t;
+  uint32_t rb = (((a & 0x00FF00FF) * inv) + ((b & 0x00FF00FF) * t)) >> 8;
+  uint32_t g = (((a & 0x0000FF00) * inv) + ((b & 0x0000FF00) * t)) >> 8;
+  return (rb & 0x00FF00FF) | (g & 0x0000FF00);
+}
@@ -0,0 +1,369 @@
+#include <Arduino.h>
+
+/*
+    Defines DeltaPatch class template - applies a binary delta between two firmware images while it downloads,
+    reading the running image and writing the new one, so a release that changes a few bytes (version bump,
+    fingerprint refresh) downloads a few KB instead of the whole ~360 KB image.
+
+    Deltas are made by misc_files/make_delta.py. Format (little-endian):
+      header:  "DCDL", format (1), base size (4), base MD5 (16), target size (4), target MD5 (16)
+      ops:     op (1) then LEB128 varint
+        COPY n      n bytes of base from source position (source moves on n)
+        REPLACE n   n new bytes follow (source moves on n, e.g. a changed address)
+        INSERT n    n new bytes follow (source stays)
+        SEEK d      source moves by d (zigzag, may be negative)
+    The delta ends when target size bytes are written. The running image must match the base size and MD5 in
+    the header, and the target MD5 from the header is checked by Out once every byte is written.
+
+    Used as the sink of OtaDownload. With patching off (setPatching) bytes pass straight to Out, for a full image.
+    A COPY turns a few delta bytes into up to a whole image, so it's done in pieces by pump(), at most max_bytes
+    per call. room() is 0 while a copy is pending, which keeps each slice between frames short.
+
+    Base has static size / read / hasMd5 for the source image; RunningImage reads the sketch from flash.
+    Out is any OtaDownload sink (UpdaterSink on the board). All state is static, like the sinks.
+*/
+
+#define DELTA_FORMAT 1 //Bump when ops or header change (and in make_delta.py)
+#define DELTA_HEADER_LEN 45
+#define DELTA_COPY_LEN 256 //Bytes of base read per flash read during a copy
+
+enum DeltaOp : uint8_t {
+  DELTA_COPY = 1,
+  DELTA_REPLACE,
+  DELTA_INSERT,
+  DELTA_SEEK
+};
+
+#ifndef EPOXY_DUINO
+  //Sketch running now, from start of flash (same bytes as the .bin it was flashed from)
+  struct RunningImage {
+    static uint32_t size(){
+      return ESP.getSketchSize();
+    }
+    static bool read(uint32_t offset, uint8_t* data, size_t len){
+      return ESP.flashRead(offset, data, len);
+    }
+    static bool hasMd5(const char* md5){
+      return strcasecmp(ESP.getSketchMD5().c_str(), md5) == 0; //Computed once by the core, then cached
+    }
+  };
+#endif
+
+//16-byte binary MD5 to 32 hex characters and NUL
+void md5ToHex(const uint8_t* md5, char* hex){
+  static const char digits[] = "0123456789abcdef";
+  for(uint8_t i=0; i<16; i++){
+    hex[2*i] = digits[md5[i] >> 4];
+    hex[2*i + 1] = digits[md5[i] & 0x0F];
+  }
+  hex[32] = '\0';
+}
+
+template<typename Base, typename Out>
+class DeltaPatch {
+
+  private:
+    enum ParseState : uint8_t {
+      PARSE_HEADER,
+      PARSE_OP,
+      PARSE_LEN, //Varint length of COPY / REPLACE / INSERT
+      PARSE_SEEK, //Varint of SEEK
+      PARSE_DATA, //New bytes of REPLACE / INSERT
+      PARSE_COPY, //Waiting on pump()
+      PARSE_ERROR
+    };
+
+    static bool patching;
+    static ParseState state;
+    static uint8_t header[DELTA_HEADER_LEN];
+    static uint8_t header_len;
+    static uint8_t op;
+    static uint32_t varint;
+    static uint8_t shift;
+    static uint32_t remaining; //Bytes left in current op
+    static uint32_t src; //Position in base
+    static uint32_t base_size;
+    static uint32_t out_pos; //Bytes of target written
+    static uint32_t target_size;
+    static bool out_started;
+    static uint32_t copied; //Bytes of target from base
+    static uint32_t literal; //Bytes of target from delta
+
+    static uint32_t readLE32(const uint8_t* p);
+    static bool startPatch();
+    static bool endVarint();
+    static size_t error();
+
+  public:
+    static void setPatching(bool on); //Next download is a delta (true) or full image (false)
+    static bool isPatching();
+    static bool matchesBase(const uint8_t* delta_header, uint8_t len); //True if delta starting with these bytes applies to Base
+
+    //OtaDownload sink
+    static bool begin(uint32_t size, const char* hash); //When patching, size and hash are the delta's. Target's come from its header.
+    static uint16_t room(); //Bytes write() takes now. 0 while a copy is pending.
+    static size_t write(const uint8_t* data, size_t len);
+    static uint16_t pump(uint16_t max_bytes); //Write up to max_bytes of a pending copy. Returns bytes written.
+    static bool end();
+    static void abort();
+
+    //Getters
+    static uint32_t getTargetSize();
+    static uint32_t getCopied();
+    static uint32_t getLiteral();
+
+};//END DeltaPatch definition
+
+template<typename Base, typename Out> bool DeltaPatch<Base, Out>::patching = false;
+template<typename Base, typename Out> typename DeltaPatch<Base, Out>::ParseState DeltaPatch<Base, Out>::state = DeltaPatch<Base, Out>::PARSE_HEADER;
+template<typename Base, typename Out> uint8_t DeltaPatch<Base, Out>::header[DELTA_HEADER_LEN];
+template<typename Base, typename Out> uint8_t DeltaPatch<Base, Out>::header_len = 0;
+template<typename Base, typename Out> uint8_t DeltaPatch<Base, Out>::op = 0;
+template<typename Base, typename Out> uint32_t DeltaPatch<Base, Out>::varint = 0;
+template<typename Base, typename Out> uint8_t DeltaPatch<Base, Out>::shift = 0;
+template<typename Base, typename Out> uint32_t DeltaPatch<Base, Out>::remaining = 0;
+template<typename Base, typename Out> uint32_t DeltaPatch<Base, Out>::src = 0;
+template<typename Base, typename Out> uint32_t DeltaPatch<Base, Out>::base_size = 0;
+template<typename Base, typename Out> uint32_t DeltaPatch<Base, Out>::out_pos = 0;
+template<typename Base, typename Out> uint32_t DeltaPatch<Base, Out>::target_size = 0;
+template<typename Base, typename Out> bool DeltaPatch<Base, Out>::out_started = false;
+template<typename Base, typename Out> uint32_t DeltaPatch<Base, Out>::copied = 0;
+template<typename Base, typename Out> uint32_t DeltaPatch<Base, Out>::literal = 0;
+
+
+// FUNCTION IMPLEMENTATION
+
+template<typename Base, typename Out>
+uint32_t DeltaPatch<Base, Out>::readLE32(const uint8_t* p){
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+template<typename Base, typename Out>
+void DeltaPatch<Base, Out>::setPatching(bool on){
+  patching = on;
+}
+
+template<typename Base, typename Out>
+bool DeltaPatch<Base, Out>::isPatching(){
+  return patching;
+}
+
+template<typename Base, typename Out>
+bool DeltaPatch<Base, Out>::matchesBase(const uint8_t* delta_header, uint8_t len){
+  if(len < DELTA_HEADER_LEN || memcmp(delta_header, "DCDL", 4) != 0 || delta_header[4] != DELTA_FORMAT){
+    return false;
+  }
+  char base_md5[33]; /* Flawfinder: ignore */
+  md5ToHex(delta_header + 9, base_md5);
+  return readLE32(delta_header + 5) == Base::size() && Base::hasMd5(base_md5);
+}
+
+template<typename Base, typename Out>
+bool DeltaPatch<Base, Out>::startPatch(){
+  if(!matchesBase(header, header_len)){
+    return false;
+  }
+  base_size = readLE32(header + 5);
+  target_size = readLE32(header + 25);
+
+  char target_md5[33]; /* Flawfinder: ignore */
+  md5ToHex(header + 29, target_md5);
+  out_started = Out::begin(target_size, target_md5);
+  return out_started;
+}
+
+template<typename Base, typename Out>
+size_t DeltaPatch<Base, Out>::error(){
+  state = PARSE_ERROR;
+  return 0;
+}
+
+template<typename Base, typename Out>
+bool DeltaPatch<Base, Out>::endVarint(){
+  if(state == PARSE_SEEK){
+    int32_t delta = (int32_t)(varint >> 1) ^ -(int32_t)(varint & 1);
+    if((delta < 0 && (uint32_t)(-delta) > src) || (delta > 0 && src + delta > base_size)){
+      return false;
+    }
+    src += delta;
+    state = PARSE_OP;
+    return true;
+  }
+
+  if(varint > target_size - out_pos || (op == DELTA_COPY && varint > base_size - src)){
+    return false;
+  }
+  remaining = varint;
+  state = (remaining == 0) ? PARSE_OP : (op == DELTA_COPY) ? PARSE_COPY : PARSE_DATA;
+  return true;
+}
+
+template<typename Base, typename Out>
+bool DeltaPatch<Base, Out>::begin(uint32_t size, const char* hash){
+  if(!patching){
+    return Out::begin(size, hash);
+  }
+  state = PARSE_HEADER;
+  header_len = 0;
+  src = 0;
+  base_size = 0;
+  out_pos = 0;
+  target_size = 0;
+  out_started = false;
+  copied = 0;
+  literal = 0;
+  return true;
+}
+
+template<typename Base, typename Out>
+uint16_t DeltaPatch<Base, Out>::room(){
+  if(!patching){
+    return 0xFFFF;
+  }
+  switch(state){
+    case PARSE_HEADER: return DELTA_HEADER_LEN - header_len;
+    case PARSE_OP:
+    case PARSE_LEN:
+    case PARSE_SEEK: return 1; //Ops are a few bytes each, so they're parsed a byte at a time
+    case PARSE_DATA: return (remaining > 0xFFFF) ? 0xFFFF : remaining;
+    default: return 0;
+  }
+}
+
+template<typename Base, typename Out>
+size_t DeltaPatch<Base, Out>::write(const uint8_t* data, size_t len){
+  if(!patching){
+    return Out::write(data, len);
+  }
+
+  size_t used = 0;
+  while(used < len){
+    switch(state){
+
+      case PARSE_HEADER: {
+        size_t n = min(len - used, (size_t)(DELTA_HEADER_LEN - header_len));
+        memcpy(header + header_len, data + used, n);
+        header_len += n;
+        used += n;
+        if(header_len == DELTA_HEADER_LEN){
+          if(!startPatch()){
+            return error();
+          }
+          state = PARSE_OP;
+        }
+        break;
+      }
+
+      case PARSE_OP:
+        op = data[used++];
+        if(op < DELTA_COPY || op > DELTA_SEEK){
+          return error();
+        }
+        varint = 0;
+        shift = 0;
+        state = (op == DELTA_SEEK) ? PARSE_SEEK : PARSE_LEN;
+        break;
+
+      case PARSE_LEN:
+      case PARSE_SEEK: {
+        uint8_t b = data[used++];
+        if(shift > 28){
+          return error();
+        }
+        varint |= (uint32_t)(b & 0x7F) << shift;
+        shift += 7;
+        if(!(b & 0x80) && !endVarint()){
+          return error();
+        }
+        break;
+      }
+
+      case PARSE_DATA: {
+        size_t n = min(len - used, (size_t)remaining);
+        if(Out::write(data + used, n) != n){
+          return error();
+        }
+        used += n;
+        out_pos += n;
+        literal += n;
+        remaining -= n;
+        if(op == DELTA_REPLACE){
+          src += n;
+        }
+        if(remaining == 0){
+          state = PARSE_OP;
+        }
+        break;
+      }
+
+      default: //Copy pending or error: more input than room() allowed
+        return error();
+    }
+  }
+  return used;
+}
+
+template<typename Base, typename Out>
+uint16_t DeltaPatch<Base, Out>::pump(uint16_t max_bytes){
+  if(!patching || state != PARSE_COPY){
+    return 0;
+  }
+
+  uint8_t chunk[DELTA_COPY_LEN];
+  uint16_t n = min((uint32_t)min(max_bytes, (uint16_t)DELTA_COPY_LEN), remaining);
+  if(n == 0 || !Base::read(src, chunk, n) || Out::write(chunk, n) != n){
+    error();
+    return 0;
+  }
+  src += n;
+  out_pos += n;
+  copied += n;
+  remaining -= n;
+  if(remaining == 0){
+    state = PARSE_OP;
+  }
+  return n;
+}
+
+template<typename Base, typename Out>
+bool DeltaPatch<Base, Out>::end(){
+  if(!patching){
+    return Out::end();
+  }
+  if(!out_started || state != PARSE_OP || out_pos != target_size){
+    abort();
+    return false;
+  }
+  out_started = false;
+  return Out::end();
+}
+
+template<typename Base, typename Out>
+void DeltaPatch<Base, Out>::abort(){
+  if(!patching){
+    Out::abort();
+    return;
+  }
+  if(out_started){
+    Out::abort();
+    out_started = false;
+  }
+  state = PARSE_ERROR;
+}
+
+template<typename Base, typename Out>
+uint32_t DeltaPatch<Base, Out>::getTargetSize(){
+  return target_size;
+}
+
+template<typename Base, typename Out>
+uint32_t DeltaPatch<Base, Out>::getCopied(){
+  return copied;
+}
+
+template<typename Base, typename Out>
+uint32_t DeltaPatch<Base, Out>::getLiteral(){
+  return literal;
+}
+
+// END FUNCTION IMPLEMENTATION
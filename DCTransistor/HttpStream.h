@@ -0,0 +1,148 @@
+#include <Arduino.h>
+
+/*
+    Minimal HTTP/1.0 GET request and response header handling over any Stream, using only caller-provided buffers.
+
+    Replaces HTTPClient, which builds a String for the URL, each request header and each collected response header on every
+    request. Requests are formatted into one fixed buffer and response lines are read into another, so a request / response
+    cycle makes no heap allocations of its own.
+
+    Requests are HTTP/1.0 so servers never send a chunked body and the stream can be handed straight to ArduinoJson
+    (same reason HTTPClient::useHTTP10() was set before).
+
+    URLs and extra headers may be in flash (PSTR / config.h defines) or DRAM.
+*/
+
+#define HTTP_REQUEST_LEN 448 //Longest request line + headers (GIS train location URL is ~250 characters)
+#define HTTP_HOST_LEN 48 //Longest remote host name
+#define HTTP_LINE_LEN 160 //Longest response header line kept. Longer lines are truncated.
+
+//Append a (flash or DRAM) string to buf at pos. Returns new pos, or len if it did not fit.
+uint16_t appendHttpText(char* buf, uint16_t pos, uint16_t len, PGM_P text){
+  if(text == NULL){
+    return pos;
+  }
+  for(uint16_t i=0; pos < len; i++){
+    char c = pgm_read_byte(text + i);
+    if(c == '\0'){
+      return pos;
+    }
+    buf[pos++] = c;
+  }
+  return len;
+}
+
+//Split url ("https://host/path") into host, and format a GET request for it into request.
+//extra_headers must each end in "\r\n" (or be NULL). Returns request length, or 0 if url is malformed or anything doesn't fit.
+uint16_t formatGetRequest(char* request, uint16_t request_len, char* host, uint8_t host_len, PGM_P url, PGM_P extra_headers){
+
+  //Skip scheme
+  uint16_t u = 0;
+  while(pgm_read_byte(url + u) != '\0' && !(pgm_read_byte(url + u) == '/' && pgm_read_byte(url + u + 1) == '/')){u++;}
+  if(pgm_read_byte(url + u) == '\0'){
+    return 0;
+  }
+  u += 2;
+
+  //Copy host up to first '/'
+  uint8_t h = 0;
+  char c;
+  while((c = pgm_read_byte(url + u)) != '\0' && c != '/'){
+    if(h >= host_len - 1){
+      return 0;
+    }
+    host[h++] = c;
+    u++;
+  }
+  host[h] = '\0';
+  if(h == 0){
+    return 0;
+  }
+
+  uint16_t pos = appendHttpText(request, 0, request_len, PSTR("GET "));
+  pos = (c == '\0') ? appendHttpText(request, pos, request_len, PSTR("/")) : appendHttpText(request, pos, request_len, url + u);
+  pos = appendHttpText(request, pos, request_len, PSTR(" HTTP/1.0\r\nHost: "));
+  pos = appendHttpText(request, pos, request_len, host);
+  pos = appendHttpText(request, pos, request_len, PSTR("\r\nUser-Agent: DCTransistor\r\nConnection: close\r\n"));
+  pos = appendHttpText(request, pos, request_len, extra_headers);
+  pos = appendHttpText(request, pos, request_len, PSTR("\r\n"));
+
+  //Need room for terminating NUL too
+  if(pos >= request_len){
+    return 0;
+  }
+  request[pos] = '\0';
+  return pos;
+}
+
+//Read one response line into line (without "\r\n"). Rest of lines too long for buffer are discarded. Returns line length.
+uint16_t readHttpLine(Stream &stream, char* line, uint16_t line_len){
+  uint16_t n = stream.readBytesUntil('\n', line, line_len - 1);
+  if(n == line_len - 1){
+    stream.find((char*)"\n");
+  }
+  if(n > 0 && line[n-1] == '\r'){
+    n--;
+  }
+  line[n] = '\0';
+  return n;
+}
+
+//Read status line ("HTTP/1.1 200 OK") and return status code, or -1 if response is not HTTP.
+int16_t readHttpStatus(Stream &stream){
+  char line[HTTP_LINE_LEN];
+  readHttpLine(stream, line, sizeof(line));
+
+  if(strncmp(line, "HTTP/", 5) != 0){
+    return -1;
+  }
+  const char* code = strchr(line, ' ');
+  if(code == NULL){
+    return -1;
+  }
+  return atoi(code + 1);
+}
+
+//Response header to collect: value gets the header's value (truncated to fit), or "" if it wasn't sent
+struct HttpHeader {
+  const char* name;
+  char* value;
+  uint16_t value_len;
+};
+
+//Read all response headers, leaving stream at start of body, copying any of the given headers into their values.
+//Returns how many of them were found.
+uint8_t readHttpHeaders(Stream &stream, HttpHeader* headers, uint8_t num_headers){
+  char line[HTTP_LINE_LEN];
+  uint8_t found = 0;
+
+  for(uint8_t i=0; i<num_headers; i++){
+    headers[i].value[0] = '\0';
+  }
+
+  while(readHttpLine(stream, line, sizeof(line)) > 0){
+    for(uint8_t i=0; i<num_headers; i++){
+      uint8_t name_len = strlen(headers[i].name);
+      if(headers[i].value[0] == '\0' && strncasecmp(line, headers[i].name, name_len) == 0 && line[name_len] == ':'){ //First one wins
+        const char* v = line + name_len + 1;
+        while(*v == ' '){v++;}
+        strncpy(headers[i].value, v, headers[i].value_len - 1); /* Flawfinder: ignore */
+        headers[i].value[headers[i].value_len - 1] = '\0';
+        found++;
+        break;
+      }
+    }
+  }
+  return found;
+}
+
+//Read all response headers, leaving stream at start of body. If name is given, copy that header's value into value.
+//Returns true if the named header was found (or if no name given).
+bool readHttpHeaders(Stream &stream, const char* name, char* value, uint16_t value_len){
+  if(name == NULL){
+    readHttpHeaders(stream, NULL, 0);
+    return true;
+  }
+  HttpHeader header = {name, value, value_len};
+  return readHttpHeaders(stream, &header, 1) == 1;
+}
@@ -0,0 +1,387 @@
+#include "HeapTelemetry.h"
+
+/*
+    Defines MetricsPage class template, FetchStats and FreshnessStats classes - the board's status, formatted as
+    Prometheus text for the /metrics endpoint.
+
+    The page is formatted once per loop, after the frame is shown, into a fixed buffer. A scrape only copies that
+    buffer out, so it never allocates, never formats, and cannot stretch a render or a poll.
+
+    FetchStats counts every poll of the train data source: fetch latency histogram (request sent through response
+    parsed), failures, and redundant polls (same train positions as the previous poll, i.e. WMATA had not updated yet).
+
+    FreshnessStats tracks end-to-end data freshness - time from the newest train position WMATA reported (ETIME) to
+    the frame that showed it, by the SNTP clock. p50 / p95 / p99 are over the last FRESHNESS_WINDOW polls.
+
+    The page itself is built and checked on Desktop (MetricsPageTest). The web server (ESP8266WebServer) is only set up
+    in each board's .ino.
+*/
+
+#define METRICS_PAGE_LEN 11264 //Bytes of preformatted /metrics page, sized from the worst-case page in MetricsPageTest. Page is cut short (and flagged) if it doesn't fit.
+#define FETCH_BUCKETS 8 //Last bucket is +Inf
+#define FRESHNESS_WINDOW 64 //Polls kept for freshness percentiles
+
+//Upper bound (le) of each fetch latency bucket, in milliseconds
+const uint16_t fetch_bucket_ms[FETCH_BUCKETS - 1] = {100, 250, 500, 1000, 2500, 5000, 10000};
+
+//Board-wide values shown on the page that don't belong to any one object
+struct BoardStatus {
+  const char* version;
+  const char* reset_reason;
+  uint32_t uptime_s;
+  uint32_t tls_handshakes;
+  uint32_t tls_handshake_failures;
+  uint32_t first_frame_ms; //millis() when trains were first shown, saved (warm start) or live. 0 until then.
+  uint32_t first_live_frame_ms; //millis() when live trains were first shown. 0 until then.
+};
+
+class FetchStats {
+
+  private:
+    uint32_t buckets[FETCH_BUCKETS]; //Not cumulative. Summed when printed.
+    uint64_t sum_ms;
+    uint32_t polls;
+    uint32_t failures;
+    uint32_t redundant;
+
+  public:
+    FetchStats();
+
+    void reset();
+    void record(uint32_t ms, bool ok, bool unchanged); //One poll. unchanged = same positions as previous poll.
+
+    //Getters
+    uint32_t getPolls();
+    uint32_t getFailures();
+    uint32_t getRedundant();
+    uint16_t getRedundantPermille(); //Redundant polls per 1000 successful polls
+
+    void printMetrics(Print &out);
+
+};//END FetchStats definition
+
+class FreshnessStats {
+
+  private:
+    uint32_t window[FRESHNESS_WINDOW]; //Lag of recent polls in ms, oldest overwritten first
+    uint8_t next;
+    uint8_t size;
+    uint32_t last_ms;
+    uint64_t sum_ms;
+    uint32_t count;
+
+  public:
+    FreshnessStats();
+
+    void reset();
+    void record(uint64_t newest_ms, uint64_t shown_ms); //Epoch ms of newest position and of frame showing it. Ignored if either is 0 (clock not set).
+
+    //Getters
+    uint32_t getCount();
+    uint32_t getLast();
+    uint32_t getPercentile(uint8_t pct); //Nearest-rank percentile of window, in ms
+
+    void printMetrics(Print &out);
+
+};//END FreshnessStats definition
+
+//Fixed-size text buffer that is also a Print, so anything that prints to Serial can print to the page.
+template<uint16_t N>
+class MetricsPage : public Print {
+
+  private:
+    char buf[N];
+    uint16_t len;
+    bool overflow;
+
+  public:
+    MetricsPage();
+
+    void begin(); //Empty page before formatting a new one
+    size_t write(uint8_t c) override;
+
+    //Prometheus helpers. Lines end in bare \n as the text format requires.
+    void type(const char* name, const char* kind);
+    void value(const char* name, uint32_t v);
+    void value(const char* name, const char* label, const char* label_value, int32_t v);
+
+    //Getters
+    const char* c_str();
+    uint16_t length();
+    bool overflowed(); //true if last page didn't fit in N bytes and was cut short
+
+};//END MetricsPage definition
+
+
+// FUNCTION IMPLEMENTATION
+
+//Print thousandths as a decimal with three places (e.g. 1500 -> 1.500). Avoids float printing.
+void printFixed3(Print &out, uint64_t thousandths){
+  out.print((unsigned long long)(thousandths / 1000));
+  out.print('.');
+  uint16_t frac = thousandths % 1000;
+  if(frac < 100){out.print('0');}
+  if(frac < 10){out.print('0');}
+  out.print(frac);
+}
+
+FetchStats::FetchStats(){
+  reset();
+}
+
+void FetchStats::reset(){
+  for(uint8_t b=0; b<FETCH_BUCKETS; b++){
+    buckets[b] = 0;
+  }
+  sum_ms = 0;
+  polls = 0;
+  failures = 0;
+  redundant = 0;
+}
+
+void FetchStats::record(uint32_t ms, bool ok, bool unchanged){
+  polls++;
+  if(!ok){
+    failures++;
+  }
+  else if(unchanged){
+    redundant++;
+  }
+
+  uint8_t b = 0;
+  while(b < FETCH_BUCKETS - 1 && ms > fetch_bucket_ms[b]){b++;}
+  buckets[b]++;
+  sum_ms += ms;
+}
+
+uint32_t FetchStats::getPolls(){
+  return polls;
+}
+
+uint32_t FetchStats::getFailures(){
+  return failures;
+}
+
+uint32_t FetchStats::getRedundant(){
+  return redundant;
+}
+
+uint16_t FetchStats::getRedundantPermille(){
+  uint32_t ok = polls - failures;
+  return (ok == 0) ? 0 : ((uint64_t)redundant * 1000) / ok;
+}
+
+void FetchStats::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_fetch_duration_ms histogram\n"));
+  uint32_t cumulative = 0;
+  for(uint8_t b=0; b<FETCH_BUCKETS; b++){
+    cumulative += buckets[b];
+    out.print(F("dctransistor_fetch_duration_ms_bucket{le=\""));
+    if(b < FETCH_BUCKETS - 1){
+      out.print(fetch_bucket_ms[b]);
+    }
+    else{
+      out.print(F("+Inf"));
+    }
+    out.print(F("\"} "));
+    out.print(cumulative);
+    out.print('\n');
+  }
+  out.print(F("dctransistor_fetch_duration_ms_sum "));
+  out.print((unsigned long long)sum_ms);
+  out.print(F("\ndctransistor_fetch_duration_ms_count "));
+  out.print(polls);
+  out.print('\n');
+
+  out.print(F("# TYPE dctransistor_poll_failures_total counter\ndctransistor_poll_failures_total "));
+  out.print(failures);
+  out.print(F("\n# TYPE dctransistor_redundant_polls_total counter\ndctransistor_redundant_polls_total "));
+  out.print(redundant);
+  out.print(F("\n# TYPE dctransistor_redundant_poll_ratio gauge\ndctransistor_redundant_poll_ratio "));
+  printFixed3(out, getRedundantPermille());
+  out.print('\n');
+}
+
+FreshnessStats::FreshnessStats(){
+  reset();
+}
+
+void FreshnessStats::reset(){
+  next = 0;
+  size = 0;
+  last_ms = 0;
+  sum_ms = 0;
+  count = 0;
+}
+
+void FreshnessStats::record(uint64_t newest_ms, uint64_t shown_ms){
+  if(newest_ms == 0 || shown_ms == 0){
+    return;
+  }
+
+  //Clock skew can put WMATA's time ahead of ours. Count that as perfectly fresh.
+  uint64_t lag = (shown_ms > newest_ms) ? shown_ms - newest_ms : 0;
+  last_ms = (lag > 0xFFFFFFFF) ? 0xFFFFFFFF : lag;
+
+  window[next] = last_ms;
+  next = (next + 1) % FRESHNESS_WINDOW;
+  if(size < FRESHNESS_WINDOW){size++;}
+
+  sum_ms += last_ms;
+  count++;
+}
+
+uint32_t FreshnessStats::getCount(){
+  return count;
+}
+
+uint32_t FreshnessStats::getLast(){
+  return last_ms;
+}
+
+uint32_t FreshnessStats::getPercentile(uint8_t pct){
+  if(size == 0){
+    return 0;
+  }
+
+  //Insertion sort a copy. Window is small and this only runs when the page is formatted.
+  uint32_t sorted[FRESHNESS_WINDOW];
+  for(uint8_t i=0; i<size; i++){
+    uint32_t v = window[i];
+    int16_t j = i - 1;
+    while(j >= 0 && sorted[j] > v){
+      sorted[j + 1] = sorted[j];
+      j--;
+    }
+    sorted[j + 1] = v;
+  }
+
+  uint16_t rank = ((uint16_t)pct * size + 99) / 100;
+  return sorted[(rank == 0) ? 0 : rank - 1];
+}
+
+void FreshnessStats::printMetrics(Print &out){
+  static const uint8_t quantiles[3] = {50, 95, 99};
+
+  out.print(F("# TYPE dctransistor_data_freshness_seconds summary\n"));
+  if(size > 0){
+    for(uint8_t q=0; q<3; q++){
+      out.print(F("dctransistor_data_freshness_seconds{quantile=\"0."));
+      out.print(quantiles[q]);
+      out.print(F("\"} "));
+      printFixed3(out, getPercentile(quantiles[q]));
+      out.print('\n');
+    }
+  }
+  out.print(F("dctransistor_data_freshness_seconds_sum "));
+  printFixed3(out, sum_ms);
+  out.print(F("\ndctransistor_data_freshness_seconds_count "));
+  out.print(count);
+  out.print(F("\n# TYPE dctransistor_data_freshness_last_seconds gauge\ndctransistor_data_freshness_last_seconds "));
+  printFixed3(out, last_ms);
+  out.print('\n');
+}
+
+template<uint16_t N>
+MetricsPage<N>::MetricsPage(){
+  begin();
+}
+
+template<uint16_t N>
+void MetricsPage<N>::begin(){
+  len = 0;
+  overflow = false;
+  buf[0] = '\0';
+}
+
+template<uint16_t N>
+size_t MetricsPage<N>::write(uint8_t c){
+  if(len >= N - 1){
+    overflow = true;
+    return 0;
+  }
+  buf[len++] = c;
+  buf[len] = '\0';
+  return 1;
+}
+
+template<uint16_t N>
+void MetricsPage<N>::type(const char* name, const char* kind){
+  print(F("# TYPE "));
+  print(name);
+  print(' ');
+  print(kind);
+  print('\n');
+}
+
+template<uint16_t N>
+void MetricsPage<N>::value(const char* name, uint32_t v){
+  print(name);
+  print(' ');
+  print(v);
+  print('\n');
+}
+
+template<uint16_t N>
+void MetricsPage<N>::value(const char* name, const char* label, const char* label_value, int32_t v){
+  print(name);
+  print('{');
+  print(label);
+  print(F("=\""));
+  print(label_value);
+  print(F("\"} "));
+  print(v);
+  print('\n');
+}
+
+template<uint16_t N>
+const char* MetricsPage<N>::c_str(){
+  return buf;
+}
+
+template<uint16_t N>
+uint16_t MetricsPage<N>::length(){
+  return len;
+}
+
+template<uint16_t N>
+bool MetricsPage<N>::overflowed(){
+  return overflow;
+}
+
+//Format the whole /metrics page: board info, trains per line, polling, freshness and TLS stats, heap telemetry.
+template<uint16_t N, typename Line, uint8_t HEAP_SAMPLES>
+void formatMetrics(MetricsPage<N> &page, const BoardStatus &status, Line* const lines[], uint8_t num_lines, FetchStats &fetch, FreshnessStats &freshness, HeapTelemetry<HEAP_SAMPLES> &heap){
+  page.begin();
+
+  page.type("dctransistor_build_info", "gauge");
+  page.value("dctransistor_build_info", "version", status.version, 1);
+  page.type("dctransistor_reset_reason_info", "gauge");
+  page.value("dctransistor_reset_reason_info", "reason", status.reset_reason, 1);
+  page.type("dctransistor_uptime_seconds", "counter");
+  page.value("dctransistor_uptime_seconds", status.uptime_s);
+
+  page.type("dctransistor_time_to_first_frame_ms", "gauge");
+  page.value("dctransistor_time_to_first_frame_ms", status.first_frame_ms);
+  page.type("dctransistor_time_to_live_frame_ms", "gauge");
+  page.value("dctransistor_time_to_live_frame_ms", status.first_live_frame_ms);
+
+  page.type("dctransistor_line_trains", "gauge");
+  for(uint8_t l=0; l<num_lines; l++){
+    page.value("dctransistor_line_trains", "line", lines[l]->getColor(), lines[l]->getTrainCount());
+  }
+
+  page.type("dctransistor_polls_total", "counter");
+  page.value("dctransistor_polls_total", fetch.getPolls());
+  fetch.printMetrics(page);
+  freshness.printMetrics(page);
+
+  page.type("dctransistor_tls_handshakes_total", "counter");
+  page.value("dctransistor_tls_handshakes_total", status.tls_handshakes);
+  page.type("dctransistor_tls_handshake_failures_total", "counter");
+  page.value("dctransistor_tls_handshake_failures_total", status.tls_handshake_failures);
+
+  heap.printMetrics(page);
+}
+
+// END FUNCTION IMPLEMENTATION
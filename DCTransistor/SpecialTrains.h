@@ -0,0 +1,178 @@
+#include <Arduino.h>
+
+/*
+    Defines SpecialTrains class template - the special (themed / promotional) trains running now, by ITT, each with
+    the palette of its campaign, and where each was seen in the latest train feed.
+
+    During events WMATA runs several special trains at once. The special train check add()s one entry per active
+    campaign whose train it found. parseTrainFeed looks up every train's ITT with find() - a small open-addressed hash
+    table, so one probe or two per train however many specials there are - and records where each special is with
+    sight(). The compositor then gets one overlay per special seen, from the same single pass over the feed.
+*/
+
+template<uint8_t N>
+class SpecialTrains {
+
+  private:
+    //Hash table slots: power of two, at least twice N, so probes stay short
+    static const uint8_t SLOTS = (N <= 2) ? 4 : (N <= 4) ? 8 : (N <= 8) ? 16 : (N <= 16) ? 32 : 64;
+
+    int16_t ids[N]; //ITT of each special train
+    uint8_t palettes[N]; //Palette number of each (see SPECIAL_PALETTES in config.h)
+    int8_t lines[N]; //Where each was seen in latest feed. Line index, or -1 if not seen.
+    uint8_t indexes[N];
+    uint8_t dirs[N];
+    uint8_t num_trains;
+    int8_t slots[SLOTS]; //Index into ids, or -1 if empty
+
+    uint8_t slotFor(int16_t id);
+
+  public:
+    SpecialTrains();
+
+    void clear(); //Remove all special trains
+    bool add(int16_t id, uint8_t palette); //Returns false if full, id is -1 or id already added
+    int8_t find(int16_t id); //Index of special train with this ITT, or -1
+
+    void clearSightings(); //Before parsing a feed
+    void sight(uint8_t i, int8_t line, uint8_t index, uint8_t dir); //Special train i was seen at line's station index
+
+    //Getters
+    uint8_t getCount();
+    int16_t getId(uint8_t i);
+    uint8_t getPalette(uint8_t i);
+    int8_t getLine(uint8_t i); //-1 if not seen
+    uint8_t getIndex(uint8_t i);
+    uint8_t getDir(uint8_t i);
+    uint8_t getSeenCount();
+
+    void printMetrics(Print &out);
+
+};//END SpecialTrains definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<uint8_t N>
+SpecialTrains<N>::SpecialTrains(){
+  clear();
+}
+
+template<uint8_t N>
+uint8_t SpecialTrains<N>::slotFor(int16_t id){
+  return (uint8_t)(((uint16_t)id * 40503u) >> 8) & (SLOTS - 1); //Fibonacci hash: nearby ITTs spread out
+}
+
+template<uint8_t N>
+void SpecialTrains<N>::clear(){
+  num_trains = 0;
+  for(uint8_t s=0; s<SLOTS; s++){
+    slots[s] = -1;
+  }
+}
+
+template<uint8_t N>
+bool SpecialTrains<N>::add(int16_t id, uint8_t palette){
+  if(num_trains >= N || id == -1 || find(id) != -1){
+    return false;
+  }
+
+  uint8_t s = slotFor(id);
+  while(slots[s] != -1){
+    s = (s + 1) & (SLOTS - 1);
+  }
+  slots[s] = num_trains;
+
+  ids[num_trains] = id;
+  palettes[num_trains] = palette;
+  lines[num_trains] = -1;
+  indexes[num_trains] = 0;
+  dirs[num_trains] = 0;
+  num_trains++;
+  return true;
+}
+
+template<uint8_t N>
+int8_t SpecialTrains<N>::find(int16_t id){
+  uint8_t s = slotFor(id);
+  while(slots[s] != -1){
+    if(ids[slots[s]] == id){
+      return slots[s];
+    }
+    s = (s + 1) & (SLOTS - 1);
+  }
+  return -1;
+}
+
+template<uint8_t N>
+void SpecialTrains<N>::clearSightings(){
+  for(uint8_t i=0; i<num_trains; i++){
+    lines[i] = -1;
+  }
+}
+
+template<uint8_t N>
+void SpecialTrains<N>::sight(uint8_t i, int8_t line, uint8_t index, uint8_t dir){
+  if(i < num_trains){
+    lines[i] = line;
+    indexes[i] = index;
+    dirs[i] = dir;
+  }
+}
+
+template<uint8_t N>
+uint8_t SpecialTrains<N>::getCount(){
+  return num_trains;
+}
+
+template<uint8_t N>
+int16_t SpecialTrains<N>::getId(uint8_t i){
+  return (i < num_trains) ? ids[i] : -1;
+}
+
+template<uint8_t N>
+uint8_t SpecialTrains<N>::getPalette(uint8_t i){
+  return (i < num_trains) ? palettes[i] : 0;
+}
+
+template<uint8_t N>
+int8_t SpecialTrains<N>::getLine(uint8_t i){
+  return (i < num_trains) ? lines[i] : -1;
+}
+
+template<uint8_t N>
+uint8_t SpecialTrains<N>::getIndex(uint8_t i){
+  return (i < num_trains) ? indexes[i] : 0;
+}
+
+template<uint8_t N>
+uint8_t SpecialTrains<N>::getDir(uint8_t i){
+  return (i < num_trains) ? dirs[i] : 0;
+}
+
+template<uint8_t N>
+uint8_t SpecialTrains<N>::getSeenCount(){
+  uint8_t seen = 0;
+  for(uint8_t i=0; i<num_trains; i++){
+    seen += (lines[i] != -1);
+  }
+  return seen;
+}
+
+template<uint8_t N>
+void SpecialTrains<N>::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_special_trains gauge\ndctransistor_special_trains "));
+  out.print(num_trains);
+  out.print(F("\n# TYPE dctransistor_special_train_seen gauge\n"));
+  for(uint8_t i=0; i<num_trains; i++){
+    out.print(F("dctransistor_special_train_seen{itt=\""));
+    out.print(ids[i]);
+    out.print(F("\",palette=\""));
+    out.print(palettes[i]);
+    out.print(F("\"} "));
+    out.print((lines[i] != -1) ? 1 : 0);
+    out.print('\n');
+  }
+}
+
+// END FUNCTION IMPLEMENTATION
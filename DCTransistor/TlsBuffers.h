@@ -0,0 +1,160 @@
+#include <Arduino.h>
+
+/*
+    Defines TlsBuffers class template - TLS receive buffer size per host, from probing each host once for Max Fragment
+    Length negotiation (MFLN, RFC 6066).
+
+    WiFiClientSecure's receive buffer defaults to a whole 16 KB TLS record, allocated for every connection. A host
+    that agrees to a smaller maximum fragment only ever sends records that fit a smaller buffer. The first connection
+    to each host after boot probes it (probeMaxFragmentLength, a short extra connection) for each of TLS_MFLN_SIZES,
+    smallest first, and the first size it accepts is kept for the rest of the boot. prepare() sets the buffers before
+    every connect, since they stay set on the one shared client.
+
+    If a host then doesn't negotiate the size it accepted in the probe (checked in connected()), it goes back to the
+    default buffers for the rest of the boot.
+
+    Client is a template parameter of prepare() / connected() (probeMaxFragmentLength / setBufferSizes /
+    getMFLNStatus), so tests can stand in for WiFiClientSecure.
+*/
+
+#define TLS_DEFAULT_RX_LEN 16384 //Largest TLS record. What BearSSL needs without MFLN.
+#define TLS_TX_LEN 512 //Requests are small (HTTP_REQUEST_LEN), so one size for every host
+#define TLS_NUM_MFLN_SIZES 2
+
+const uint16_t TLS_MFLN_SIZES[TLS_NUM_MFLN_SIZES] = {512, 1024}; //Tried in order. Larger sizes save little.
+
+template<uint8_t N>
+class TlsBuffers {
+
+  private:
+    struct Host {
+      const char* name;
+      bool probed;
+      uint16_t rx_len; //Receive buffer used for this host
+      bool negotiated; //Last handshake agreed a smaller fragment length
+      uint32_t fallbacks; //Handshakes that didn't agree the probed size
+    };
+    Host hosts[N];
+    uint8_t num_hosts;
+
+    Host* find(const char* host);
+
+  public:
+    TlsBuffers();
+
+    bool add(const char* host); //False if full
+    template<typename Client> void prepare(Client &client, const char* host, uint16_t port); //Probe if first time, then set buffers
+    template<typename Client> void connected(Client &client, const char* host, bool ok); //After connect: check size was agreed
+
+    //Getters
+    uint16_t getRxLen(const char* host); //0 if not probed yet
+    bool isNegotiated(const char* host);
+
+    void printMetrics(Print &out);
+
+};//END TlsBuffers definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<uint8_t N>
+TlsBuffers<N>::TlsBuffers(){
+  num_hosts = 0;
+}
+
+template<uint8_t N>
+bool TlsBuffers<N>::add(const char* host){
+  if(num_hosts >= N){
+    return false;
+  }
+  hosts[num_hosts] = {host, false, TLS_DEFAULT_RX_LEN, false, 0};
+  num_hosts++;
+  return true;
+}
+
+template<uint8_t N>
+typename TlsBuffers<N>::Host* TlsBuffers<N>::find(const char* host){
+  for(uint8_t i=0; i<num_hosts; i++){
+    if(strcmp(hosts[i].name, host) == 0){
+      return &hosts[i];
+    }
+  }
+  return NULL;
+}
+
+template<uint8_t N>
+template<typename Client>
+void TlsBuffers<N>::prepare(Client &client, const char* host, uint16_t port){
+  Host* h = find(host);
+  if(h == NULL){
+    client.setBufferSizes(TLS_DEFAULT_RX_LEN, TLS_TX_LEN);
+    return;
+  }
+
+  if(!h->probed){
+    h->probed = true;
+    for(uint8_t i=0; i<TLS_NUM_MFLN_SIZES; i++){
+      if(client.probeMaxFragmentLength(host, port, TLS_MFLN_SIZES[i])){
+        h->rx_len = TLS_MFLN_SIZES[i];
+        break;
+      }
+    }
+  }
+  client.setBufferSizes(h->rx_len, TLS_TX_LEN);
+}
+
+template<uint8_t N>
+template<typename Client>
+void TlsBuffers<N>::connected(Client &client, const char* host, bool ok){
+  Host* h = find(host);
+  if(h == NULL || !ok){
+    return;
+  }
+  h->negotiated = client.getMFLNStatus();
+  if(!h->negotiated && h->rx_len < TLS_DEFAULT_RX_LEN){
+    h->rx_len = TLS_DEFAULT_RX_LEN;
+    h->fallbacks++;
+  }
+}
+
+template<uint8_t N>
+uint16_t TlsBuffers<N>::getRxLen(const char* host){
+  Host* h = find(host);
+  return (h == NULL || !h->probed) ? 0 : h->rx_len;
+}
+
+template<uint8_t N>
+bool TlsBuffers<N>::isNegotiated(const char* host){
+  Host* h = find(host);
+  return h != NULL && h->negotiated;
+}
+
+template<uint8_t N>
+void TlsBuffers<N>::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_tls_rx_buffer_bytes gauge\n"));
+  for(uint8_t i=0; i<num_hosts; i++){
+    out.print(F("dctransistor_tls_rx_buffer_bytes{host=\""));
+    out.print(hosts[i].name);
+    out.print(F("\"} "));
+    out.print(hosts[i].probed ? hosts[i].rx_len : 0);
+    out.print('\n');
+  }
+  out.print(F("# TYPE dctransistor_tls_mfln_negotiated gauge\n"));
+  for(uint8_t i=0; i<num_hosts; i++){
+    out.print(F("dctransistor_tls_mfln_negotiated{host=\""));
+    out.print(hosts[i].name);
+    out.print(F("\"} "));
+    out.print(hosts[i].negotiated ? 1 : 0);
+    out.print('\n');
+  }
+  out.print(F("# TYPE dctransistor_tls_mfln_fallbacks_total counter\n"));
+  for(uint8_t i=0; i<num_hosts; i++){
+    out.print(F("dctransistor_tls_mfln_fallbacks_total{host=\""));
+    out.print(hosts[i].name);
+    out.print(F("\"} "));
+    out.print(hosts[i].fallbacks);
+    out.print('\n');
+  }
+}
+
+// END FUNCTION IMPLEMENTATION
@@ -0,0 +1,225 @@
+#include <Arduino.h>
+
+/*
+    Defines UpdateManifest class - the latest release's version, image size and hash, and which image its delta
+    applies to, from a few-line text file published next to the binaries (by the compile-sketches workflow).
+
+    Update checks used to GET github.com/.../releases/latest just to read the version out of its redirect, then
+    open a second host for the image's MD5 and the delta's header. The manifest is one small request to the same
+    host as the image, made conditional with the last ETag (appendConditionalHeaders), so most checks are a 304.
+    On 304, or a 200 that doesn't parse, the manifest from the last check is used again, so an update that failed is retried.
+
+    Format, one "key=value" per line (unknown keys are ignored, so fields can be added):
+      version=2.0.77
+      size=<bytes of .bin.gz>
+      md5=<MD5 of .bin.gz, 32 hex>
+      delta_base=<MD5 of the .bin the delta was made from, 32 hex>    (only if a delta is published)
+      delta_size=<bytes of .bin.delta>
+*/
+
+#define MANIFEST_VERSION_LEN 16 //Longest version string, including NUL
+#define MANIFEST_ETAG_LEN 48 //Longest ETag kept, including quotes and NUL
+#define MANIFEST_LINE_LEN 64 //Longest manifest line read. Longer lines are ignored.
+#define MANIFEST_MAX_LINES 16 //Stop reading after this many lines
+
+//True if hex is exactly 32 hex digits
+bool isMd5Hex(const char* hex){
+  uint8_t i = 0;
+  for(; hex[i] != '\0'; i++){
+    if(i >= 32 || !isxdigit(hex[i])){
+      return false;
+    }
+  }
+  return i == 32;
+}
+
+class UpdateManifest {
+
+  private:
+    //One manifest's fields. A response is read into its own copy and only replaces the last one once it validates.
+    struct Fields {
+      char version[MANIFEST_VERSION_LEN];
+      uint32_t size;
+      char md5[33]; /* Flawfinder: ignore */
+      char delta_base[33]; /* Flawfinder: ignore */
+      uint32_t delta_size;
+    };
+
+    bool valid;
+    Fields latest;
+    char etag[MANIFEST_ETAG_LEN];
+
+    uint32_t downloads;
+    uint32_t not_modified;
+    uint32_t failures; //Bad responses and unparseable manifests
+
+    void clear();
+    static void clearFields(Fields &fields);
+
+  public:
+    UpdateManifest();
+
+    uint16_t appendConditionalHeaders(char* buf, uint16_t pos, uint16_t len); //If-None-Match, if a manifest is held
+    bool parse(Stream &body, const char* response_etag); //Read a 200 response's body. False (and the last manifest kept) if it isn't one.
+    void notModified(); //304: keep using the last manifest
+    void failed(); //Any other response: keep the last manifest
+
+    //Getters
+    bool isValid();
+    bool hasDelta(); //A delta was published, from the image with MD5 getDeltaBase()
+    bool differsFrom(const char* running_version); //Valid, and for another version
+    const char* getVersion();
+    uint32_t getSize();
+    const char* getMd5();
+    const char* getDeltaBase();
+    uint32_t getDeltaSize();
+
+    void printMetrics(Print &out);
+
+};//END UpdateManifest definition
+
+
+// FUNCTION IMPLEMENTATION
+
+UpdateManifest::UpdateManifest(){
+  clear();
+  downloads = 0;
+  not_modified = 0;
+  failures = 0;
+}
+
+void UpdateManifest::clear(){
+  valid = false;
+  clearFields(latest);
+  etag[0] = '\0';
+}
+
+void UpdateManifest::clearFields(Fields &fields){
+  fields.version[0] = '\0';
+  fields.size = 0;
+  fields.md5[0] = '\0';
+  fields.delta_base[0] = '\0';
+  fields.delta_size = 0;
+}
+
+uint16_t UpdateManifest::appendConditionalHeaders(char* buf, uint16_t pos, uint16_t len){
+  if(!valid || etag[0] == '\0'){
+    return pos;
+  }
+  pos = appendHttpText(buf, pos, len, PSTR("If-None-Match: "));
+  pos = appendHttpText(buf, pos, len, etag);
+  return appendHttpText(buf, pos, len, PSTR("\r\n"));
+}
+
+bool UpdateManifest::parse(Stream &body, const char* response_etag){
+  Fields parsed;
+  clearFields(parsed);
+  downloads++;
+
+  char line[MANIFEST_LINE_LEN];
+  for(uint8_t i=0; i<MANIFEST_MAX_LINES; i++){
+    uint16_t n = body.readBytesUntil('\n', line, sizeof(line) - 1);
+    if(n == 0 && body.available() <= 0){
+      break;
+    }
+    if(n == sizeof(line) - 1){
+      body.find((char*)"\n"); //Too long for any known key
+      continue;
+    }
+    if(n > 0 && line[n-1] == '\r'){
+      n--;
+    }
+    line[n] = '\0';
+
+    char* value = strchr(line, '=');
+    if(value == NULL){
+      continue;
+    }
+    *value++ = '\0';
+
+    if(strcmp(line, "version") == 0 && strlen(value) < sizeof(parsed.version)){
+      strcpy(parsed.version, value); /* Flawfinder: ignore */
+    }
+    else if(strcmp(line, "size") == 0){
+      parsed.size = strtoul(value, NULL, 10);
+    }
+    else if(strcmp(line, "md5") == 0 && isMd5Hex(value)){
+      strcpy(parsed.md5, value); /* Flawfinder: ignore */
+    }
+    else if(strcmp(line, "delta_base") == 0 && isMd5Hex(value)){
+      strcpy(parsed.delta_base, value); /* Flawfinder: ignore */
+    }
+    else if(strcmp(line, "delta_size") == 0){
+      parsed.delta_size = strtoul(value, NULL, 10);
+    }
+  }
+
+  //Malformed 200: keep the last good manifest (and its ETag, so the next check downloads again)
+  if(parsed.version[0] == '\0' || parsed.size == 0 || parsed.md5[0] == '\0'){
+    failures++;
+    return false;
+  }
+  if(parsed.delta_base[0] == '\0' || parsed.delta_size == 0){
+    parsed.delta_base[0] = '\0';
+    parsed.delta_size = 0;
+  }
+  latest = parsed;
+  valid = true;
+  etag[0] = '\0';
+  if(response_etag != NULL && strlen(response_etag) < sizeof(etag) - 1){ //Filled buffer may be truncated, so don't trust it
+    strcpy(etag, response_etag); /* Flawfinder: ignore */
+  }
+  return true;
+}
+
+void UpdateManifest::notModified(){
+  not_modified++;
+}
+
+void UpdateManifest::failed(){
+  failures++;
+}
+
+bool UpdateManifest::isValid(){
+  return valid;
+}
+
+bool UpdateManifest::hasDelta(){
+  return valid && latest.delta_size > 0;
+}
+
+bool UpdateManifest::differsFrom(const char* running_version){
+  return valid && strcmp(latest.version, running_version) != 0;
+}
+
+const char* UpdateManifest::getVersion(){
+  return latest.version;
+}
+
+uint32_t UpdateManifest::getSize(){
+  return latest.size;
+}
+
+const char* UpdateManifest::getMd5(){
+  return latest.md5;
+}
+
+const char* UpdateManifest::getDeltaBase(){
+  return latest.delta_base;
+}
+
+uint32_t UpdateManifest::getDeltaSize(){
+  return latest.delta_size;
+}
+
+void UpdateManifest::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_update_manifest_downloads_total counter\ndctransistor_update_manifest_downloads_total "));
+  out.print(downloads);
+  out.print(F("\n# TYPE dctransistor_update_manifest_not_modified_total counter\ndctransistor_update_manifest_not_modified_total "));
+  out.print(not_modified);
+  out.print(F("\n# TYPE dctransistor_update_manifest_failures_total counter\ndctransistor_update_manifest_failures_total "));
+  out.print(failures);
+  out.print('\n');
+}
+
+// END FUNCTION IMPLEMENTATION
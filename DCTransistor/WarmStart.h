@@ -0,0 +1,231 @@
+#include <Arduino.h>
+
+/*
+    Defines WarmStart class template - the last live frame's line states and special trains (ITT, palette, position), saved
+    to flash so the board can show them within milliseconds of boot instead of sitting dark through WiFi, update
+    and special train checks, and the first full fetch. The first live loop then replaces them.
+
+    Flash wears out, and train positions change every poll, so saves are batched: update() captures each live
+    frame in RAM but only writes when the snapshot changed and at least min_interval_ms has passed since the last
+    write. flush() writes a captured snapshot straight away (before an OTA restart).
+
+    A snapshot is rejected on load if its CRC fails or its shape (lines, directions, station bits) differs from
+    this firmware's - e.g. after an update that changes a line.
+
+    Storage is a template parameter with static read / write of the whole snapshot, so tests can use RAM.
+    LittleFSStore keeps it in one LittleFS file (FlashFile.h), replaced whole so a reset mid-write keeps the old snapshot.
+*/
+
+#define WARM_START_MAGIC 0x5741 //"WA"
+#define WARM_START_FORMAT 2 //Bump when WarmSnapshot layout changes
+#define WARM_SPECIAL_TRAINS MAX_SPECIAL_TRAINS //Special trains kept, so every tracked special train is restored. Changes snapshot size.
+
+#ifndef EPOXY_DUINO
+  //One file on LittleFS (see FlashFile.h)
+  struct LittleFSStore {
+    static bool read(uint8_t* data, size_t len){
+      return readFlashFile(WARM_START_FILE, data, len);
+    }
+    static bool write(const uint8_t* data, size_t len){
+      return writeFlashFile(WARM_START_FILE, WARM_START_FILE ".tmp", data, len);
+    }
+  };
+#endif
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+class WarmStart {
+
+  private:
+    static const uint16_t WORDS = BitSet<MAX_STATIONS>::NUM_WORDS;
+
+    struct WarmSpecial {
+      int16_t id;
+      uint8_t palette;
+      int8_t line; //-1 if special train wasn't on the board
+      uint8_t index;
+      uint8_t dir;
+    };
+
+    struct WarmSnapshot {
+      uint16_t magic;
+      uint8_t format;
+      uint8_t lines;
+      uint8_t directions;
+      uint8_t max_stations;
+      uint8_t num_specials;
+      WarmSpecial specials[WARM_SPECIAL_TRAINS];
+      uint32_t state[LINES][DIRECTIONS][WORDS];
+      uint32_t crc; //Of everything above
+    };
+
+    WarmSnapshot snapshot; //Last loaded or captured
+    bool loaded; //snapshot holds a valid save from flash
+    bool dirty; //Captured but not written
+    uint32_t written_crc; //CRC of snapshot last written or loaded
+    uint32_t last_write; //millis() of last write
+    uint32_t min_interval_ms;
+    uint32_t writes;
+    uint32_t write_failures;
+
+    uint32_t snapshotCrc();
+    bool write();
+
+  public:
+    WarmStart(uint32_t min_interval_ms);
+
+    bool load(); //Read and check saved snapshot. Call once, early in setup().
+
+    //Restore loaded snapshot into lines and specials (SpecialTrains.h). Only valid after load() returned true.
+    template<typename Line, typename Specials>
+    void restore(Line* const lines[], Specials &specials);
+
+    //Capture a live frame. Written if changed and min_interval_ms has passed. Returns true if written.
+    template<typename Line, typename Specials>
+    bool update(Line* const lines[], Specials &specials);
+    bool flush(); //Write captured snapshot now if not yet written
+
+    //Getters
+    bool wasLoaded();
+    uint32_t getWrites();
+
+    void printMetrics(Print &out);
+
+};//END WarmStart definition
+
+
+// FUNCTION IMPLEMENTATION
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::WarmStart(uint32_t min_interval){
+  memset(&snapshot, 0, sizeof(snapshot));
+  loaded = false;
+  dirty = false;
+  written_crc = 0;
+  last_write = 0;
+  min_interval_ms = min_interval;
+  writes = 0;
+  write_failures = 0;
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+uint32_t WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::snapshotCrc(){
+  return crc32((const uint8_t*)&snapshot, offsetof(WarmSnapshot, crc));
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+bool WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::load(){
+  loaded = false;
+  if(!Store::read((uint8_t*)&snapshot, sizeof(snapshot))){
+    return false;
+  }
+
+  loaded = snapshot.magic == WARM_START_MAGIC && snapshot.format == WARM_START_FORMAT
+    && snapshot.lines == LINES && snapshot.directions == DIRECTIONS && snapshot.max_stations == MAX_STATIONS
+    && snapshot.num_specials <= WARM_SPECIAL_TRAINS && snapshot.crc == snapshotCrc();
+
+  if(loaded){
+    written_crc = snapshot.crc; //Don't rewrite the same frame
+  }
+  return loaded;
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+template<typename Line, typename Specials>
+void WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::restore(Line* const lines[], Specials &specials){
+  BitSet<MAX_STATIONS> saved;
+  for(uint8_t l=0; l<LINES; l++){
+    for(uint8_t d=0; d<DIRECTIONS; d++){
+      for(uint16_t w=0; w<WORDS; w++){
+        saved.setWord(w, snapshot.state[l][d][w]);
+      }
+      lines[l]->setState(saved, d);
+    }
+  }
+
+  specials.clear();
+  for(uint8_t i=0; i<snapshot.num_specials; i++){
+    const WarmSpecial &special = snapshot.specials[i];
+    if(specials.add(special.id, special.palette) && special.line >= 0 && special.line < LINES){
+      specials.sight(specials.getCount() - 1, special.line, special.index, special.dir);
+    }
+  }
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+template<typename Line, typename Specials>
+bool WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::update(Line* const lines[], Specials &specials){
+  memset(&snapshot, 0, sizeof(snapshot)); //Zero padding so equal frames have equal CRCs
+  snapshot.magic = WARM_START_MAGIC;
+  snapshot.format = WARM_START_FORMAT;
+  snapshot.lines = LINES;
+  snapshot.directions = DIRECTIONS;
+  snapshot.max_stations = MAX_STATIONS;
+
+  snapshot.num_specials = (specials.getCount() > WARM_SPECIAL_TRAINS) ? WARM_SPECIAL_TRAINS : specials.getCount();
+  for(uint8_t i=0; i<snapshot.num_specials; i++){
+    WarmSpecial &special = snapshot.specials[i];
+    special.id = specials.getId(i);
+    special.palette = specials.getPalette(i);
+    special.line = specials.getLine(i);
+    special.index = specials.getIndex(i);
+    special.dir = specials.getDir(i);
+  }
+
+  for(uint8_t l=0; l<LINES; l++){
+    for(uint8_t d=0; d<DIRECTIONS; d++){
+      const BitSet<MAX_STATIONS> &state = lines[l]->getState(d);
+      for(uint16_t w=0; w<WORDS; w++){
+        snapshot.state[l][d][w] = state.getWord(w);
+      }
+    }
+  }
+
+  snapshot.crc = snapshotCrc();
+  dirty = snapshot.crc != written_crc;
+
+  if(dirty && (writes == 0 || millis() - last_write >= min_interval_ms)){
+    return write();
+  }
+  return false;
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+bool WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::flush(){
+  return dirty && write();
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+bool WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::write(){
+  last_write = millis(); //Failed writes also wait out the interval
+  if(!Store::write((const uint8_t*)&snapshot, sizeof(snapshot))){
+    write_failures++;
+    return false;
+  }
+  written_crc = snapshot.crc;
+  dirty = false;
+  writes++;
+  return true;
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+bool WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::wasLoaded(){
+  return loaded;
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+uint32_t WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::getWrites(){
+  return writes;
+}
+
+template<typename Store, uint8_t LINES, uint8_t DIRECTIONS, uint8_t MAX_STATIONS>
+void WarmStart<Store, LINES, DIRECTIONS, MAX_STATIONS>::printMetrics(Print &out){
+  out.print(F("# TYPE dctransistor_warm_start gauge\ndctransistor_warm_start "));
+  out.print(loaded ? 1 : 0);
+  out.print(F("\n# TYPE dctransistor_warm_start_writes_total counter\ndctransistor_warm_start_writes_total "));
+  out.print(writes);
+  out.print(F("\n# TYPE dctransistor_warm_start_write_failures_total counter\ndctransistor_warm_start_write_failures_total "));
+  out.print(write_failures);
+  out.print('\n');
+}
+
+// END FUNCTION IMPLEMENTATION
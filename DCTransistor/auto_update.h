@@ -1,123 +1,321 @@
 #include "config.h"
+#include "HttpStream.h"
+#include "WallClock.h"
+#include "FlashFile.h"
+#include "CampaignCache.h"
+#include "ConsistIndex.h"
+#include "SpecialTrains.h"
+#include "OtaDownload.h"
+#include "DeltaPatch.h"
+#include "UpdateManifest.h"
+#include "TlsPins.h"
+#include "TlsBuffers.h"
+
+//Static buffers shared by every request and parse, so the steady-state loop never touches the heap.
+StaticJsonDocument<JSON_ARENA_SIZE> json_arena; //Holds one filtered JSON document at a time
+char http_request[HTTP_REQUEST_LEN]; //Formatted GET request
+char http_host[HTTP_HOST_LEN]; //Host of current request
+
+uint32_t tls_handshakes = 0; //TLS connections opened by https_get since boot (shown on metrics endpoint)
+uint32_t tls_handshake_failures = 0;
+
+#define TLS_HOSTS 4
+
+TlsPins<TLS_HOSTS> tls_pins; //Certificate fingerprints of each host (see TlsPins.h)
+TlsBuffers<TLS_HOSTS> tls_buffers; //Receive buffer size each host agreed to (see TlsBuffers.h)
+
+//Pin every host the board connects to, and size its buffers on first connect. Call once in setup, before the first request.
+void add_tls_hosts(){
+  tls_pins.add("api.wmata.com", PSTR(API_WMATA_COM_FINGERPRINTS));
+  tls_pins.add("gis.wmata.com", PSTR(GIS_WMATA_COM_FINGERPRINTS));
+  tls_pins.add("gisservices.wmata.com", PSTR(GISSERVICES_WMATA_COM_FINGERPRINTS));
+  tls_pins.add(UPDATE_HOST, PSTR(RAW_GITHUBUSERCONTENT_COM_FINGERPRINTS), true); //Board that missed several fingerprint updates can still update
+
+  tls_buffers.add("api.wmata.com");
+  tls_buffers.add("gis.wmata.com");
+  tls_buffers.add("gisservices.wmata.com");
+  tls_buffers.add(UPDATE_HOST);
+}
 
-//Download and update to current binary version on github
-void update_arduino(WiFiClientSecure &client, String cur_version){
-
-  client.setFingerprint(RAW_GITHUBUSERCONTENT_COM_FINGERPRINT);
-  
-  if(!client.connect(UPDATE_HOST, HTTPS_PORT)){
-    client.setInsecure(); //Needed in case board has not turned on and downloaded binary with updated github fingerprints
-    client.connect(UPDATE_HOST, HTTPS_PORT);
-  }
-  
-  t_httpUpdate_return ret = ESPhttpUpdate.update(client, UPDATE_BIN_URL);
-
-  #ifdef PRINT
-   switch (ret) {
-      case HTTP_UPDATE_FAILED: Serial.printf("HTTP_UPDATE_FAILED Error (%d): %s\n", ESPhttpUpdate.getLastError(), ESPhttpUpdate.getLastErrorString().c_str()); break;
+//Connect client to host, checking its pins, with the smallest receive buffer it agreed to
+TlsConnectResult tls_connect(WiFiClientSecure &client, const char* host){
+  tls_buffers.prepare(client, host, HTTPS_PORT);
+  TlsConnectResult result = tls_pins.connect(client, host, HTTPS_PORT);
+  tls_buffers.connected(client, host, result == TLS_CONNECTED);
+  return result;
+}
 
-      case HTTP_UPDATE_NO_UPDATES: Serial.println("HTTP_UPDATE_NO_UPDATES"); break;
+#define MAX_SPECIAL_CARS 8 //Cars kept per campaign
 
-      case HTTP_UPDATE_OK: Serial.println("HTTP_UPDATE_OK"); break;
-    } 
-  #endif
+CampaignCache<CampaignFile, MAX_CAMPAIGNS, MAX_SPECIAL_CARS> campaign_cache; //appconfig.json campaigns and their validators, kept in flash
 
-}//END update_arduino
+WallClock wall_clock; //Today's date, mostly from ETIMEs in train feed (see WallClock.h)
 
-//Check GitHub releases for most recent version, compared to value in current software, and update if different.
-void check_for_update(WiFiClientSecure &client){
+typedef DeltaPatch<RunningImage, UpdaterSink> UpdatePatch; //Full image, or delta from running image (see DeltaPatch.h)
+OtaDownload<UpdatePatch> ota; //Firmware update downloaded between frames (see OtaDownload.h)
+bool ota_response_open = false; //client holds the update's Range response, between frames of one wait
+UpdateManifest update_manifest; //Latest release on update host, from last check (see UpdateManifest.h)
+BearSSL::Session update_session; //Last TLS session with update host, so later connections resume it instead of a full handshake
 
-  HTTPClient https;
+//Send a GET for url over client, connecting first if needed (checking url's host against its pins), and read response headers.
+//Copies any of the given response headers into their values (see HttpStream.h). Returns HTTP status code, or -1 on failure.
+//On success, client is positioned at start of response body. Call client.stop() when done.
+int16_t https_get(WiFiClientSecure &client, PGM_P url, PGM_P extra_headers, HttpHeader* headers, uint8_t num_headers){
 
-  //Send HTTP request to /releases/latest on GitHub page, which always returns a 302
-  client.setFingerprint(GITHUB_COM_FINGERPRINT);
-  if(!client.connect(GITHUB_HOST, HTTPS_PORT)){
-    client.setInsecure(); //Needed in case board has not turned on and downloaded binary with updated github fingerprints
-    client.connect(GITHUB_HOST, HTTPS_PORT);
+  uint16_t request_len = formatGetRequest(http_request, sizeof(http_request), http_host, sizeof(http_host), url, extra_headers);
+  if(request_len == 0){
+    #ifdef PRINT
+      Serial.println("Request does not fit in HTTP_REQUEST_LEN");
+    #endif
+    return -1;
   }
 
-  https.begin(client, LATEST_VERSION_URL);
-  https.collectHeaders(github_header_keys, github_num_headers); //collect location header (defined in config)
-  https.GET();
-
-  //Get version based /releases/latest redirecting to /releases/tag/<cur_version>
-  String release_loc = https.header("location");
-  int version_index = release_loc.lastIndexOf("/")+1;
-  String latest_version = release_loc.substring(version_index);
+  if(!client.connected()){
 
-  #ifdef PRINT
-    Serial.printf("Latest release URL: %d\n", release_loc);
-    Serial.printf("Latest version: %s\n", latest_version);
-    Serial.printf("Current version: %s\n", VERSION);
-  #endif
+    //Resolve ahead of connect only to time DNS on its own. connect() then hits lwIP's DNS cache.
+    #ifdef PROFILE
+      IPAddress host_ip;
+      PROFILE_START(dns_timer, PROF_DNS);
+      WiFi.hostByName(http_host, host_ip);
+      PROFILE_STOP(dns_timer);
+    #endif
 
-  //If version doesn't match software's hardcoded version string, trigger update function.
-  if (latest_version != VERSION){
+    PROFILE_START(handshake_timer, PROF_HANDSHAKE);
+    tls_handshakes++;
+    if(tls_connect(client, http_host) != TLS_CONNECTED){
+      tls_handshake_failures++;
       #ifdef PRINT
-        Serial.println("Versions don't match. Updating");
+        Serial.printf("Unable to connect to %s\n", http_host);
       #endif
-      update_arduino(client, latest_version);
+      return -1;
+    }
+    PROFILE_STOP(handshake_timer);
   }
 
-  //https.end();
-}//END check_for_update
+  PROFILE_START(ttfb_timer, PROF_TTFB);
+  if(client.write((const uint8_t*)http_request, request_len) != request_len){
+    client.stop();
+    return -1;
+  }
 
-// Use GIS Services Train Location API to get Epoch Time (technically Epoch of most recent position update on first train object). Returns 0 on error.
-time_t get_todays_date(WiFiClientSecure &client){
+  int16_t status = readHttpStatus(client);
+  PROFILE_STOP(ttfb_timer);
+  readHttpHeaders(client, headers, num_headers);
+  return status;
+}
 
+//As above, collecting at most one response header: if header_name given, copies it into header_value.
+int16_t https_get(WiFiClientSecure &client, PGM_P url, PGM_P extra_headers, const char* header_name = NULL, char* header_value = NULL, uint16_t header_value_len = 0){
+  HttpHeader header = {header_name, header_value, header_value_len};
+  return https_get(client, url, extra_headers, &header, (header_name == NULL) ? 0 : 1);
+}
 
-  HTTPClient https;
-  https.useHTTP10(true);
 
-  #ifdef PRINT
-    Serial.println("GETTING TODAY'S DATE");
-  #endif
+//Connect client to update host, resuming the last session with it. Counted with https_get's handshakes.
+//Callers give up on a failed connect rather than let https_get make a second handshake without the session.
+TlsConnectResult connect_update_host(WiFiClientSecure &client){
+  client.setSession(&update_session);
+  tls_handshakes++;
+  TlsConnectResult result = tls_connect(client, UPDATE_HOST);
+  client.setSession(NULL); //Handshakes with other hosts would overwrite it
+  if(result != TLS_CONNECTED){
+    tls_handshake_failures++;
+    #ifdef PRINT
+      Serial.printf("Unable to connect to %s\n", UPDATE_HOST);
+    #endif
+  }
+  return result;
+}
+
+bool delta_failed = false; //A delta failed to download or apply this boot, so updates use the full image
 
-  //Get today's date based on DATE_TIME values returned in train positions API
-  client.setFingerprint(GISSERVICES_WMATA_COM_FINGERPRINT);
+//Start downloading the manifest's version in the background (see ota_slice). If the published delta was made from
+//the image running now, download and apply that instead of the full image. Returns false if no download started.
+bool update_arduino(){
 
-  if(!https.begin(client, GIS_TRAIN_LOC_ENDPOINT)){
+  bool patching = !delta_failed && update_manifest.hasDelta() && RunningImage::hasMd5(update_manifest.getDeltaBase());
+  if(!ota.begin(patching ? "" : update_manifest.getMd5())){ //Target's MD5 is in the delta header
     #ifdef PRINT
-      Serial.printf("Unable to connect to WMATA Train Locations Endpoint\n");
+      Serial.printf("Update to %s not started\n", update_manifest.getVersion());
     #endif
+    return false; //Sink is left as it is, in case a download is already using it
   }
+  UpdatePatch::setPatching(patching);
 
-  https.begin(client, GIS_TRAIN_LOC_ENDPOINT);
-  int response = https.GET();
+  #ifdef PRINT
+    Serial.printf("Update to %s: downloading %s\n", update_manifest.getVersion(), patching ? "delta" : "full image");
+  #endif
+  return true;
 
-  //HTTP Response Error Handling
-  if(response < 200 || response >= 400){
+}//END update_arduino
+
+//Read the next slice of a background update into flash. Called between frames: takes at most OTA_SLICE_BYTES,
+//and only waits for bytes (up to OTA_SLICE_MS) when none have arrived yet. The Range response stays open on client
+//until ota_pause(), and the next slice after that asks for the rest of the image from where this one stopped.
+void ota_slice(WiFiClientSecure &client){
+
+  //A delta that didn't apply (wrong size, failed write or copy, or wrong MD5 after patching) would fail the same way
+  //again. Fall back to the full image now, rather than at the next update check.
+  if(ota.getState() == OTA_FAILED && UpdatePatch::isPatching()){
     #ifdef PRINT
-        Serial.printf("HTTP Response Code %d\n", response);
-        Serial.printf("HTTP Body Size: %d\n", https.getSize());
+      Serial.printf("Update delta failed. Downloading full image\n");
     #endif
-    return 0;
+    delta_failed = true;
+    UpdatePatch::setPatching(false);
+    update_arduino();
   }
 
-  //First four "ETIME" strings are in document headers. Fifth gets to first acutal EPOCH Time reference.
-  for(uint8_t i=0; i<5; i++){
-    client.find("\"ETIME\":");
+  if(!ota.isActive()){
+    return;
   }
+  uint32_t slice_start = millis();
+
+  //Once every byte has arrived, slices only finish writing (e.g. the end of a delta copy)
+  if(!ota_response_open && ota.needsInput()){
+    if(connect_update_host(client) != TLS_CONNECTED){
+      client.stop();
+      ota.interrupted(); //Resume from the same offset next slice
+      ota.noteSlice(millis() - slice_start);
+      return;
+    }
+
+    char range[32]; /* Flawfinder: ignore */
+    snprintf_P(range, sizeof(range), PSTR("Range: bytes=%u-\r\n"), (unsigned int)ota.getOffset());
+    char content_range[48] = {0}; /* Flawfinder: ignore */ //Not filled in if https_get fails before headers
+    char content_length[16] = {0}; /* Flawfinder: ignore */
+    HttpHeader headers[2] = {{"Content-Range", content_range, sizeof(content_range)}, {"Content-Length", content_length, sizeof(content_length)}};
+    int16_t status = https_get(client, UpdatePatch::isPatching() ? PSTR(UPDATE_DELTA_URL) : PSTR(UPDATE_BIN_URL), range, headers, 2);
+
+    //Connection or server trouble says nothing about the image. Keep what's written and resume on the next slice.
+    if(status < 0 || status >= 500){
+      #ifdef PRINT
+        Serial.printf("Update response %d at offset %u. Resuming next slice\n", status, (unsigned int)ota.getOffset());
+      #endif
+      client.stop();
+      ota.interrupted();
+      ota.noteSlice(millis() - slice_start);
+      return;
+    }
+
+    //206 with "bytes <first>-<last>/<size>" from where the last slice stopped, or 200 with the whole image if nothing is written yet
+    uint32_t image_size = 0;
+    const char* slash = strchr(content_range, '/');
+    if(status == 206 && slash != NULL && strtoul(content_range + 6, NULL, 10) == ota.getOffset()){
+      image_size = strtoul(slash + 1, NULL, 10);
+    }
+    else if(status == 200 && ota.getOffset() == 0){
+      image_size = strtoul(content_length, NULL, 10);
+    }
+
+    //Manifest gave the size of what's being downloaded. A different one is another release, or not the image at all.
+    uint32_t expected_size = UpdatePatch::isPatching() ? update_manifest.getDeltaSize() : update_manifest.getSize();
+    if(image_size != expected_size || !ota.setSize(image_size)){
+      #ifdef PRINT
+        Serial.printf("Update response %d (%s) unusable at offset %u\n", status, content_range, (unsigned int)ota.getOffset());
+      #endif
+      client.stop();
+      ota.fail();
+      ota.noteSlice(millis() - slice_start);
+      return;
+    }
+    ota_response_open = true;
+  }
+
+  uint16_t budget = OTA_SLICE_BYTES;
+  while(budget > 0 && ota.isActive() && millis() - slice_start < OTA_SLICE_MS){
+    uint16_t n = ota.receive(client, budget);
+    budget -= n;
+    if(n == 0){
+      if(budget < OTA_SLICE_BYTES || !client.connected()){
+        break;
+      }
+      delay(1);
+    }
+  }
+
+  if(ota_response_open && !ota.needsInput()){
+    client.stop(); //Every byte is in: ready, failed, or still writing the end
+    ota_response_open = false;
+  }
+  else if(ota_response_open && !client.connected() && client.available() == 0){
+    client.stop(); //Dropped before image ended
+    ota_response_open = false;
+    ota.interrupted();
+  }
+
+  ota.noteSlice(millis() - slice_start);
+
+}//END ota_slice
+
+//Close an update response left open by ota_slice, so client is free for the next train feed poll. Next slice resumes.
+void ota_pause(WiFiClientSecure &client){
+  if(ota_response_open){
+    client.stop();
+    ota_response_open = false;
+    ota.interrupted();
+  }
+}
+
+//Check update manifest for most recent version, compared to value in current software, and update if different.
+void check_for_update(WiFiClientSecure &client){
+
+  PROFILE_SCOPE(PROF_CHECK_UPDATE);
+
+  //Ask for the manifest only if it changed since the last check. "If-None-Match: " + MANIFEST_ETAG_LEN always fits.
+  char manifest_headers[80]; /* Flawfinder: ignore */
+  uint16_t headers_len = update_manifest.appendConditionalHeaders(manifest_headers, 0, sizeof(manifest_headers));
+  manifest_headers[headers_len] = '\0';
+
+  char etag[MANIFEST_ETAG_LEN]; /* Flawfinder: ignore */
+  HttpHeader manifest_response_headers[1] = {{"etag", etag, sizeof(etag)}};
+  int16_t response = -1; //Failed connect counts as a failed check. Last manifest is still used below.
+  if(connect_update_host(client) == TLS_CONNECTED){
+    response = https_get(client, PSTR(UPDATE_MANIFEST_URL), manifest_headers, manifest_response_headers, 1);
+  }
+  if(response == 304){
+    update_manifest.notModified();
+  }
+  else if(response == 200){
+    update_manifest.parse(client, etag);
+  }
+  else{
+    update_manifest.failed();
+  }
+  client.stop();
+
+  #ifdef PRINT
+    Serial.printf("Update manifest: HTTP %d, latest version %s\n", response, update_manifest.getVersion());
+    Serial.printf("Current version: %s\n", VERSION);
+  #endif
 
-  //Use bytes in stream to get Epoch Time and parse to time_t variable
-  char time_string_buf[50] = {0}; /*FlawFinder: Ignore */
-  client.readBytesUntil(',', time_string_buf, 50);
-  time_t time = strtoll(time_string_buf, NULL, 0);
+  //If version doesn't match software's hardcoded version string, trigger update function. Ignore failed lookups,
+  //and new versions seen while an update is still downloading or waiting to reboot.
+  if (update_manifest.differsFrom(VERSION) && !ota.isActive() && !ota.isReady()){
+      #ifdef PRINT
+        Serial.println("Versions don't match. Updating");
+      #endif
+      update_arduino();
+  }
 
-  // Code from using ArduinoJson. Caused memory issues.
-  //Filter to only relevant data (set in setup function)
-  // uint16_t json_size = 6044;
-  // DynamicJsonDocument doc(json_size);
-  // DeserializationError error = deserializeJson(doc, https.getStream(), DeserializationOption::Filter(date_time_filter), DeserializationOption::NestingLimit(14)) ;
+}//END check_for_update
 
-  // const time_t time = doc["features"][0]["attributes"]["ETIME"].as<const time_t>();
+//Milliseconds since Unix epoch from SNTP-synced clock (configTime in setup), or 0 if clock hasn't synced yet.
+uint64_t sntp_epoch_ms(){
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  if(now.tv_sec < CLOCK_VALID_AFTER){
+    return 0;
+  }
+  return ((uint64_t)now.tv_sec * 1000) + (now.tv_usec / 1000);
+}
 
-  // doc.clear();
+// Today's date as epoch seconds: newest ETIME from train feed, else SNTP, else last Date header seen. Returns 0 if none yet.
+time_t get_todays_date(){
 
-  https.end();
+  time_t time = wall_clock.epochMs(sntp_epoch_ms()) / 1000;
 
   #ifdef PRINT
-    Serial.printf("Returning today's date as epoch time: %lld\n", time);
+    Serial.printf("Returning today's date as epoch time: %lld (clock source %d)\n", (long long)time, wall_clock.getSource());
   #endif
 
   return time;
@@ -174,8 +372,14 @@ time_t parse_config_date(const char* date){
   // return datetime;
 }
 
-// Get TrainID for special train cars. Return -1 if error
-int16_t get_special_train_id(WiFiClientSecure &client, uint16_t* special_cars, uint8_t num_special_cars){
+// Get TrainID (ITT) of each special train's cars, in one pass over the special train endpoint. ids[i] is -1 if set i's train
+// wasn't found. Returns how many were found.
+uint8_t get_special_train_ids(WiFiClientSecure &client, CarSet<MAX_SPECIAL_CARS>* special_car_sets, uint8_t num_sets, int16_t* ids){
+
+  uint8_t num_found = 0;
+  for(uint8_t i=0; i<num_sets; i++){
+    ids[i] = -1;
+  }
 
   // StaticJsonDocument<112> special_train_filter;
   // special_train_filter["DataTable"]["diffgr:diffgram"]["DocumentElement"]["CurrentConsists"][0]["Cars"] = true; //Get DateTime from Special Train endpoint
@@ -186,34 +390,23 @@ int16_t get_special_train_id(WiFiClientSecure &client, uint16_t* special_cars, u
   chunk_filter["LinkTti"] = true;
   chunk_filter["Cars"] = true;
 
-  HTTPClient https;
-  https.useHTTP10(true);
-
   #ifdef PRINT
     Serial.println("Getting TrainID for Special Train");
   #endif
 
   //Get train information from WMATA special train endpoint
-  client.setFingerprint(GIS_WMATA_COM_FINGERPRINT);
+  int response = https_get(client, PSTR(GIS_SPECIAL_TRAIN_ENDPOINT), PSTR("Accept-Encoding: gzip, deflate\r\nAccept: application/json,text/html\r\n"));
 
-    if(!https.begin(client, GIS_SPECIAL_TRAIN_ENDPOINT)){
+  if(response < 0){
     #ifdef PRINT
       Serial.printf("Unable to connect to Special Train WMATA Endpoint\n");
     #endif
-    return -1;
+    return 0;
   }
 
-  //Get Train data from Special Train endpoint
-  https.begin(client, GIS_SPECIAL_TRAIN_ENDPOINT);
-  https.addHeader("Accept-Encoding", "gzip, deflate");
-  https.addHeader("Accept", "application/json,text/html");
-  int response = https.GET();
-
-  //Use chunk filtering to only deserialize one train object at a time
+  //Use chunk filtering to only deserialize one train object at a time, into shared static document
   // https://arduinojson.org/v6/how-to/deserialize-a-very-large-document/
-  uint16_t json_size = 1024;
-  DynamicJsonDocument doc(json_size);
-  const char* delimiters = ".-"; //For parsing Cars string
+  JsonDocument &doc = json_arena;
 
   //Only load each train object into a JSON document at a time to preserve RAM by iterating through TCP stream.
   //WifiClient is actual consistent source of https stream. 
@@ -225,12 +418,10 @@ int16_t get_special_train_id(WiFiClientSecure &client, uint16_t* special_cars, u
     if (error) {
       #ifdef PRINT
         Serial.printf("JSON Deserialization Failed: %s\n", error.f_str());
-        Serial.printf("Intended JSON Document Size: %d\n", json_size);
         Serial.printf("JSON Doc Size: %d\n", doc.size());
         Serial.printf("Actual JSON Document Size: %d\n", doc.capacity());
         Serial.printf("HTTP Response Code %d\n", response);
-        Serial.printf("HTTP Body Size: %d\n", https.getSize());
-        Serial.printf("Overflowed? %s\n", doc.overflowed());
+        Serial.printf("Overflowed? %d\n", doc.overflowed());
       #endif
     }
 
@@ -244,93 +435,49 @@ int16_t get_special_train_id(WiFiClientSecure &client, uint16_t* special_cars, u
       }
       const char* cars = doc["Cars"].as<const char*>();
 
-      uint8_t car_match_count = 0;
-
-      //Setup tokenization of car string
-      char tmp_car_string[50] = {0}; /*FlawFinder: Ignore */ 
-      strncpy(tmp_car_string, cars, strlen(cars)+1); /*FlawFinder: Ignore */
-
-      //Loop through each Car ID in train string. See if each car is a special train car and increment count if so. 
-      //If not, break and move to next train
-      char* token = strtok(tmp_car_string, delimiters);
-      while(token != NULL){
-
-        bool match = false;
-        uint16_t car_num = atoi(token); /*FlawFinder: Ignore */
-
-        for(uint8_t i=0; i < num_special_cars; i++){
-          if(car_num == special_cars[i]){
-            car_match_count++;
-            match = true; 
-            break;
-          }
-        }
+      // If all the cars match a special train's cars, we have that special train's ID :)
+      for(uint8_t i=0; i<num_sets; i++){
+        if(ids[i] == -1 && special_car_sets[i].matches(cars)){
+          ids[i] = train_id;
+          num_found++;
 
-        if(!match){
+          #ifdef PRINT
+            Serial.printf("Found special train id %d with cars %s\n", train_id, cars);
+          #endif
           break;
         }
-
-        token = strtok(NULL, delimiters);
       }
 
-      // If all the cars match the special train cars, we have the special train ID :)
-      if(car_match_count == num_special_cars){
-
-        doc.clear();
-        https.end();
-
-        #ifdef PRINT
-          Serial.printf("Found special train id %d with cars %s\n", train_id, cars);
-        #endif
+      doc.clear();
 
-        return train_id;
+      if(num_found == num_sets){
+        client.stop();
+        return num_found;
       }
-
-      doc.clear();
     }//end if no DeserializationError
 
+    YIELD_POINT();
+
   } while (client.findUntil("," , "]"));
 
-  https.end();
+  doc.clear();
+  client.stop();
 
-  return -1;
+  return num_found;
 }
 
-//Check WMATA Data If Special Train in place. Returns TrainID for special train or -1 if no special train.
-int16_t check_for_special_train(WiFiClientSecure &client){
-
-  #ifdef PRINT
-    Serial.println("Beginning WMATA Config File Parsing");
-  #endif
-
-  uint16_t special_train_id = -1;
-  const time_t today = get_todays_date(client);
+//Parse campaigns from a 200 appconfig.json response on client into campaign_cache, with the response's validators.
+//On a parse error the cached list is kept.
+void parse_campaigns(WiFiClientSecure &client, const char* etag, const char* last_modified, time_t today){
 
   StaticJsonDocument<120> config_filter;
   config_filter["prd_settings"]["special"]["campaigns"][0]["start"] = true;
   config_filter["prd_settings"]["special"]["campaigns"][0]["end"] = true;
   config_filter["prd_settings"]["special"]["campaigns"][0]["cars"] = true;
 
-  HTTPClient https;
-  https.useHTTP10(true);
-
-  // Connect to GIS Config File to get campaign info on special trains
-  client.setFingerprint(GIS_WMATA_COM_FINGERPRINT);
-  if(!https.begin(client, GIS_CONFIG_ENDPOINT)){
-    #ifdef PRINT
-      Serial.printf("Unable to connect to WMATA GIS Configuration File\n");
-    #endif
-  }
-
-  https.begin(client, GIS_CONFIG_ENDPOINT);
-  https.addHeader("Accept-Encoding", "gzip, deflate");
-  https.addHeader("Accept", "application/json,text/html");
-  int response = https.GET();
-
-  //Discard junk characters at start of response
-  char *tmp = (char*)malloc(10 * sizeof(char));
-  https.getStream().readBytes(tmp, 3); 
-  free(tmp);
+  //Discard junk characters (UTF-8 byte order mark) at start of response
+  char tmp[3]; /* Flawfinder: ignore */
+  client.readBytes(tmp, sizeof(tmp));
 
   // Old code to troubleshoot byte stream
   // for (uint8_t i=0; i<49; i++){
@@ -338,74 +485,135 @@ int16_t check_for_special_train(WiFiClientSecure &client){
   // }
   // Serial.println(tmp);
 
-  //Filter to only relevant data (set at top of function)
-  uint16_t json_size = 2048;
-  DynamicJsonDocument doc(json_size);
-  DeserializationError error = deserializeJson(doc, https.getStream(), DeserializationOption::Filter(config_filter));
+  //Filter to only relevant data (set at top of function), into shared static document
+  JsonDocument &doc = json_arena;
+  DeserializationError error = deserializeJson(doc, client, DeserializationOption::Filter(config_filter));
+  client.stop();
 
   if (error) {
     #ifdef PRINT
       Serial.printf("JSON Deserialization Failed: %s\n", error.f_str());
-      Serial.printf("Intended JSON Document Size: %d\n", json_size);
       Serial.printf("JSON Doc Size: %d\n", doc.size());
       Serial.printf("Actual JSON Document Size: %d\n", doc.capacity());
-      Serial.printf("HTTP Response Code %d\n", response);
-      Serial.printf("HTTP Body Size: %d\n", https.getSize());
-      Serial.printf("Overflowed? %s\n", doc.overflowed());
+      Serial.printf("Overflowed? %d\n", doc.overflowed());
     #endif
-    return -1;
+    doc.clear();
+    return;
   }
 
-  https.end();
-
-  uint16_t special_cars[8] = {0, 0, 0, 0, 0, 0, 0, 0};
-  uint8_t num_special_cars = 0;
-
-  //For each campaign, get dates for campaign, check if current date is within those dates, and get the train cars for the campaign if so
+  //Replace cached list with every campaign that hasn't ended
+  campaign_cache.begin(etag, last_modified);
   for(JsonObject campaign : doc["prd_settings"]["special"]["campaigns"].as<JsonArray>()){
 
-    const char* start_date = campaign["start"].as<const char*>();
-    const char* end_date = campaign["end"].as<const char*>();
     JsonArray cars = campaign["cars"].as<JsonArray>();
+    uint16_t campaign_car_ids[MAX_SPECIAL_CARS];
+    uint8_t num_cars = (cars.size() > MAX_SPECIAL_CARS) ? MAX_SPECIAL_CARS : cars.size();
+    for(uint8_t i=0; i<num_cars; i++){
+      campaign_car_ids[i] = cars[i].as<uint16_t>();
+    }
+
+    const time_t start = parse_config_date(campaign["start"].as<const char*>());
+    const time_t end = parse_config_date(campaign["end"].as<const char*>());
 
     #ifdef PRINT
-      Serial.printf("Comparing start day %lld, today %lld and end day %lld\n", parse_config_date(start_date), today, parse_config_date(end_date));
+      Serial.printf("Caching campaign from %lld to %lld with %d cars\n", (long long)start, (long long)end, num_cars);
     #endif
 
-    // If within the range for a campaign, get the train cars from that campaign and break loop
-    if( parse_config_date(start_date) <= today && today <= parse_config_date(end_date)){
+    if(!campaign_cache.add(start, end, campaign_car_ids, num_cars, today)){
+      break; //Full. Keep MAX_CAMPAIGNS.
+    }
+  }
+  doc.clear();
 
-      num_special_cars = cars.size();
+  campaign_cache.save();
+}
 
-      for(uint8_t i=0; i<num_special_cars; i++){
+//Check WMATA Data for special trains running today, and replace specials with the TrainID (ITT) of each one found.
+//Each active campaign's train gets the next palette in SPECIAL_PALETTES. Returns how many were found.
+uint8_t check_for_special_trains(WiFiClientSecure &client, SpecialTrains<MAX_SPECIAL_TRAINS> &specials){
 
-        special_cars[i] = cars[i].as<uint16_t>();
+  PROFILE_SCOPE(PROF_CHECK_SPECIAL);
 
-        #ifdef PRINT
-          Serial.printf("%d,",special_cars[i]);
-        #endif
+  #ifdef PRINT
+    Serial.println("Beginning WMATA Config File Parsing");
+  #endif
 
-      }
+  //Ask for appconfig.json only if it changed since cached campaigns were downloaded
+  char config_headers[192]; /* Flawfinder: ignore */
+  uint16_t headers_len = appendHttpText(config_headers, 0, sizeof(config_headers), PSTR("Accept-Encoding: gzip, deflate\r\nAccept: application/json,text/html\r\n"));
+  headers_len = campaign_cache.appendConditionalHeaders(config_headers, headers_len, sizeof(config_headers));
+  if(headers_len >= sizeof(config_headers)){
+    specials.clear();
+    return 0; //Never send a cut-off header. Can't happen with CAMPAIGN_ETAG_LEN / CAMPAIGN_LAST_MODIFIED_LEN.
+  }
+  config_headers[headers_len] = '\0';
 
-      #ifdef PRINT
-        Serial.println();
-      #endif
+  //Keep Date header in case neither train feed nor SNTP has set the clock yet
+  char date_header[40] = {0}; /* Flawfinder: ignore */
+  char etag[CAMPAIGN_ETAG_LEN]; /* Flawfinder: ignore */
+  char last_modified[CAMPAIGN_LAST_MODIFIED_LEN]; /* Flawfinder: ignore */
+  HttpHeader config_response_headers[3] = {{"date", date_header, sizeof(date_header)}, {"etag", etag, sizeof(etag)}, {"last-modified", last_modified, sizeof(last_modified)}};
 
-      break;
-    }
+  // Connect to GIS Config File to get campaign info on special trains
+  int response = https_get(client, PSTR(GIS_CONFIG_ENDPOINT), config_headers, config_response_headers, 3);
+  if(date_header[0] != '\0'){
+    wall_clock.setFromHttpDate(date_header);
+  }
+  const time_t today = get_todays_date();
 
+  if(response == 304){
+    client.stop();
+    campaign_cache.notModified();
+    #ifdef PRINT
+      Serial.println("WMATA GIS Configuration File not modified. Using cached campaigns");
+    #endif
+  }
+  else if(response != 200){
+    client.stop();
+    #ifdef PRINT
+      Serial.printf("Unable to get WMATA GIS Configuration File (HTTP %d). Using cached campaigns\n", response);
+    #endif
+  }
+  else{
+    parse_campaigns(client, etag, last_modified, today);
+  }
+
+  //Evaluate campaign dates locally, and collect cars of each campaign running today
+  CarSet<MAX_SPECIAL_CARS> special_car_sets[MAX_SPECIAL_TRAINS];
+  uint8_t num_active = campaign_cache.countActive(today);
+  if(num_active > MAX_SPECIAL_TRAINS){
+    num_active = MAX_SPECIAL_TRAINS;
+  }
+  for(uint8_t i=0; i<num_active; i++){
+    uint16_t cars[MAX_SPECIAL_CARS];
+    uint8_t num_cars = campaign_cache.activeCars(today, cars, i);
+    special_car_sets[i].set(cars, num_cars);
+
+    #ifdef PRINT
+      Serial.printf("Active campaign %d cars: ", i);
+      for(uint8_t c=0; c<num_cars; c++){
+        Serial.printf("%d,", cars[c]);
+      }
+      Serial.println();
+    #endif
   }
-  doc.clear();
 
   // If there are active special cars (set if date within campaign dates), get the TrainId for those cars
-  if(num_special_cars > 0){
-    special_train_id = get_special_train_id(client, special_cars, num_special_cars);
+  int16_t ids[MAX_SPECIAL_TRAINS];
+  if(num_active > 0){
+    get_special_train_ids(client, special_car_sets, num_active, ids);
+  }
+
+  //Palette from each campaign's place in appconfig.json, so a train keeps its colors when other campaigns start or end.
+  //Add() skips trains that weren't found (-1).
+  specials.clear();
+  for(uint8_t i=0; i<num_active; i++){
+    specials.add(ids[i], campaign_cache.activeIndex(today, i) % NUM_SPECIAL_PALETTES);
   }
 
   #ifdef PRINT
-    Serial.printf("Out of Special Train. Special Train ID: %d\n", special_train_id);
+    Serial.printf("Out of Special Train. Special Trains: %d\n", specials.getCount());
   #endif
 
-  // Return -1 or TrainId from above
-  return special_train_id;
-}
\ No newline at end of file
+  return specials.getCount();
+}
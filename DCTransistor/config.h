@@ -17,7 +17,11 @@
 #include <ESP8266WiFi.h>
 #include <ESP8266HTTPClient.h>
 #include <ESP8266httpUpdate.h>
+#include <ESP8266WebServer.h>
 #include <time.h>
+#include <Schedule.h>
+#include <LittleFS.h>
+#include "FlashData.h"
 
 //Version string. Changes with every software version
 #define VERSION "2.0.76"
@@ -32,11 +36,29 @@
 //Uncomment below line to print program text output to Serial output (requires attaching board to computer via USB cable)
 //#define PRINT
 
+//Uncomment below line to time each phase of setup and loop into histograms (see LoopProfiler.h). Report printed to Serial.
+//#define PROFILE
+
+//Structured debug log (see BinaryLog.h), sent to Serial in binary without blocking loop(). Decode with misc_files/decode_log.py.
+//LOG_LEVEL_NONE, LOG_LEVEL_ERROR, LOG_LEVEL_WARN, LOG_LEVEL_INFO or LOG_LEVEL_DEBUG (one record per train)
+#define LOG_LEVEL LOG_LEVEL_NONE
+#define LOG_RING_BYTES 1024 //Bytes of log ring buffer (power of 2, 16 per record). Records are dropped and counted when full.
+#define LOG_DRAIN_US 5000 //How often the scheduler drains the log ring to Serial
+
+//Instrumentation headers check the debug values above when included, so they come after them
+#include "LoopProfiler.h"
+#include "YieldMonitor.h"
+#include "BinaryLog.h"
+
 //Set wait times for different (roughly) time-based events
 #define WAIT_SEC 1 //Number of seconds to wait between requests to WMATA server (WMATA updates every ~20, per documentation)
 #define CYCLES_AT_END 120 //Set high so that it doesn't overwrite trains at start of opp. direction. Number of cycles to keep LED for last train on after arrival
 #define SPECIAL_TRAIN_CHECK_HOURS 1 //Number of hours to see if there is a new TrainID for special train (updates every day or so)
 #define UPDATE_CHECK_HOURS 24 //Number of hours to see if new board update
+#define FEED_STUCK_FAILURES 30 //Failed polls in a row after which background checks run without live trains, so a board with a broken feed can still update itself
+#define FEED_STUCK_SEC 600 //Seconds after boot to run background checks even if live trains were never shown
+#define OTA_SLICE_BYTES 4096 //Most update bytes written to flash between two frames (one flash sector)
+#define OTA_SLICE_MS 250 //Stop reading a slice's response after this long, even if fewer bytes arrived
 
 //Name of WiFi Network (SSID) Board Creates when unable to connect to wifi
 #define WIFI_NAME "DCTransistor"
@@ -44,6 +66,15 @@
 
 // ----  LED Configuration Values ----
 #define LED_BRIGHTNESS 3 //Range of 0-100. Can get very bright very fast
+#define MULTIPLEX_SHARED_STATIONS false //If true and multiple lines have a train at the same station, cycle through each line's color every frame. If false (as before), first line in all_lines wins.
+#define LED_POWER_BUDGET_MA 500 //Max estimated current (mA) for all LEDs. Frames over budget are dimmed to fit. Set to supply rating minus ~100mA for the ESP8266.
+#define FADE_MS 1000 //Milliseconds each color is shown for at shared stations and special trains (second half is a crossfade to the next color)
+
+//Gamma correction for each color channel, in tenths (10 = linear, 22 = 2.2). Applied with brightness when LEDs are drawn.
+//Linear matches the original colors. At low LED_BRIGHTNESS, higher gamma darkens mixed colors (e.g. orange) towards their main channel.
+#define GAMMA_RED_X10 10
+#define GAMMA_GREEN_X10 10
+#define GAMMA_BLUE_X10 10
 
 //Define LED color for each train line. Defined as WWRRGGBB values where white (first byte) is always set to 0.
 //Pick own colors using a tool like https://www.w3schools.com/colors/colors_picker.asp
@@ -64,19 +95,31 @@
 
 // Holidays Special Trains
 // #define SPECIAL_TRAIN_HEX_COUNT 2
-// const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] = {RD_HEX_COLOR, GN_HEX_COLOR};
+// const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] FLASH_TABLE = {RD_HEX_COLOR, GN_HEX_COLOR};
 
 // 4th of July Special Trains
 #define SPECIAL_TRAIN_HEX_COUNT 3
-const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] = {RD_HEX_COLOR, SV_HEX_COLOR, BL_HEX_COLOR};
+const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] FLASH_TABLE = {RD_HEX_COLOR, SV_HEX_COLOR, BL_HEX_COLOR};
 
 // Pride Special Train
 // #define SPECIAL_TRAIN_HEX_COUNT 8
-// const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] = {RD_HEX_COLOR, OR_HEX_COLOR, YL_HEX_COLOR, GN_HEX_COLOR, BL_HEX_COLOR, PURPLE_HEX_COLOR, TEAL_HEX_COLOR, PINK_HEX_COLOR}; //Pride
+// const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] FLASH_TABLE = {RD_HEX_COLOR, OR_HEX_COLOR, YL_HEX_COLOR, GN_HEX_COLOR, BL_HEX_COLOR, PURPLE_HEX_COLOR, TEAL_HEX_COLOR, PINK_HEX_COLOR}; //Pride
 
 // Cherry Blossom Special Train
 //#define SPECIAL_TRAIN_HEX_COUNT 1
-//const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] = {CH_BLOSSOM_HEX_COLOR};
+//const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] FLASH_TABLE = {CH_BLOSSOM_HEX_COLOR};
+
+// More special trains at the same time (e.g. several themed trains during an event). Each active campaign's train gets
+// the next palette, in the order campaigns are listed in appconfig.json, starting over if there are more trains than palettes.
+#define SPECIAL_TRAIN_2_HEX_COUNT 2
+const uint32_t SPECIAL_TRAIN_2_HEX[SPECIAL_TRAIN_2_HEX_COUNT] FLASH_TABLE = {RD_HEX_COLOR, GN_HEX_COLOR}; //Holidays
+#define SPECIAL_TRAIN_3_HEX_COUNT 1
+const uint32_t SPECIAL_TRAIN_3_HEX[SPECIAL_TRAIN_3_HEX_COUNT] FLASH_TABLE = {CH_BLOSSOM_HEX_COLOR}; //Cherry Blossom
+
+#define NUM_SPECIAL_PALETTES 3
+const uint32_t* const SPECIAL_PALETTES[NUM_SPECIAL_PALETTES] = {SPECIAL_TRAIN_HEX, SPECIAL_TRAIN_2_HEX, SPECIAL_TRAIN_3_HEX};
+const uint8_t SPECIAL_PALETTE_COUNTS[NUM_SPECIAL_PALETTES] = {SPECIAL_TRAIN_HEX_COUNT, SPECIAL_TRAIN_2_HEX_COUNT, SPECIAL_TRAIN_3_HEX_COUNT};
+#define MAX_SPECIAL_TRAINS 4 //Special trains tracked at once. Each is one overlay LED (Compositor's MAX_OVERLAY_LEDS) and one warm start snapshot entry.
 
 
 
@@ -85,8 +128,40 @@ const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] = {RD_HEX_COLOR, SV_HE
 */
 
 //JSON document sizes must be predefined, and may need to be increased if amount of data increases
-#define JSON_FILTER_SIZE 120 //Bytes of filter to apply to JSON data returned from WMATA
+#define JSON_FILTER_SIZE 128 //Bytes of filter to apply to JSON data returned from WMATA
 #define JSON_DOC_SIZE 1024 //Bytes of parsed and filtered JSON data returned from WMATA (All trian line, position, and circuitIDs). 8096 -> 8096. 20000 -> 0 HTTP:22820 16000 -> 16000
+#define CONFIG_JSON_DOC_SIZE 2048 //Bytes of filtered special train campaigns from appconfig.json
+#define JSON_ARENA_SIZE ((CONFIG_JSON_DOC_SIZE > JSON_DOC_SIZE) ? CONFIG_JSON_DOC_SIZE : JSON_DOC_SIZE) //One static document shared by every parse, so none use the heap
+
+//Heap telemetry (see HeapTelemetry.h). Use low-water marks to size JSON documents and TLS buffers above.
+#define HEAP_TELEMETRY_SAMPLES 32 //Heap samples kept in ring buffer (4 per loop, plus one at boot)
+#define HEAP_REPORT_LOOPS 60 //Print heap report to Serial every this many loops (PRINT only)
+#define PROFILE_REPORT_LOOPS 60 //Print timing histograms to Serial every this many loops (PROFILE only)
+
+//Metrics endpoint (see MetricsPage.h). Prometheus text at http://<board ip>:METRICS_PORT/metrics
+#define METRICS_PORT 80
+#define PROFILE_PAGE_LEN 2048 //Bytes of preformatted /profile page (PROFILE only)
+
+//SNTP clock, used to measure data freshness (WMATA position time to LED update)
+#define NTP_SERVER_1 "pool.ntp.org"
+#define NTP_SERVER_2 "time.nist.gov"
+#define CLOCK_VALID_AFTER 1700000000 //Epoch seconds. Clock reads earlier than this until SNTP has synced.
+
+//Flight recorder (see FlightRecorder.h). Last loops before a reset, read back at /flight after reboot.
+#define FLIGHT_RECORDS 16 //Loops kept in RTC user memory (16 bytes each, max 23)
+#define FLIGHT_PAGE_LEN 1536 //Bytes of preformatted /flight page
+
+//Yield monitor (see YieldMonitor.h). Longest time between yields in each phase is on /metrics.
+#define YIELD_BUDGET_US 50000 //Gaps between yields longer than this are counted as over budget
+
+//Warm start (see WarmStart.h). Last live frame saved to LittleFS and shown at boot until live data arrives.
+//Needs a flash layout with a filesystem (e.g. "4MB (FS:2MB OTA:~1019KB)").
+#define WARM_START_FILE "/warm_start.bin"
+#define WARM_SAVE_SEC 600 //Min seconds between saves. Frames change every poll, so this sets the flash write rate.
+
+//Special train campaigns (see CampaignCache.h). appconfig.json campaigns kept in LittleFS and re-fetched with a conditional GET.
+#define CAMPAIGN_CACHE_FILE "/campaigns.bin"
+#define MAX_CAMPAIGNS 8 //Campaigns kept that haven't ended
 
 
 /*
@@ -100,27 +175,23 @@ const uint32_t SPECIAL_TRAIN_HEX[SPECIAL_TRAIN_HEX_COUNT] = {RD_HEX_COLOR, SV_HE
 // #define SECRET_WMATA_API_KEY_2 "2123456789abcdef0123456789abcdef"
 
 
-//Web server certificate SHA1 fingerprints for TLS connections. Updated daily by update-fingerprints action
-#define GITHUB_COM_FINGERPRINT "A5 47 1F 87 66 FE AF B2 EE 46 99 70 AE DA 6C 61 4D 14 B2 1B"
-#define RAW_GITHUBUSERCONTENT_COM_FINGERPRINT "3F 87 BE 75 1A 02 3B A4 D2 51 D2 72 92 A0 00 61 D1 D0 D7 12"
-#define API_WMATA_COM_FINGERPRINT "25 A4 C6 13 0A 81 28 F8 01 DC 1B 14 90 88 50 49 93 16 51 37"
-#define GIS_WMATA_COM_FINGERPRINT "72 B7 FA 5A 30 C7 47 F8 BA 69 7F 97 F9 2C 02 A8 00 93 47 72"
-#define GISSERVICES_WMATA_COM_FINGERPRINT "72 B7 FA 5A 30 C7 47 F8 BA 69 7F 97 F9 2C 02 A8 00 93 47 72"
+//Web server certificate SHA1 fingerprints for TLS connections, up to TLS_PINS_PER_HOST per host separated by ", " (see TlsPins.h).
+//Updated daily by update-fingerprints action, which puts a new fingerprint first. A known upcoming one can be added by hand.
+#define RAW_GITHUBUSERCONTENT_COM_FINGERPRINTS "3F 87 BE 75 1A 02 3B A4 D2 51 D2 72 92 A0 00 61 D1 D0 D7 12"
+#define API_WMATA_COM_FINGERPRINTS "25 A4 C6 13 0A 81 28 F8 01 DC 1B 14 90 88 50 49 93 16 51 37"
+#define GIS_WMATA_COM_FINGERPRINTS "72 B7 FA 5A 30 C7 47 F8 BA 69 7F 97 F9 2C 02 A8 00 93 47 72"
+#define GISSERVICES_WMATA_COM_FINGERPRINTS "72 B7 FA 5A 30 C7 47 F8 BA 69 7F 97 F9 2C 02 A8 00 93 47 72"
 
 /*
 *   REQUIRED CONFIGURATION VALUES
 *   (Things will break or not work right if changed)
 */
 
-//Headers to grab from response to request to /releases/latest (returns redirect to URL containing version umber)
-const char* github_header_keys[] = {"location"};
-const int github_num_headers = 1;
-
 //URLs and remote hosts for software updates and WMATA data
-#define LATEST_VERSION_URL "https://github.com/LArkema/dctransistor-project/releases/latest"
+#define UPDATE_MANIFEST_URL "https://raw.githubusercontent.com/LArkema/dctransistor-project/main/dctransistor.manifest" //Latest version, its size and hash (see UpdateManifest.h)
 #define UPDATE_BIN_URL "https://raw.githubusercontent.com/LArkema/dctransistor-project/main/dctransistor.bin.gz"
+#define UPDATE_DELTA_URL "https://raw.githubusercontent.com/LArkema/dctransistor-project/main/dctransistor.bin.delta" //From last release's image to this one (see DeltaPatch.h)
 #define UPDATE_HOST "raw.githubusercontent.com"
-#define GITHUB_HOST "github.com"
 
 #define WMATA_ENDPOINT "https://api.wmata.com/TrainPositions/TrainPositions?contentType=json"
 #define GIS_CONFIG_ENDPOINT "https://gis.wmata.com/live/appconfig.json"
@@ -133,7 +204,6 @@ const int github_num_headers = 1;
 */
 
 #define DATA_SOURCE_ENDPOINT GIS_TRAIN_LOC_ENDPOINT
-#define DATA_SOURCE_FINGERPRINT GISSERVICES_WMATA_COM_FINGERPRINT
 
 //Frequency for sending debug messages from ESP8266 chip to computer
 #define BAUD_RATE 9600
@@ -145,6 +215,10 @@ const int github_num_headers = 1;
 #define PWR_LED 104 //index of "Power" (should be last)
 #define WIFI_LED 103 //indoex of "WiFi" (2nd to last)
 #define WEB_LED 102 //index of "Web" (3rd to last)
+#define NUM_STATUS_LEDS 3 //Web, WiFi, and Power LEDs at end of strip
+#define LED_CHANNEL_UA 20000 //Current (uA) of one WS2812B color channel at full brightness (per datasheet, ~20mA)
+#define LED_IDLE_UA 600 //Current (uA) of one WS2812B with all channels off
+#define FRAME_MS 33 //Milliseconds between frames while waiting between requests (animations only)
 
 // Number of circuits before a Station's exact circuit to count a train as "at" that station
 #define CIRCS_BEFORE_STATION 2
@@ -175,35 +249,44 @@ See misc_commands.sh for how each array was created from WMATA's information
 #define NUM_YL_STATIONS 13  
 #define NUM_GN_STATIONS 21
 
+//Largest number of stations on any line. Sets size of each line's state bitset.
+constexpr uint8_t maxStations(uint8_t a, uint8_t b){ return (a > b) ? a : b; }
+constexpr uint8_t MAX_LINE_STATIONS = maxStations(NUM_RD_STATIONS, maxStations(NUM_BL_STATIONS, maxStations(NUM_OR_STATIONS,
+  maxStations(NUM_SV_STATIONS, maxStations(NUM_YL_STATIONS, NUM_GN_STATIONS)))));
+
+//Train directions shown on the board (one LED per station, shared by both directions). Selects the TrainLine<NUM_DIRECTIONS, MAX_LINE_STATIONS> specialization.
+#define NUM_DIRECTIONS 1
+
 // Station Codes for each station on each line. Code is prefixed in "TRKID" response from GIS Server.
+// Stored in flash, one aligned word per code (see FlashData.h). Read with readStationCode().
 
 //Exceptions: "B99" - Map to NoMa (B35)
-const char* rstation_codes[NUM_RD_STATIONS] = {"A15", "A14", "A13", "A12", "A11", "A10", "A09", "A08", "A07", "A06", "A05", "A04", "A03", "A02", "A01", "B01", "B02", "B03", "B35", "B04", "B05", "B06", "B07", "B08", "B09", "B10", "B11"};
+const StationCode rstation_codes[NUM_RD_STATIONS] FLASH_TABLE = {"A15", "A14", "A13", "A12", "A11", "A10", "A09", "A08", "A07", "A06", "A05", "A04", "A03", "A02", "A01", "B01", "B02", "B03", "B35", "B04", "B05", "B06", "B07", "B08", "B09", "B10", "B11"};
 #define RD_END_TRK_0 719
 #define RD_END_TRK_1 942
 
 //Exceptions: "J01 & C98 - Van Dorn (J02), C97 - King St. (C13), D98 - Benning Road (G01)"
-const char* bstation_codes[NUM_BL_STATIONS] = {"J03", "J02", "C13", "C12", "C11", "C10", "C09", "C08", "C07", "C06", "C05", "C04", "C03", "C02", "C01", "D01", "D02", "D03", "D04", "D05", "D06", "D07", "D08", "G01", "G02", "G03", "G04", "G05"};
+const StationCode bstation_codes[NUM_BL_STATIONS] FLASH_TABLE = {"J03", "J02", "C13", "C12", "C11", "C10", "C09", "C08", "C07", "C06", "C05", "C04", "C03", "C02", "C01", "D01", "D02", "D03", "D04", "D05", "D06", "D07", "D08", "G01", "G02", "G03", "G04", "G05"};
 #define BL_END_TRK_0 623
 #define BL_END_TRK_1 881
 
 //Exceptions: "K98 - West Falls Church (K06), D98 - Minnesota Ave (D09)"
-const char* ostation_codes[NUM_OR_STATIONS] = {"K08", "K07", "K06", "K05", "K04", "K03", "K02", "K01", "C05", "C04", "C03", "C02", "C01", "D01", "D02", "D03", "D04", "D05", "D06", "D07", "D08", "D09", "D10", "D11", "D12", "D13"};
+const StationCode ostation_codes[NUM_OR_STATIONS] FLASH_TABLE = {"K08", "K07", "K06", "K05", "K04", "K03", "K02", "K01", "C05", "C04", "C03", "C02", "C01", "D01", "D02", "D03", "D04", "D05", "D06", "D07", "D08", "D09", "D10", "D11", "D12", "D13"};
 #define OR_END_TRK_0 594
 #define OR_END_TRK_1 783
 
 //Exceptions: "N05, N98A & N98B, N98, N96, N97, N96, N94, N95, N94, N93, N92, N91, K98 - McLean (N01), D98"
-const char* sstation_codes[NUM_SV_STATIONS] = {"N12", "N11", "N10", "N09", "N08", "N07", "N06", "N04", "N03", "N02", "N01", "K05", "K04", "K03", "K02", "K01", "C05", "C04", "C03", "C02", "C01", "D01", "D02", "D03", "D04", "D05", "D06", "D07", "D08", "G01", "G02", "G03", "G04", "G05"};
+const StationCode sstation_codes[NUM_SV_STATIONS] FLASH_TABLE = {"N12", "N11", "N10", "N09", "N08", "N07", "N06", "N04", "N03", "N02", "N01", "K05", "K04", "K03", "K02", "K01", "C05", "C04", "C03", "C02", "C01", "D01", "D02", "D03", "D04", "D05", "D06", "D07", "D08", "G01", "G02", "G03", "G04", "G05"};
 #define SV_END_TRK_0 623
 #define SV_END_TRK_1 1664
 
 //Exceptions: "C97 - King St. (C13)"
-const char* ystations_codes[NUM_YL_STATIONS] = {"C15", "C14", "C13", "C12", "C11", "C10", "C09", "C08", "C07", "F03", "F02", "F01", "E01"};
+const StationCode ystations_codes[NUM_YL_STATIONS] FLASH_TABLE = {"C15", "C14", "C13", "C12", "C11", "C10", "C09", "C08", "C07", "F03", "F02", "F01", "E01"};
 #define YL_END_TRK_0 37
 #define YL_END_TRK_1 623
 
 // No exceptions
-const char* gstation_codes[NUM_GN_STATIONS] = {"F11", "F10", "F09", "F08", "F07", "F06", "F05", "F04", "F03", "F02", "F01", "E01", "E02", "E03", "E04", "E05", "E06", "E07", "E08", "E09", "E10"};
+const StationCode gstation_codes[NUM_GN_STATIONS] FLASH_TABLE = {"F11", "F10", "F09", "F08", "F07", "F06", "F05", "F04", "F03", "F02", "F01", "E01", "E02", "E03", "E04", "E05", "E06", "E07", "E08", "E09", "E10"};
 #define GN_END_TRK_0 662
 #define GN_END_TRK_1 540
 
@@ -240,13 +323,14 @@ const char* gstation_codes[NUM_GN_STATIONS] = {"F11", "F10", "F09", "F08", "F07"
 
 
 //LED arrays map each line's stations, in the same order as stations_0, to the index of that station in the continuous "string" of LEDs.
+//Stored in flash. Read with readFlashByte().
 //See dctransistor.com/documentation for a reference diagram
-const uint8_t rd_led_array[NUM_RD_STATIONS] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26};
-const uint8_t bl_led_array[NUM_BL_STATIONS] = {101, 100, 97, 96, 95, 94, 93, 92, 91, 90, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 52, 51, 50, 49, 48};
-const uint8_t or_led_array[NUM_OR_STATIONS] = {87, 88, 89, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53};
-const uint8_t sv_led_array[NUM_SV_STATIONS] = {86, 85, 84, 83, 82, 81, 80, 79, 78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 52, 51, 50, 49, 48};
-const uint8_t yl_led_array[NUM_YL_STATIONS] = {99, 98, 97, 96, 95, 94, 93, 92, 91, 39, 38, 37, 36};
-const uint8_t gn_led_array[NUM_GN_STATIONS] = {47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27};
+const uint8_t rd_led_array[NUM_RD_STATIONS] FLASH_TABLE = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26};
+const uint8_t bl_led_array[NUM_BL_STATIONS] FLASH_TABLE = {101, 100, 97, 96, 95, 94, 93, 92, 91, 90, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 52, 51, 50, 49, 48};
+const uint8_t or_led_array[NUM_OR_STATIONS] FLASH_TABLE = {87, 88, 89, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53};
+const uint8_t sv_led_array[NUM_SV_STATIONS] FLASH_TABLE = {86, 85, 84, 83, 82, 81, 80, 79, 78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63, 62, 61, 60, 59, 58, 52, 51, 50, 49, 48};
+const uint8_t yl_led_array[NUM_YL_STATIONS] FLASH_TABLE = {99, 98, 97, 96, 95, 94, 93, 92, 91, 39, 38, 37, 36};
+const uint8_t gn_led_array[NUM_GN_STATIONS] FLASH_TABLE = {47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27};
 
 /*****************************/
 /** COMPLETE TRACK CIRCUITS **/
@@ -0,0 +1,81 @@
+#!/usr/bin/python3
+
+# Decode BinaryLog frames (see DCTransistor/BinaryLog.h) captured from a board built with LOG_LEVEL above LOG_LEVEL_NONE.
+# Usage: decode_log.py [capture.bin] [--header path/to/BinaryLog.h]   (reads stdin if no file given)
+# Capture raw bytes from the serial port, e.g. `stty -F /dev/ttyUSB0 9600 raw && cat /dev/ttyUSB0 | decode_log.py`
+# Text printed by PRINT / PROFILE builds on the same port is passed through unchanged.
+
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+PAYLOAD = struct.Struct('<IBBhhhh')
+FRAME_LEN = PAYLOAD.size + 2
+LEVELS = {1: 'ERROR', 2: 'WARN', 3: 'INFO', 4: 'DEBUG'}
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'DCTransistor', 'BinaryLog.h')
+
+
+# Event names and argument labels from the LogEvent enum, in order
+def load_events(header_path):
+    text = open(header_path, 'r').read()
+    body = re.search(r'enum LogEvent[^{]*\{(.*?)\};', text, re.S).group(1)
+    events = []
+    for line in body.splitlines():
+        match = re.match(r'\s*(EV_\w+)\s*,\s*(?://(.*))?$', line)
+        if match:
+            labels = dict(label.split('=', 1) for label in (match.group(2) or '').split() if '=' in label)
+            events.append((match.group(1), [labels.get(arg) for arg in 'abcd']))
+    return events
+
+
+def format_frame(payload, events):
+    ms, level, event, *args = PAYLOAD.unpack(payload)
+    if event < len(events):
+        name, labels = events[event]
+    else:
+        name, labels = 'EVENT_%d' % event, [None] * 4
+    fields = ['%s=%d' % (label, value) for label, value in zip(labels, args) if label]
+    return '[%10.3f] %-5s %s %s' % (ms / 1000.0, LEVELS.get(level, str(level)), name, ' '.join(fields))
+
+
+# Yields decoded lines and passed-through text lines. Bytes that don't form a valid frame are treated as text.
+def decode(data, events):
+    text = bytearray()
+    i = 0
+    while i < len(data):
+        if data[i] == SYNC and i + FRAME_LEN <= len(data):
+            payload = data[i + 1:i + FRAME_LEN - 1]
+            check = 0
+            for byte in payload:
+                check ^= byte
+            if check == data[i + FRAME_LEN - 1]:
+                if text.strip():
+                    yield text.decode('ascii', 'replace').rstrip()
+                text = bytearray()
+                yield format_frame(bytes(payload), events)
+                i += FRAME_LEN
+                continue
+        if data[i] == ord('\n'):
+            if text.strip():
+                yield text.decode('ascii', 'replace').rstrip()
+            text = bytearray()
+        elif data[i] != ord('\r'):
+            text.append(data[i])
+        i += 1
+    if text.strip():
+        yield text.decode('ascii', 'replace').rstrip()
+
+
+if __name__ == '__main__':
+    args = sys.argv[1:]
+    header = DEFAULT_HEADER
+    if '--header' in args:
+        index = args.index('--header')
+        header = args[index + 1]
+        del args[index:index + 2]
+
+    source = open(args[0], 'rb') if args else sys.stdin.buffer
+    for line in decode(source.read(), load_events(header)):
+        print(line)
@@ -0,0 +1,232 @@
+#!/usr/bin/python3
+
+# Make, apply and round-trip binary deltas between two firmware images (see DCTransistor/DeltaPatch.h for the format).
+# Usage: make_delta.py diff <base.bin> <target.bin> <out.delta>
+#        make_delta.py apply <base.bin> <in.delta> <out.bin>
+#        make_delta.py roundtrip <base.bin> <target.bin> [out.delta]   (diff, apply, compare; exits 1 on mismatch)
+#        make_delta.py selftest                                        (round-trips generated edits of a random image)
+# Boards apply a delta while streaming it, reading the running image for COPY. Deltas are made between
+# uncompressed .bin files, since that is what is in flash.
+
+import gzip
+import hashlib
+import random
+import struct
+import sys
+
+FORMAT = 1  # DELTA_FORMAT in DeltaPatch.h
+HEADER = struct.Struct('<4sBI16sI16s')
+OP_COPY, OP_REPLACE, OP_INSERT, OP_SEEK = 1, 2, 3, 4
+
+KEY_LEN = 12  # Bytes of target looked up in base to find a new source position
+MIN_JUMP = 16  # Shortest match worth a SEEK
+MAX_REPLACE = 16  # Longest run of changed bytes before the same source position matches again
+RESYNC_LEN = 4  # Bytes that must match again after a replaced run
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return (value << 1) if value >= 0 else ((-value << 1) - 1)
+
+
+def match_len(a, ai, b, bi):
+    limit = min(len(a) - ai, len(b) - bi)
+    n = 0
+    step = 256
+    while n + step <= limit and a[ai + n:ai + n + step] == b[bi + n:bi + n + step]:
+        n += step
+    while n < limit and a[ai + n] == b[bi + n]:
+        n += 1
+    return n
+
+
+# Last position of every KEY_LEN-byte string in base
+def index_base(base):
+    index = {}
+    for i in range(len(base) - KEY_LEN + 1):
+        index[base[i:i + KEY_LEN]] = i
+    return index
+
+
+def diff(base, target):
+    index = index_base(base)
+    ops = bytearray()
+    literal = bytearray()
+    literal_op = None
+    src = 0
+    t = 0
+
+    def flush():
+        nonlocal literal, literal_op
+        if literal:
+            ops.extend(bytes([literal_op]) + varint(len(literal)) + literal)
+        literal = bytearray()
+        literal_op = None
+
+    def add_literal(op, data):
+        nonlocal literal_op
+        if literal_op != op:
+            flush()
+            literal_op = op
+        literal.extend(data)
+
+    while t < len(target):
+        # Same bytes at current source position
+        n = match_len(base, src, target, t) if src < len(base) else 0
+        if n > 0:
+            flush()
+            ops.extend(bytes([OP_COPY]) + varint(n))
+            src += n
+            t += n
+            continue
+
+        # A few changed bytes (e.g. a moved address), then the same source position matches again
+        replaced = 0
+        for r in range(1, MAX_REPLACE + 1):
+            if src + r + RESYNC_LEN <= len(base) and t + r + RESYNC_LEN <= len(target) and \
+                    base[src + r:src + r + RESYNC_LEN] == target[t + r:t + r + RESYNC_LEN]:
+                replaced = r
+                break
+        if replaced:
+            add_literal(OP_REPLACE, target[t:t + replaced])
+            src += replaced
+            t += replaced
+            continue
+
+        # Somewhere else in base
+        found = index.get(target[t:t + KEY_LEN])
+        if found is not None and match_len(base, found, target, t) >= MIN_JUMP:
+            flush()
+            ops.extend(bytes([OP_SEEK]) + varint(zigzag(found - src)))
+            src = found
+            continue
+
+        add_literal(OP_INSERT, target[t:t + 1])
+        t += 1
+
+    flush()
+    header = HEADER.pack(b'DCDL', FORMAT, len(base), hashlib.md5(base).digest(), len(target), hashlib.md5(target).digest())
+    return header + bytes(ops)
+
+
+def read_varint(delta, pos):
+    value = 0
+    shift = 0
+    while True:
+        byte = delta[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        shift += 7
+        if not byte & 0x80:
+            return value, pos
+
+
+# Reference applier, same checks as the board
+def apply(base, delta):
+    magic, fmt, base_size, base_md5, target_size, target_md5 = HEADER.unpack_from(delta)
+    if magic != b'DCDL' or fmt != FORMAT:
+        raise ValueError('not a format %d delta' % FORMAT)
+    if base_size != len(base) or base_md5 != hashlib.md5(base).digest():
+        raise ValueError('delta is for a different base image')
+
+    out = bytearray()
+    src = 0
+    pos = HEADER.size
+    while len(out) < target_size:
+        op = delta[pos]
+        value, pos = read_varint(delta, pos + 1)
+        if op == OP_COPY:
+            if src + value > len(base):
+                raise ValueError('copy past end of base')
+            out.extend(base[src:src + value])
+            src += value
+        elif op in (OP_REPLACE, OP_INSERT):
+            out.extend(delta[pos:pos + value])
+            pos += value
+            if op == OP_REPLACE:
+                src += value
+        elif op == OP_SEEK:
+            src += (value >> 1) ^ -(value & 1)
+        else:
+            raise ValueError('bad op %d at %d' % (op, pos - 1))
+
+    if len(out) != target_size or hashlib.md5(out).digest() != target_md5:
+        raise ValueError('patched image does not match target MD5')
+    return bytes(out)
+
+
+def roundtrip(base, target, name='image'):
+    delta = diff(base, target)
+    if apply(base, delta) != target:
+        print('%s: round trip FAILED' % name)
+        return None
+    full = len(gzip.compress(target, 9))
+    print('%s: delta %d bytes, full image %d bytes (%d gzipped), %.1fx smaller than gzipped'
+          % (name, len(delta), len(target), full, full / len(delta)))
+    return delta
+
+
+# Edits a release might make to an image, each round-tripped
+def selftest():
+    rng = random.Random(1)
+    base = bytes(rng.getrandbits(8) for _ in range(64 * 1024))
+
+    def version_bump(b):
+        out = bytearray(b)
+        out[30000:30006] = b'2.0.77'
+        return bytes(out)
+
+    def relocated(b):  # Insert code, then every "address" after it moves by 4
+        out = bytearray(b[:20000] + bytes(rng.getrandbits(8) for _ in range(300)) + b[20000:])
+        for i in range(20400, len(out) - 4, 512):
+            out[i:i + 4] = struct.pack('<I', struct.unpack_from('<I', out, i)[0] + 4)
+        return bytes(out)
+
+    def removed(b):
+        return b[:10000] + b[14096:]
+
+    def moved(b):
+        return b[32000:] + b[:32000]
+
+    def unrelated(b):
+        return bytes(rng.getrandbits(8) for _ in range(len(b)))
+
+    ok = True
+    for name, edit in (('version_bump', version_bump), ('relocated', relocated), ('removed', removed),
+                       ('moved', moved), ('unrelated', unrelated), ('identical', lambda b: b)):
+        ok = roundtrip(base, edit(base), name) is not None and ok
+    return ok
+
+
+def main(argv):
+    if len(argv) >= 2 and argv[1] == 'selftest':
+        return 0 if selftest() else 1
+    if len(argv) >= 4 and argv[1] in ('diff', 'apply', 'roundtrip'):
+        base = open(argv[2], 'rb').read()
+        second = open(argv[3], 'rb').read()
+        if argv[1] == 'apply':
+            open(argv[4], 'wb').write(apply(base, second))
+            return 0
+        delta = diff(base, second) if argv[1] == 'diff' else roundtrip(base, second, argv[3])
+        if delta is None:
+            return 1
+        if len(argv) >= 5:
+            open(argv[4], 'wb').write(delta)
+        return 0
+    print('Usage: make_delta.py diff|apply|roundtrip <base.bin> <target.bin or .delta> [out] | selftest', file=sys.stderr)
+    return 2
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv))
@@ -0,0 +1,80 @@
+#!/usr/bin/python3
+
+# Render LoopProfiler reports (see DCTransistor/LoopProfiler.h) captured from a board built with PROFILE defined.
+# Usage: render_profile.py [serial_log.txt]   (reads stdin if no file given, e.g. piped from a serial monitor)
+# Uses the last complete report in the input.
+
+import sys
+
+BAR_WIDTH = 40
+
+
+def parse_reports(lines):
+    reports = []
+    current = None
+    for line in lines:
+        line = line.strip()
+        if line.startswith('#PROFILE'):
+            current = {}
+        elif line.startswith('#END') and current is not None:
+            reports.append(current)
+            current = None
+        elif current is not None and ' count=' in line:
+            name, rest = line.split(' ', 1)
+            fields = dict(field.split('=', 1) for field in rest.split())
+            current[name] = {
+                'count': int(fields['count']),
+                'total_us': int(fields['total_us']),
+                'min_us': int(fields['min_us']),
+                'max_us': int(fields['max_us']),
+                'hist': [int(c) for c in fields['hist'].split(',')],
+            }
+    return reports
+
+
+# Upper edge of the bucket holding the given percentile (capped at max seen). Bucket b covers [2^b, 2^(b+1)) us.
+def bucket_percentile(phase, percentile):
+    hist = phase['hist']
+    total = sum(hist)
+    target = total * percentile / 100.0
+    running = 0
+    for bucket, count in enumerate(hist):
+        running += count
+        if running >= target:
+            return min(2 ** (bucket + 1), phase['max_us'])
+    return phase['max_us']
+
+
+def format_us(us):
+    if us >= 1000000:
+        return '%.2fs' % (us / 1000000.0)
+    if us >= 1000:
+        return '%.1fms' % (us / 1000.0)
+    return '%dus' % us
+
+
+def render(report):
+    print('%-14s %8s %9s %9s %9s %9s %9s %9s' % ('phase', 'count', 'mean', 'min', '<p50', '<p95', '<p99', 'max'))
+    for name, phase in report.items():
+        print('%-14s %8d %9s %9s %9s %9s %9s %9s' % (
+            name, phase['count'], format_us(phase['total_us'] // phase['count']), format_us(phase['min_us']),
+            format_us(bucket_percentile(phase, 50)), format_us(bucket_percentile(phase, 95)),
+            format_us(bucket_percentile(phase, 99)), format_us(phase['max_us'])))
+
+    for name, phase in report.items():
+        print()
+        print(name)
+        hist = phase['hist']
+        peak = max(hist)
+        used = [b for b, count in enumerate(hist) if count > 0]
+        for bucket in range(used[0], used[-1] + 1):
+            bar = '#' * ((hist[bucket] * BAR_WIDTH + peak - 1) // peak)
+            print('  %9s - %-9s %-*s %d' % (format_us(2 ** bucket if bucket else 0), format_us(2 ** (bucket + 1)), BAR_WIDTH, bar, hist[bucket]))
+
+
+if __name__ == '__main__':
+    source = open(sys.argv[1], 'r', errors='replace') if len(sys.argv) > 1 else sys.stdin
+    reports = parse_reports(source)
+    if not reports:
+        sys.exit('No complete #PROFILE report found')
+    render(reports[-1])
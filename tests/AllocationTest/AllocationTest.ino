@@ -0,0 +1,207 @@
+#line 2 "AllocationTest.ino"
+
+#include <AUnit.h>
+#include <ArduinoJson.h>
+
+//Values normally defined in config.h
+#define CYCLES_AT_END 2
+#define TOTAL_SYSTEM_STATIONS 100
+#define YIELD_BUDGET_ASSERT //Parse path must reach a yield point within DEFAULT_YIELD_BUDGET_US or the run aborts
+
+#include "../../DCTransistor/FlashData.h"
+#include "../../DCTransistor/LoopProfiler.h"
+#include "../../DCTransistor/YieldMonitor.h"
+#include "../../DCTransistor/BinaryLog.h"
+#include "../../DCTransistor/HttpStream.h"
+#include "../../DCTransistor/TrainLine.h"
+#include "../../DCTransistor/SpecialTrains.h"
+#include "../../DCTransistor/TrainFeed.h"
+
+/*
+Audits the steady-state poll / parse path for heap allocations.
+malloc, calloc, realloc and free are interposed (glibc only) to count every call while a canned HTTP response is
+read, parsed into TrainLines and scattered into LED masks, the same way loop() does it.
+Compiles for EpoxyDuino - runs on linux.
+*/
+
+// ----- HEAP INTERPOSITION -----
+uint32_t heap_calls = 0; //malloc / calloc / realloc / free calls since last reset
+
+#if defined(__GLIBC__)
+#define HEAP_AUDIT true
+extern "C" {
+  void* __libc_malloc(size_t size);
+  void* __libc_calloc(size_t count, size_t size);
+  void* __libc_realloc(void* ptr, size_t size);
+  void __libc_free(void* ptr);
+
+  void* malloc(size_t size) noexcept {heap_calls++; return __libc_malloc(size);}
+  void* calloc(size_t count, size_t size) noexcept {heap_calls++; return __libc_calloc(count, size);}
+  void* realloc(void* ptr, size_t size) noexcept {heap_calls++; return __libc_realloc(ptr, size);}
+  void free(void* ptr) noexcept {if(ptr){heap_calls++;} __libc_free(ptr);}
+}
+#else
+#define HEAP_AUDIT false
+#endif
+
+// ----- TEST DATA -----
+
+//Stream over a fixed string, standing in for WiFiClientSecure
+class MemoryStream : public Stream {
+  private:
+    const char* data;
+    size_t len;
+    size_t pos;
+
+  public:
+    MemoryStream(const char* text) : data(text), len(strlen(text)), pos(0) {}
+    void rewind(){pos = 0;}
+    int available() override {return len - pos;}
+    int read() override {return (pos < len) ? data[pos++] : -1;}
+    int peek() override {return (pos < len) ? data[pos] : -1;}
+    size_t write(uint8_t) override {return 0;}
+};
+
+const char response[] =
+  "HTTP/1.1 200 OK\r\n"
+  "Content-Type: application/json; charset=utf-8\r\n"
+  "X-Padding: 0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789\r\n"
+  "Location: https://github.com/LArkema/dctransistor-project/releases/tag/2.0.99\r\n"
+  "\r\n"
+  "{\"displayFieldName\":\"\",\"features\":["
+  "{\"attributes\":{\"ITT\":101,\"TRKID\":\"A03-A1-010\",\"TRACKLINE\":\"Red\",\"TRIP_DIRECTION\":1,\"CARS\":6,\"ETIME\":1721990892}},"
+  "{\"attributes\":{\"ITT\":102,\"TRKID\":\"B02-B2-400\",\"TRACKLINE\":\"Blue\",\"TRIP_DIRECTION\":2,\"CARS\":8,\"ETIME\":1721990895}},"
+  "{\"attributes\":{\"ITT\":103,\"TRKID\":\"A05-A2-010\",\"TRACKLINE\":\"Red\",\"TRIP_DIRECTION\":2,\"CARS\":8}},"
+  "{\"attributes\":{\"ITT\":104,\"TRKID\":\"Z01-A2-010\",\"TRACKLINE\":\"Purple\",\"TRIP_DIRECTION\":2,\"CARS\":8}},"
+  "{\"attributes\":{\"ITT\":105,\"TRKID\":\"X01-A2-010\",\"TRACKLINE\":null,\"TRIP_DIRECTION\":2,\"CARS\":8}}"
+  "]}";
+
+const StationCode red_codes[5] FLASH_TABLE = {"A01", "A02", "A03", "A04", "A05"};
+const StationCode blue_codes[3] FLASH_TABLE = {"B01", "B02", "B03"};
+const uint8_t red_leds[5] FLASH_TABLE = {0, 1, 2, 3, 4};
+const uint8_t blue_leds[3] FLASH_TABLE = {10, 11, 12};
+
+typedef TrainLine<1, 8> TestLine;
+TestLine red_line(5, red_codes, "Red", 0xFF0000, 100, 100, red_leds);
+TestLine blue_line(3, blue_codes, "Blue", 0x0000FF, 1000, 1000, blue_leds);
+TestLine* const test_lines[2] = {&red_line, &blue_line};
+
+StaticJsonDocument<128> filter;
+StaticJsonDocument<1024> arena;
+SpecialTrains<4> specials;
+MemoryStream stream(response);
+
+//One loop() worth of work: read response, parse trains into lines, build LED mask, clear state.
+TrainFeedResult pollOnce(BitSet<32> &leds){
+  stream.rewind();
+  readHttpStatus(stream);
+  readHttpHeaders(stream, NULL, NULL, 0);
+
+  TrainFeedResult feed = parseTrainFeed(stream, arena, filter, test_lines, 2, specials);
+
+  leds.clear();
+  for(uint8_t l=0; l<2; l++){
+    test_lines[l]->getState().scatter(test_lines[l]->getLEDs(), test_lines[l]->getTotalNumStations(), leds);
+    test_lines[l]->clearState();
+  }
+  return feed;
+}
+
+void setup() {
+  Serial.begin(9600);
+
+  filter["attributes"]["TRKID"] = true;
+  filter["attributes"]["TRACKLINE"] = true;
+  filter["attributes"]["TRIP_DIRECTION"] = true;
+  filter["attributes"]["ITT"] = true;
+  filter["attributes"]["ETIME"] = true;
+
+  specials.add(103, 0);
+  specials.add(102, 1);
+  specials.add(999, 2); //Not running
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(http_status_and_headers){
+  stream.rewind();
+  assertEqual(readHttpStatus(stream), (int16_t)200);
+
+  //Long header line is truncated and skipped, not mistaken for end of headers
+  char location[HTTP_LINE_LEN];
+  assertTrue(readHttpHeaders(stream, "location", location, sizeof(location)));
+  assertEqual(location, "https://github.com/LArkema/dctransistor-project/releases/tag/2.0.99");
+  assertEqual((char)stream.peek(), '{');
+}
+
+test(collect_several_headers){
+  stream.rewind();
+  readHttpStatus(stream);
+
+  char location[HTTP_LINE_LEN];
+  char content_type[16];
+  char etag[16];
+  HttpHeader headers[3] = {{"location", location, sizeof(location)}, {"content-type", content_type, sizeof(content_type)}, {"etag", etag, sizeof(etag)}};
+  assertEqual(readHttpHeaders(stream, headers, 3), (uint8_t)2);
+  assertEqual(location, "https://github.com/LArkema/dctransistor-project/releases/tag/2.0.99");
+  assertEqual(content_type, "application/jso"); //Truncated to fit
+  assertEqual(etag, "");
+  assertEqual((char)stream.peek(), '{');
+}
+
+test(format_get_request){
+  char request[HTTP_REQUEST_LEN];
+  char host[HTTP_HOST_LEN];
+
+  uint16_t len = formatGetRequest(request, sizeof(request), host, sizeof(host), PSTR("https://gis.wmata.com/live/appconfig.json"), PSTR("Accept: application/json\r\n"));
+  assertEqual(host, "gis.wmata.com");
+  assertEqual(len, (uint16_t)strlen(request));
+  assertEqual(strncmp(request, "GET /live/appconfig.json HTTP/1.0\r\nHost: gis.wmata.com\r\n", 56), 0);
+  assertTrue(strstr(request, "Accept: application/json\r\n\r\n") != NULL);
+
+  //Doesn't fit
+  assertEqual(formatGetRequest(request, 32, host, sizeof(host), PSTR("https://gis.wmata.com/live/appconfig.json"), NULL), (uint16_t)0);
+  assertEqual(formatGetRequest(request, sizeof(request), host, sizeof(host), PSTR("not a url"), NULL), (uint16_t)0);
+}
+
+test(parse_train_feed){
+  BitSet<32> leds;
+  TrainFeedResult feed = pollOnce(leds);
+
+  assertTrue(feed.ok);
+  assertEqual(feed.unmatched, (uint8_t)1); //Purple line
+  assertEqual(feed.specials_seen, (uint8_t)2);
+  assertEqual(specials.getLine(0), (int8_t)0); //103 on Red
+  assertEqual(specials.getIndex(0), (uint8_t)4);
+  assertEqual(specials.getDir(0), (uint8_t)1);
+  assertEqual(specials.getLine(1), (int8_t)1); //102 on Blue
+  assertEqual(specials.getIndex(1), (uint8_t)1);
+  assertEqual(specials.getDir(1), (uint8_t)1);
+  assertEqual(specials.getLine(2), (int8_t)-1);
+  assertTrue(feed.newest_ms == 1721990895000ULL); //Newest ETIME, seconds converted to ms
+
+  assertTrue(leds.isSet(2));
+  assertTrue(leds.isSet(4));
+  assertTrue(leds.isSet(11));
+  assertEqual(leds.count(), (uint16_t)3);
+}
+
+test(steady_state_no_allocations){
+  if(!HEAP_AUDIT){
+    Serial.println("Heap audit requires glibc. Skipping.");
+    return;
+  }
+
+  BitSet<32> leds;
+  pollOnce(leds); //Warm up anything allocated once on first use
+
+  for(uint8_t i=0; i<20; i++){
+    heap_calls = 0;
+    pollOnce(leds);
+    assertEqual(heap_calls, (uint32_t)0);
+  }
+}
@@ -0,0 +1,114 @@
+#line 2 "BinaryLogTest.ino"
+
+#include <AUnit.h>
+
+#define LOG_LEVEL LOG_LEVEL_INFO
+#define LOG_RING_BYTES 64
+#include "../../DCTransistor/BinaryLog.h"
+
+/*
+Unit tests for BinaryLog frame format, ring wraparound, partial drains, dropped records and compile-time levels.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+//Collect drained bytes
+class BufferPrint : public Print {
+  public:
+    uint8_t buf[512];
+    size_t len;
+    BufferPrint() : len(0) {}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf)){return 0;}
+      buf[len++] = c;
+      return 1;
+    }
+};
+
+//Check frame at offset: sync, level, event, first argument and checksum
+bool frameIs(const uint8_t* frame, uint8_t level, uint8_t event, int16_t a){
+  uint8_t check = 0;
+  for(uint8_t i=1; i<=LOG_PAYLOAD_LEN; i++){
+    check ^= frame[i];
+  }
+  int16_t frame_a = frame[7] | (frame[8] << 8);
+  return frame[0] == LOG_SYNC && frame[5] == level && frame[6] == event && frame_a == a && frame[LOG_FRAME_LEN - 1] == check;
+}
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(frame_format){
+  BinaryLog<64> log;
+  log.log(LOG_LEVEL_DEBUG, EV_TRAIN, -2, 1, 300, 0x1234);
+  assertEqual(log.pending(), (uint16_t)LOG_FRAME_LEN);
+
+  BufferPrint out;
+  assertEqual(log.drain(out, 100), (size_t)LOG_FRAME_LEN);
+  assertEqual(log.pending(), (uint16_t)0);
+
+  assertTrue(frameIs(out.buf, LOG_LEVEL_DEBUG, EV_TRAIN, -2));
+  assertEqual(out.buf[9], (uint8_t)1);
+  assertEqual(out.buf[11], (uint8_t)(300 & 0xFF));
+  assertEqual(out.buf[12], (uint8_t)(300 >> 8));
+  assertEqual(out.buf[13], (uint8_t)0x34);
+  assertEqual(out.buf[14], (uint8_t)0x12);
+}
+
+test(partial_drain_and_wraparound){
+  BinaryLog<64> log;
+  BufferPrint out;
+
+  //Ten frames through a 64 byte ring, draining 5 bytes at a time
+  for(uint8_t i=0; i<10; i++){
+    assertTrue(log.log(LOG_LEVEL_INFO, EV_LOOP_START, i));
+    while(log.pending() > 0){
+      assertLessOrEqual(log.drain(out, 5), (size_t)5);
+    }
+  }
+
+  assertEqual(out.len, (size_t)(10 * LOG_FRAME_LEN));
+  for(uint8_t i=0; i<10; i++){
+    assertTrue(frameIs(&out.buf[i * LOG_FRAME_LEN], LOG_LEVEL_INFO, EV_LOOP_START, i));
+  }
+}
+
+test(full_ring_drops_then_reports){
+  BinaryLog<64> log;
+
+  //63 usable bytes hold 3 frames
+  for(uint8_t i=0; i<3; i++){
+    assertTrue(log.log(LOG_LEVEL_INFO, EV_LOOP_START, i));
+  }
+  assertFalse(log.log(LOG_LEVEL_INFO, EV_LOOP_START, 3));
+  assertFalse(log.log(LOG_LEVEL_INFO, EV_LOOP_START, 4));
+  assertEqual(log.getDropped(), (uint32_t)2);
+
+  BufferPrint out;
+  log.drain(out, 512);
+  out.len = 0;
+
+  //Drop count goes out before the next record
+  assertTrue(log.log(LOG_LEVEL_INFO, EV_LOOP_START, 5));
+  log.drain(out, 512);
+  assertEqual(out.len, (size_t)(2 * LOG_FRAME_LEN));
+  assertTrue(frameIs(out.buf, LOG_LEVEL_WARN, EV_LOG_DROPPED, 2));
+  assertTrue(frameIs(&out.buf[LOG_FRAME_LEN], LOG_LEVEL_INFO, EV_LOOP_START, 5));
+}
+
+test(levels_above_log_level_compile_out){
+  BufferPrint out;
+  binary_log.drain(out, 512);
+
+  LOG_DEBUG(EV_TRAIN, 1, 2, 3, 4);
+  assertEqual(binary_log.pending(), (uint16_t)0);
+
+  LOG_INFO(EV_PARSE_DONE, 10, 0, 250);
+  LOG_ERROR(EV_HTTP_FAILED, -1);
+  assertEqual(binary_log.pending(), (uint16_t)(2 * LOG_FRAME_LEN));
+}
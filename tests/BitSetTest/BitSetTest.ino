@@ -0,0 +1,100 @@
+#line 2 "BitSetTest.ino"
+
+#include <AUnit.h>
+#include "../../DCTransistor/BitSet.h"
+
+/*
+Unit tests for BitSet class template used for TrainLine state and Compositor LED masks.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+void setup() {
+  Serial.begin(9600);
+  randomSeed(0);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(proper_init){
+  BitSet<34> bits;
+  assertFalse(bits.any());
+  assertEqual(bits.count(), (uint16_t)0);
+  assertEqual(bits.findFirst(), (int16_t)-1);
+}
+
+test(set_and_reset){
+  BitSet<34> bits;
+  bits.set(0);
+  bits.set(33);
+  assertTrue(bits.isSet(0));
+  assertTrue(bits.isSet(33));
+  assertFalse(bits.isSet(32));
+  assertEqual(bits.count(), (uint16_t)2);
+
+  bits.reset(33);
+  assertFalse(bits.isSet(33));
+  assertEqual(bits.count(), (uint16_t)1);
+}
+
+test(out_of_range_ignored){
+  BitSet<34> bits;
+  bits.set(34);
+  bits.set(200);
+  assertFalse(bits.any());
+  assertFalse(bits.isSet(34));
+}
+
+//Silver line (34 stations) needed 64-bit math with uint64_t state
+test(shift_across_words){
+  BitSet<34> bits;
+  bits.set(31);
+  bits.shiftUp();
+  assertFalse(bits.isSet(31));
+  assertTrue(bits.isSet(32));
+  bits.shiftUp();
+  assertTrue(bits.isSet(33));
+  bits.shiftUp();
+  assertFalse(bits.any()); //shifted past end of set
+}
+
+test(find_first_and_next){
+  BitSet<100> bits;
+  bits.set(3);
+  bits.set(40);
+  bits.set(99);
+  assertEqual(bits.findFirst(), (int16_t)3);
+  assertEqual(bits.findNext(3), (int16_t)40);
+  assertEqual(bits.findNext(40), (int16_t)99);
+  assertEqual(bits.findNext(99), (int16_t)-1);
+}
+
+test(scatter_to_leds){
+  const uint8_t leds[4] = {101, 100, 97, 5};
+  BitSet<34> state;
+  state.set(0);
+  state.set(2);
+  state.set(20); //past end of line, not scattered
+
+  BitSet<204> board;
+  state.scatter(leds, 4, board);
+  assertTrue(board.isSet(101));
+  assertTrue(board.isSet(97));
+  assertFalse(board.isSet(100));
+  assertEqual(board.count(), (uint16_t)2);
+}
+
+test(word_operators){
+  BitSet<64> a;
+  BitSet<64> b;
+  a.set(1);
+  a.set(63);
+  b.set(63);
+  assertTrue((a & b).isSet(63));
+  assertFalse((a & b).isSet(1));
+  assertEqual((a | b).count(), (uint16_t)2);
+  b.set(1);
+  assertTrue(a == b);
+}
@@ -0,0 +1,163 @@
+#line 2 "CampaignCacheTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/HttpStream.h"
+#include "../../DCTransistor/FlashFile.h"
+#include "../../DCTransistor/CampaignCache.h"
+
+/*
+Unit tests for CampaignCache conditional request headers, save / load round trip, rejecting corrupt records,
+dropping ended campaigns and evaluating campaign dates locally.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define DAY 86400
+
+//Flash file stand-in
+struct RamStore {
+  static uint8_t data[512];
+  static size_t len;
+  static uint32_t writes;
+  static bool read(uint8_t* out, size_t n){
+    if(n != len){return false;}
+    memcpy(out, data, n);
+    return true;
+  }
+  static bool write(const uint8_t* in, size_t n){
+    if(n > sizeof(data)){return false;}
+    memcpy(data, in, n);
+    len = n;
+    writes++;
+    return true;
+  }
+};
+uint8_t RamStore::data[512];
+size_t RamStore::len = 0;
+uint32_t RamStore::writes = 0;
+
+typedef CampaignCache<RamStore, 2, 4> TestCache;
+
+const uint16_t cars_a[2] = {7000, 7001};
+const uint16_t cars_b[4] = {3000, 3001, 3002, 3003};
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(no_conditional_headers_without_list){
+  RamStore::len = 0;
+  TestCache cache;
+  assertFalse(cache.load());
+
+  char buf[128];
+  assertEqual(cache.appendConditionalHeaders(buf, 0, sizeof(buf)), (uint16_t)0);
+}
+
+test(round_trip_and_conditional_headers){
+  RamStore::len = 0;
+  RamStore::writes = 0;
+  TestCache saver;
+  saver.begin("\"0x8DC1\"", "Wed, 21 Oct 2015 07:28:00 GMT");
+  assertTrue(saver.add(10 * DAY, 20 * DAY, cars_a, 2, 0));
+  assertTrue(saver.add(30 * DAY, 40 * DAY, cars_b, 4, 0));
+  assertFalse(saver.add(50 * DAY, 60 * DAY, cars_a, 2, 0)); //Full
+  assertTrue(saver.save());
+  assertFalse(saver.save()); //Unchanged
+  assertEqual(RamStore::writes, (uint32_t)1);
+
+  TestCache loader;
+  assertTrue(loader.load());
+  assertEqual(loader.getCount(), (uint8_t)2);
+
+  char buf[128];
+  uint16_t len = loader.appendConditionalHeaders(buf, 0, sizeof(buf));
+  buf[len] = '\0';
+  assertEqual(buf, "If-None-Match: \"0x8DC1\"\r\nIf-Modified-Since: Wed, 21 Oct 2015 07:28:00 GMT\r\n");
+
+  //Doesn't fit
+  assertEqual(loader.appendConditionalHeaders(buf, 0, 20), (uint16_t)20);
+
+  //Same list again (e.g. server ignored validators) isn't rewritten
+  loader.begin("\"0x8DC1\"", "Wed, 21 Oct 2015 07:28:00 GMT");
+  loader.add(10 * DAY, 20 * DAY, cars_a, 2, 0);
+  loader.add(30 * DAY, 40 * DAY, cars_b, 4, 0);
+  assertFalse(loader.save());
+  assertEqual(RamStore::writes, (uint32_t)1);
+}
+
+test(active_cars_by_date){
+  TestCache cache;
+  cache.begin(NULL, NULL);
+  cache.add(10 * DAY, 20 * DAY, cars_a, 2, 0);
+  cache.add(30 * DAY, 40 * DAY, cars_b, 4, 0);
+
+  uint16_t cars[4];
+  assertEqual(cache.activeCars(5 * DAY, cars), (uint8_t)0);
+  assertEqual(cache.activeCars(10 * DAY, cars), (uint8_t)2);
+  assertEqual(cars[1], (uint16_t)7001);
+  assertEqual(cache.activeCars(35 * DAY, cars), (uint8_t)4);
+  assertEqual(cars[3], (uint16_t)3003);
+  assertEqual(cache.activeCars(41 * DAY, cars), (uint8_t)0);
+}
+
+test(overlapping_campaigns){
+  TestCache cache;
+  cache.begin(NULL, NULL);
+  cache.add(10 * DAY, 40 * DAY, cars_a, 2, 0);
+  cache.add(30 * DAY, 50 * DAY, cars_b, 4, 0);
+
+  uint16_t cars[4];
+  assertEqual(cache.countActive(20 * DAY), (uint8_t)1);
+  assertEqual(cache.countActive(35 * DAY), (uint8_t)2);
+  assertEqual(cache.activeCars(35 * DAY, cars, 0), (uint8_t)2);
+  assertEqual(cars[0], (uint16_t)7000);
+  assertEqual(cache.activeCars(35 * DAY, cars, 1), (uint8_t)4);
+  assertEqual(cars[0], (uint16_t)3000);
+  assertEqual(cache.activeCars(35 * DAY, cars, 2), (uint8_t)0);
+
+  //Second campaign keeps its place in the list (and its palette) whether or not the first is running
+  assertEqual(cache.activeIndex(35 * DAY, 1), (int8_t)1);
+  assertEqual(cache.activeIndex(45 * DAY, 0), (int8_t)1);
+  assertEqual(cache.activeIndex(20 * DAY, 0), (int8_t)0);
+  assertEqual(cache.activeIndex(20 * DAY, 1), (int8_t)-1);
+}
+
+test(ended_campaigns_and_long_validators_dropped){
+  TestCache cache;
+  char long_etag[CAMPAIGN_ETAG_LEN];
+  memset(long_etag, 'x', sizeof(long_etag) - 1);
+  long_etag[sizeof(long_etag) - 1] = '\0';
+
+  cache.begin(long_etag, NULL);
+  assertTrue(cache.add(10 * DAY, 20 * DAY, cars_a, 2, 25 * DAY)); //Ended, skipped
+  assertTrue(cache.add(30 * DAY, 40 * DAY, cars_b, 4, 25 * DAY));
+  assertEqual(cache.getCount(), (uint8_t)1);
+  assertEqual(cache.getEtag(), "");
+
+  char buf[64];
+  assertEqual(cache.appendConditionalHeaders(buf, 0, sizeof(buf)), (uint16_t)0);
+}
+
+test(rejects_corrupt_or_other_shape){
+  RamStore::len = 0;
+  TestCache saver;
+  saver.begin("\"abc\"", NULL);
+  saver.add(10 * DAY, 20 * DAY, cars_a, 2, 0);
+  assertTrue(saver.save());
+
+  //Built with a different number of campaigns
+  CampaignCache<RamStore, 3, 4> other_build;
+  assertFalse(other_build.load());
+
+  RamStore::data[10] ^= 0x01;
+  TestCache loader;
+  assertFalse(loader.load());
+  assertFalse(loader.hasList());
+  assertEqual(loader.getCount(), (uint8_t)0);
+}
@@ -0,0 +1,79 @@
+#line 2 "ColorLUTTest.ino"
+
+#include <AUnit.h>
+#include "../../DCTransistor/ColorLUT.h"
+
+/*
+Unit tests for the compile-time gamma + brightness tables and blendColor crossfade used by the Compositor.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+constexpr ColorLUT<10, 255> linear_full{};
+constexpr ColorLUT<10, 3> linear_dim{};
+constexpr ColorLUT<22, 255> gamma_full{};
+constexpr ColorLUT<22, 3> gamma_dim{};
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(lut_math_endpoints){
+  assertNear(lutExp(0.0), 1.0, 1e-12);
+  assertNear(lutLn(1.0), 0.0, 1e-12);
+  assertNear(lutLn(0.5), -0.69314718055994530942, 1e-12);
+  assertNear(lutExp(lutLn(1.0 / 255.0) * 2.2), pow(1.0 / 255.0, 2.2), 1e-12);
+  assertNear(lutExp(-10.0), exp(-10.0), 1e-12);
+}
+
+test(table_endpoints){
+  //Off stays off at any gamma and brightness
+  assertEqual(linear_full[0], (uint8_t)0);
+  assertEqual(linear_dim[0], (uint8_t)0);
+  assertEqual(gamma_full[0], (uint8_t)0);
+  assertEqual(gamma_dim[0], (uint8_t)0);
+
+  //Full channel reaches the brightness cap, the same as Adafruit_NeoPixel::setBrightness()
+  assertEqual(linear_full[255], (uint8_t)255);
+  assertEqual(gamma_full[255], (uint8_t)255);
+  assertEqual(linear_dim[255], (uint8_t)((255 * (3 + 1)) >> 8));
+  assertEqual(gamma_dim[255], (uint8_t)((255 * (3 + 1)) >> 8));
+}
+
+test(linear_table_is_identity_at_full_brightness){
+  for(uint16_t i=0; i<256; i++){
+    assertEqual(linear_full[i], (uint8_t)i);
+  }
+}
+
+test(gamma_table_is_monotonic_and_darker){
+  for(uint16_t i=1; i<256; i++){
+    assertMoreOrEqual(gamma_full[i], gamma_full[i-1]);
+    assertLessOrEqual(gamma_full[i], linear_full[i]);
+  }
+}
+
+test(blend_endpoints_and_midpoint){
+  uint32_t a = 0xFF8000;
+  uint32_t b = 0x0040FF;
+
+  assertEqual(blendColor(a, b, 0), a);
+  assertEqual(blendColor(a, b, 256), b);
+  assertEqual(blendColor(a, b, 128), (uint32_t)0x7F607F);
+
+  assertEqual(blendColor(0x000000, 0xFFFFFF, 128), (uint32_t)0x7F7F7F);
+  assertEqual(blendColor(0xFFFFFF, 0xFFFFFF, 128), (uint32_t)0xFFFFFF);
+}
+
+test(blend_keeps_channels_separate){
+  //Red and blue share one multiply. Neither may carry into green, and they only lose truncation between them.
+  for(uint16_t t=0; t<=256; t+=16){
+    uint32_t c = blendColor(0xFF0000, 0x0000FF, t);
+    assertEqual(c & 0xFF00FF00, (uint32_t)0);
+    assertMoreOrEqual((c >> 16) + (c & 0xFF), (uint32_t)254);
+  }
+}
@@ -0,0 +1,299 @@
+#line 2 "CompositorTest.ino"
+
+#include <AUnit.h>
+
+//Values normally defined in config.h. Full brightness and linear gamma, so composed colors reach the strip unchanged.
+#define CYCLES_AT_END 2
+#define TOTAL_SYSTEM_STATIONS 100
+#define NUM_LINES 2
+#define LED_COUNT 207
+#define NUM_STATUS_LEDS 3
+#define WEB_LED 204
+#define WIFI_LED 205
+#define PWR_LED 206
+#define LED_BRIGHTNESS 255
+#define GAMMA_RED_X10 10
+#define GAMMA_GREEN_X10 10
+#define GAMMA_BLUE_X10 10
+#define LED_CHANNEL_UA 20000
+#define LED_IDLE_UA 600
+#define LED_POWER_BUDGET_MA 500
+#define MULTIPLEX_SHARED_STATIONS true
+#define FADE_MS 60000 //Long enough that every test runs in the first (not crossfading) half of the first color
+#define FRAME_MS 33
+
+#include "../../DCTransistor/FlashData.h"
+#include "../../DCTransistor/LoopProfiler.h"
+#include "../../DCTransistor/YieldMonitor.h"
+
+//Stands in for the NeoPixel strip, recording what the compositor writes and shows
+class Adafruit_NeoPixel {
+  public:
+    uint32_t pixels[LED_COUNT];
+    uint16_t writes;
+    uint16_t shows;
+    Adafruit_NeoPixel() : writes(0), shows(0) {memset(pixels, 0, sizeof(pixels));}
+    void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b){
+      pixels[n] = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+      writes++;
+    }
+    void show(){shows++;}
+};
+
+#include "../../DCTransistor/Compositor.h"
+
+/*
+Unit tests for Compositor layer dirty flags, the order trains, shared stations, special overlay and status LEDs are composed in,
+and the LED current estimate and power limiting.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define RED   0xFF0000
+#define GREEN 0x00FF00
+#define BLUE  0x0000FF
+#define WHITE 0xFFFFFF
+
+const uint32_t test_line_colors[NUM_LINES] = {RED, BLUE};
+const uint32_t test_overlay_palette[1] = {GREEN};
+const uint8_t test_leds[3] = {5, 6, 7};
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[1024];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+//Light every LED on the board white
+uint8_t all_station_leds[NUM_STATION_LEDS];
+const uint32_t white_line[1] = {WHITE};
+
+void composeAllWhite(Compositor &compositor){
+  BitSet<NUM_STATION_LEDS> state;
+  for(uint8_t k=0; k<NUM_STATION_LEDS; k++){
+    all_station_leds[k] = k;
+    state.set(k);
+  }
+  compositor.clearTrains();
+  compositor.addTrains(0, state, all_station_leds, NUM_STATION_LEDS);
+  compositor.setStatus(WEB_LED, WHITE);
+  compositor.setStatus(WIFI_LED, WHITE);
+  compositor.setStatus(PWR_LED, WHITE);
+}
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(first_render_composes_every_layer){
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+  compositor.begin(test_line_colors, NUM_LINES);
+  compositor.setStatus(PWR_LED, GREEN);
+
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)(LAYER_TRAINS | LAYER_SPECIAL | LAYER_STATUS));
+  assertTrue(compositor.render());
+  assertEqual(strip.shows, (uint16_t)1);
+  assertEqual(strip.pixels[PWR_LED], (uint32_t)GREEN);
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)0);
+
+  //Nothing changed, so nothing is written or shown
+  uint16_t writes = strip.writes;
+  assertFalse(compositor.render());
+  assertEqual(strip.writes, writes);
+  assertEqual(strip.shows, (uint16_t)1);
+  assertEqual(compositor.getFrameCount(), (uint32_t)2);
+}
+
+test(status_change_only_dirties_status_layer){
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+  compositor.begin(test_line_colors, NUM_LINES);
+
+  BitSet<3> state;
+  state.set(0);
+  compositor.addTrains(0, state, test_leds, 3);
+  compositor.render();
+
+  //Same color again isn't a change
+  compositor.setStatus(WEB_LED, 0);
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)0);
+
+  compositor.setStatus(WEB_LED, BLUE);
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)LAYER_STATUS);
+
+  uint16_t writes = strip.writes;
+  assertTrue(compositor.render());
+  assertEqual(strip.writes, (uint16_t)(writes + 1)); //Only the status pixel
+  assertEqual(strip.pixels[WEB_LED], (uint32_t)BLUE);
+  assertEqual(strip.pixels[5], (uint32_t)RED);
+  assertEqual(strip.shows, (uint16_t)2);
+
+  //Out of range status LEDs are ignored
+  compositor.setStatus(5, GREEN);
+  compositor.setStatus(LED_COUNT, GREEN);
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)0);
+}
+
+test(train_changes_only_write_changed_pixels){
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+  compositor.begin(test_line_colors, NUM_LINES);
+  compositor.render();
+
+  BitSet<3> state;
+  state.set(1);
+  compositor.clearTrains();
+  compositor.addTrains(1, state, test_leds, 3);
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)LAYER_TRAINS);
+
+  uint16_t writes = strip.writes;
+  assertTrue(compositor.render());
+  assertEqual(strip.writes, (uint16_t)(writes + 1));
+  assertEqual(strip.pixels[6], (uint32_t)BLUE);
+
+  //Redrawing the same trains marks the layer dirty but writes nothing
+  compositor.clearTrains();
+  compositor.addTrains(1, state, test_leds, 3);
+  writes = strip.writes;
+  assertFalse(compositor.render());
+  assertEqual(strip.writes, writes);
+
+  //Out of range line is ignored
+  compositor.render();
+  compositor.addTrains(NUM_LINES, state, test_leds, 3);
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)0);
+}
+
+test(render_order_trains_shared_overlay){
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+  compositor.begin(test_line_colors, NUM_LINES);
+
+  //Both lines at LED 5, only blue at LED 6
+  BitSet<3> red_state;
+  red_state.set(0);
+  BitSet<3> blue_state;
+  blue_state.set(0);
+  blue_state.set(1);
+  compositor.addTrains(0, red_state, test_leds, 3);
+  compositor.addTrains(1, blue_state, test_leds, 3);
+  compositor.render();
+
+  //Shared station starts on the first line in all_lines order, and is recomposed every frame to animate
+  assertEqual(strip.pixels[5], (uint32_t)RED);
+  assertEqual(strip.pixels[6], (uint32_t)BLUE);
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)0);
+  compositor.render();
+  assertEqual(strip.pixels[5], (uint32_t)RED);
+
+  //Special overlay is drawn over the shared station
+  compositor.setOverlay(5, test_overlay_palette, 1);
+  assertEqual(compositor.getDirtyLayers(), (uint8_t)LAYER_SPECIAL);
+  compositor.render();
+  assertEqual(strip.pixels[5], (uint32_t)GREEN);
+  assertEqual(strip.pixels[6], (uint32_t)BLUE);
+
+  //Status LEDs sit after the station LEDs, so overlays can't cover them
+  compositor.setOverlay(WEB_LED, test_overlay_palette, 1);
+  compositor.setStatus(WEB_LED, WHITE);
+  compositor.render();
+  assertEqual(strip.pixels[WEB_LED], (uint32_t)WHITE);
+
+  //Removing the overlay uncovers the shared station again
+  compositor.clearOverlay();
+  compositor.render();
+  assertEqual(strip.pixels[5], (uint32_t)RED);
+}
+
+test(current_estimate_of_known_frames){
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+  compositor.begin(test_line_colors, NUM_LINES);
+
+  //One full red channel is 20mA on top of the idle draw of 207 * 0.6mA
+  compositor.setStatus(PWR_LED, RED);
+  compositor.render();
+  assertEqual(compositor.getUnlimitedCurrentEstimate(), (uint32_t)144);
+  assertEqual(compositor.getCurrentEstimate(), (uint32_t)144);
+  assertEqual(compositor.getLimitScale(), (uint16_t)256);
+
+  //All white, 207 LEDs: 207 * (3 * 20mA + 0.6mA)
+  Compositor white(strip);
+  white.begin(white_line, 1);
+  composeAllWhite(white);
+  white.render();
+  assertEqual(white.getUnlimitedCurrentEstimate(), (uint32_t)12544);
+}
+
+test(frame_over_budget_is_scaled_into_budget){
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+  compositor.begin(white_line, 1);
+  composeAllWhite(compositor);
+  compositor.render();
+
+  //Only the current above idle can be scaled: (500 - 124) / (12544 - 124) of 256
+  assertEqual(compositor.getLimitScale(), (uint16_t)7);
+  assertLessOrEqual(compositor.getCurrentEstimate(), (uint32_t)LED_POWER_BUDGET_MA);
+  assertMoreOrEqual(compositor.getCurrentEstimate(), (uint32_t)(LED_POWER_BUDGET_MA - 50));
+
+  //Every pixel on the strip is dimmed, station and status alike
+  uint32_t dimmed = blendColor(0, WHITE, 7);
+  assertEqual(strip.pixels[0], dimmed);
+  assertEqual(strip.pixels[NUM_STATION_LEDS - 1], dimmed);
+  assertEqual(strip.pixels[PWR_LED], dimmed);
+}
+
+test(limit_scale_returns_to_256_under_budget){
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+  compositor.begin(white_line, 1);
+  composeAllWhite(compositor);
+  compositor.render();
+  assertLess(compositor.getLimitScale(), (uint16_t)256);
+
+  //Drop to one white train and the status LEDs off
+  BitSet<NUM_STATION_LEDS> state;
+  state.set(10);
+  compositor.clearTrains();
+  compositor.addTrains(0, state, all_station_leds, NUM_STATION_LEDS);
+  compositor.setStatus(WEB_LED, 0);
+  compositor.setStatus(WIFI_LED, 0);
+  compositor.setStatus(PWR_LED, 0);
+  compositor.render();
+
+  assertEqual(compositor.getLimitScale(), (uint16_t)256);
+  assertEqual(compositor.getUnlimitedCurrentEstimate(), (uint32_t)184);
+  assertEqual(compositor.getCurrentEstimate(), (uint32_t)184);
+
+  //Pixel that didn't change this frame is rewritten at full brightness
+  assertEqual(strip.pixels[10], (uint32_t)WHITE);
+  assertEqual(strip.pixels[11], (uint32_t)0);
+}
+
+test(power_metrics_format){
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+  compositor.begin(white_line, 1);
+  composeAllWhite(compositor);
+  compositor.render();
+
+  BufferPrint out;
+  compositor.printMetrics(out);
+  assertTrue(strstr(out.buf, "# TYPE dctransistor_led_current_ma gauge\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_led_current_unlimited_ma 12544\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_led_limit_scale 7\n") != NULL);
+}
@@ -0,0 +1,156 @@
+#line 2 "ConsistIndexTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/ConsistIndex.h"
+#include "consist_feed.h"
+
+/*
+Unit tests for CarSet lookups and Cars string matching, plus a host benchmark that replays a special train endpoint
+response (consist_feed.h) through CarSet and through the strtok loop it replaced, checking both find the same train.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define MAX_CONSISTS 128
+#define BENCH_REPLAYS 200
+
+const uint16_t special_cars[8] = {7412, 7413, 7106, 7107, 7318, 7319, 7200, 7201}; //Campaign order, not consist order
+
+//Cars and LinkTti strings from consist_feed, as ArduinoJson would hand them over one consist at a time
+char feed_cars[MAX_CONSISTS][50];
+int16_t feed_ids[MAX_CONSISTS];
+uint8_t num_consists = 0;
+
+void loadFeed(){
+  num_consists = 0;
+  const char* p = consist_feed;
+  while(num_consists < MAX_CONSISTS && (p = strstr(p, "\"LinkTti\":\"")) != NULL){
+    p += 11;
+    feed_ids[num_consists] = atoi(p);
+    p = strstr(p, "\"Cars\":\"") + 8;
+    uint8_t n = 0;
+    while(*p != '"' && n < sizeof(feed_cars[0]) - 1){
+      feed_cars[num_consists][n++] = *p++;
+    }
+    feed_cars[num_consists][n] = '\0';
+    num_consists++;
+  }
+}
+
+//Matching as get_special_train_id did it before CarSet: copy, strtok, atoi, nested loop
+bool legacyMatch(const char* cars, const uint16_t* special, uint8_t num_special){
+  uint8_t car_match_count = 0;
+  char tmp_car_string[50] = {0};
+  strncpy(tmp_car_string, cars, strlen(cars)+1);
+
+  char* token = strtok(tmp_car_string, ".-");
+  while(token != NULL){
+    bool match = false;
+    uint16_t car_num = atoi(token);
+    for(uint8_t i=0; i < num_special; i++){
+      if(car_num == special[i]){
+        car_match_count++;
+        match = true;
+        break;
+      }
+    }
+    if(!match){
+      break;
+    }
+    token = strtok(NULL, ".-");
+  }
+  return car_match_count == num_special;
+}
+
+void setup() {
+  Serial.begin(9600);
+  loadFeed();
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(set_sorts_and_finds){
+  CarSet<8> set;
+  set.set(special_cars, 8);
+  assertEqual(set.getCount(), (uint8_t)8);
+  for(uint8_t i=0; i<8; i++){
+    assertTrue(set.contains(special_cars[i]));
+  }
+  assertFalse(set.contains(7000));
+  assertFalse(set.contains(0));
+  assertFalse(set.contains(65535));
+
+  //Extra cars are dropped
+  CarSet<2> small;
+  small.set(special_cars, 8);
+  assertEqual(small.getCount(), (uint8_t)2);
+}
+
+test(matches_cars_string){
+  CarSet<8> set;
+  set.set(special_cars, 8);
+
+  assertTrue(set.matches("7318.7319-7200.7201-7412.7413-7106.7107"));
+  assertTrue(set.matches("7106.7107-7412.7413-7200.7201-7318.7319")); //Reversed consist
+  assertFalse(set.matches("7318.7319-7200.7201-7412.7413")); //Part of it
+  assertFalse(set.matches("7000.7001-7200.7201-7412.7413-7106.7107")); //Stops at first car
+  assertFalse(set.matches("73180.7319-7200.7201-7412.7413-7106.7107")); //Longer number isn't a prefix match
+  assertFalse(set.matches(""));
+  assertFalse(set.matches(NULL));
+
+  CarSet<8> empty;
+  assertFalse(empty.matches("7318.7319"));
+}
+
+test(replay_feed_same_as_legacy){
+  assertEqual(num_consists, (uint8_t)119);
+
+  CarSet<8> set;
+  set.set(special_cars, 8);
+
+  int16_t found = -1;
+  for(uint8_t i=0; i<num_consists; i++){
+    bool matched = set.matches(feed_cars[i]);
+    assertEqual(matched, legacyMatch(feed_cars[i], special_cars, 8));
+    if(matched){
+      assertEqual(found, (int16_t)-1);
+      found = feed_ids[i];
+    }
+  }
+  assertEqual(found, (int16_t)412);
+}
+
+test(benchmark_replay_feed){
+  volatile uint16_t hits = 0; //Keep the compiler from dropping the loops
+
+  uint32_t start = micros();
+  for(uint16_t r=0; r<BENCH_REPLAYS; r++){
+    for(uint8_t i=0; i<num_consists; i++){
+      hits += legacyMatch(feed_cars[i], special_cars, 8);
+    }
+  }
+  uint32_t legacy_us = micros() - start;
+
+  start = micros();
+  for(uint16_t r=0; r<BENCH_REPLAYS; r++){
+    CarSet<8> set; //Built once per request, like get_special_train_id
+    set.set(special_cars, 8);
+    for(uint8_t i=0; i<num_consists; i++){
+      hits += set.matches(feed_cars[i]);
+    }
+  }
+  uint32_t set_us = micros() - start;
+
+  Serial.print(F("Consist feed replay x"));
+  Serial.print(BENCH_REPLAYS);
+  Serial.print(F(": strtok loop "));
+  Serial.print(legacy_us);
+  Serial.print(F(" us, CarSet "));
+  Serial.print(set_us);
+  Serial.println(F(" us"));
+
+  assertEqual((uint16_t)hits, (uint16_t)(2 * BENCH_REPLAYS));
+}
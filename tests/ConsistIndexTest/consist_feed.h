@@ -0,0 +1,123 @@
+//Special train endpoint response (CurrentConsists) in the endpoint's format: 119 consists, special train 412 near the end.
+const char consist_feed[] =
+  "{\"DataTable\":{\"diffgr:diffgram\":{\"DocumentElement\":{\"CurrentConsists\":["
+  "{\"LinkTti\":\"101\",\"Cars\":\"6162.6163-7676.7677-7650.7651-7314.7315\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"105\",\"Cars\":\"7380.7381-7692.7693-7270.7271\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"107\",\"Cars\":\"3040.3041-6054.6055-7562.7563\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"111\",\"Cars\":\"3084.3085-3244.3245-3106.3107\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"114\",\"Cars\":\"7492.7493-3184.3185-3222.3223-7148.7149\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"117\",\"Cars\":\"3258.3259-7330.7331-7368.7369\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"120\",\"Cars\":\"7030.7031-6002.6003-6122.6123-6084.6085\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"121\",\"Cars\":\"3194.3195-7648.7649-6170.6171-7702.7703\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"124\",\"Cars\":\"3066.3067-6070.6071-7722.7723-3126.3127\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"129\",\"Cars\":\"7732.7733-3162.3163-3056.3057-7240.7241\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"132\",\"Cars\":\"7656.7657-7422.7423-7210.7211-7018.7019\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"133\",\"Cars\":\"7220.7221-7446.7447-7666.7667\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"138\",\"Cars\":\"3242.3243-7196.7197-3082.3083\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"140\",\"Cars\":\"7684.7685-6034.6035-3208.3209-7714.7715\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"142\",\"Cars\":\"7054.7055-7566.7567-7112.7113\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"145\",\"Cars\":\"7402.7403-3104.3105-7176.7177-7472.7473\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"149\",\"Cars\":\"7718.7719-7078.7079-3276.3277\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"152\",\"Cars\":\"7448.7449-2038.2039-3112.3113\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"156\",\"Cars\":\"7364.7365-7564.7565-3262.3263\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"157\",\"Cars\":\"6076.6077-3050.3051-7182.7183-7320.7321\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"160\",\"Cars\":\"7506.7507-6110.6111-3064.3065\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"163\",\"Cars\":\"7520.7521-7256.7257-3046.3047-7134.7135\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"167\",\"Cars\":\"7486.7487-7410.7411-7188.7189-7602.7603\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"171\",\"Cars\":\"3036.3037-3206.3207-7700.7701\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"172\",\"Cars\":\"7474.7475-7628.7629-7396.7397-7518.7519\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"175\",\"Cars\":\"6118.6119-6126.6127-7036.7037-7100.7101\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"180\",\"Cars\":\"3024.3025-3110.3111-6172.6173-7726.7727\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"183\",\"Cars\":\"7302.7303-6152.6153-6140.6141\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"186\",\"Cars\":\"7166.7167-2034.2035-6078.6079-7016.7017\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"188\",\"Cars\":\"7642.7643-7264.7265-2064.2065-7178.7179\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"192\",\"Cars\":\"2070.2071-7204.7205-6180.6181-7400.7401\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"193\",\"Cars\":\"7538.7539-3296.3297-7348.7349-6166.6167\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"197\",\"Cars\":\"7246.7247-7386.7387-7266.7267\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"199\",\"Cars\":\"3180.3181-2046.2047-7180.7181-7640.7641\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"202\",\"Cars\":\"3174.3175-7308.7309-7334.7335-7082.7083\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"205\",\"Cars\":\"7612.7613-2040.2041-2058.2059\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"210\",\"Cars\":\"7730.7731-7378.7379-7026.7027-7340.7341\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"211\",\"Cars\":\"7142.7143-7680.7681-3144.3145-7510.7511\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"216\",\"Cars\":\"2008.2009-7578.7579-3090.3091-6096.6097\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"218\",\"Cars\":\"7160.7161-7694.7695-7710.7711-7420.7421\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"221\",\"Cars\":\"7130.7131-7406.7407-3094.3095\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"225\",\"Cars\":\"7698.7699-7464.7465-7374.7375-7388.7389\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"228\",\"Cars\":\"3000.3001-7382.7383-7254.7255\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"230\",\"Cars\":\"7544.7545-7344.7345-6102.6103-6128.6129\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"234\",\"Cars\":\"7000.7001-6030.6031-7288.7289\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"235\",\"Cars\":\"7582.7583-6042.6043-7604.7605-7304.7305\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"238\",\"Cars\":\"6068.6069-6120.6121-6062.6063-7042.7043\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"242\",\"Cars\":\"6058.6059-7540.7541-7156.7157-6132.6133\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"246\",\"Cars\":\"3022.3023-3038.3039-3138.3139-3190.3191\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"248\",\"Cars\":\"6174.6175-7736.7737-3188.3189-2048.2049\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"251\",\"Cars\":\"7020.7021-7398.7399-7720.7721-6080.6081\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"255\",\"Cars\":\"3202.3203-3072.3073-6116.6117-7248.7249\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"258\",\"Cars\":\"3154.3155-3248.3249-3102.3103-7620.7621\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"260\",\"Cars\":\"2066.2067-7362.7363-6010.6011-6124.6125\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"262\",\"Cars\":\"7674.7675-7418.7419-3240.3241\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"265\",\"Cars\":\"7574.7575-7208.7209-7002.7003-7120.7121\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"270\",\"Cars\":\"3002.3003-7040.7041-7560.7561-7194.7195\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"272\",\"Cars\":\"3116.3117-6044.6045-6142.6143\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"275\",\"Cars\":\"7672.7673-3158.3159-7292.7293\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"279\",\"Cars\":\"7074.7075-7268.7269-7424.7425\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"282\",\"Cars\":\"3006.3007-3232.3233-3108.3109\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"285\",\"Cars\":\"2072.2073-6164.6165-7316.7317-3146.3147\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"287\",\"Cars\":\"7274.7275-7536.7537-7172.7173-3156.3157\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"290\",\"Cars\":\"2018.2019-7098.7099-6036.6037\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"292\",\"Cars\":\"7338.7339-2052.2053-7658.7659\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"297\",\"Cars\":\"7534.7535-3246.3247-7126.7127\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"300\",\"Cars\":\"7686.7687-7610.7611-3186.3187\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"303\",\"Cars\":\"6000.6001-7716.7717-3274.3275-3282.3283\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"305\",\"Cars\":\"2024.2025-2054.2055-7524.7525-7594.7595\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"308\",\"Cars\":\"3020.3021-6148.6149-7370.7371-7262.7263\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"311\",\"Cars\":\"7230.7231-7548.7549-6136.6137-7394.7395\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"313\",\"Cars\":\"7282.7283-7050.7051-3252.3253-6104.6105\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"318\",\"Cars\":\"7046.7047-3140.3141-6108.6109\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"319\",\"Cars\":\"7608.7609-7462.7463-6130.6131\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"323\",\"Cars\":\"3200.3201-7466.7467-7158.7159-7660.7661\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"327\",\"Cars\":\"7038.7039-3086.3087-6050.6051\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"330\",\"Cars\":\"7626.7627-2010.2011-7286.7287-7742.7743\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"331\",\"Cars\":\"3260.3261-7438.7439-3212.3213-3136.3137\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"334\",\"Cars\":\"7624.7625-2006.2007-6088.6089-7060.7061\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"338\",\"Cars\":\"7390.7391-3218.3219-7048.7049-7010.7011\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"341\",\"Cars\":\"6098.6099-7150.7151-7284.7285-6144.6145\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"343\",\"Cars\":\"7146.7147-7478.7479-2042.2043-3092.3093\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"347\",\"Cars\":\"7144.7145-7372.7373-7436.7437-7652.7653\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"349\",\"Cars\":\"3044.3045-3030.3031-7312.7313\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"354\",\"Cars\":\"7434.7435-7242.7243-7482.7483-6038.6039\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"357\",\"Cars\":\"2012.2013-7290.7291-7664.7665-7502.7503\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"360\",\"Cars\":\"2020.2021-7080.7081-7236.7237-3054.3055\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"363\",\"Cars\":\"7430.7431-7442.7443-7654.7655\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"366\",\"Cars\":\"3026.3027-7058.7059-7542.7543-3062.3063\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"368\",\"Cars\":\"3264.3265-6150.6151-7328.7329\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"370\",\"Cars\":\"7440.7441-6092.6093-6016.6017\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"374\",\"Cars\":\"3074.3075-7206.7207-7004.7005-3060.3061\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"377\",\"Cars\":\"7202.7203-6056.6057-3008.3009\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"381\",\"Cars\":\"6048.6049-2026.2027-3226.3227\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"384\",\"Cars\":\"7392.7393-2044.2045-3298.3299\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"386\",\"Cars\":\"3048.3049-7122.7123-7102.7103-7244.7245\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"390\",\"Cars\":\"7298.7299-7300.7301-6046.6047-7504.7505\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"412\",\"Cars\":\"7318.7319-7200.7201-7412.7413-7106.7107\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"391\",\"Cars\":\"7360.7361-7526.7527-2028.2029-7198.7199\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"395\",\"Cars\":\"3214.3215-7584.7585-7324.7325-7696.7697\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"397\",\"Cars\":\"7712.7713-2032.2033-3234.3235-7468.7469\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"401\",\"Cars\":\"7690.7691-6146.6147-7238.7239-7066.7067\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"403\",\"Cars\":\"7352.7353-3032.3033-6012.6013-7356.7357\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"407\",\"Cars\":\"6134.6135-7278.7279-6072.6073-3042.3043\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"410\",\"Cars\":\"6052.6053-3178.3179-7174.7175-7322.7323\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"414\",\"Cars\":\"7670.7671-3256.3257-7746.7747-7114.7115\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"415\",\"Cars\":\"7550.7551-7744.7745-7532.7533\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"420\",\"Cars\":\"6168.6169-7008.7009-7682.7683-7558.7559\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"423\",\"Cars\":\"6154.6155-7108.7109-7404.7405\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"425\",\"Cars\":\"6004.6005-3288.3289-6182.6183-7014.7015\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"429\",\"Cars\":\"2056.2057-3290.3291-3182.3183\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"430\",\"Cars\":\"7006.7007-7552.7553-7618.7619\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"434\",\"Cars\":\"3166.3167-7306.7307-7508.7509-2000.2001\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"436\",\"Cars\":\"7592.7593-6006.6007-7586.7587-3280.3281\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"441\",\"Cars\":\"7116.7117-3254.3255-6082.6083\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"444\",\"Cars\":\"7738.7739-3278.3279-7234.7235-6138.6139\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"447\",\"Cars\":\"7476.7477-7326.7327-7376.7377-7090.7091\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"448\",\"Cars\":\"3176.3177-7724.7725-3168.3169-7384.7385\",\"TrackName\":\"C2\"},"
+  "{\"LinkTti\":\"451\",\"Cars\":\"3198.3199-3118.3119-3210.3211-7336.7337\",\"TrackName\":\"C2\"}"
+  "]}}}}";
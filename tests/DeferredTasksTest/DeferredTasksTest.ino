@@ -0,0 +1,124 @@
+#line 2 "DeferredTasksTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/DeferredTasks.h"
+
+/*
+Unit tests for DeferredTasks ordering, periods and metrics, and a simulated boot that measures time to first
+live frame with the update / special train checks before the first poll (as setup() used to) and after it.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define CHECK_COST_MS 40 //Stand-in for one HTTPS check
+#define POLL_COST_MS 10 //Stand-in for fetching and showing a frame
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[512];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+//Order tasks ran in, as a string of ids
+char ran[16];
+uint8_t num_ran = 0;
+
+void taskA(){ ran[num_ran++] = 'A'; ran[num_ran] = '\0'; }
+void taskB(){ ran[num_ran++] = 'B'; ran[num_ran] = '\0'; }
+void slowCheck(){ delay(CHECK_COST_MS); }
+
+void resetRan(){
+  num_ran = 0;
+  ran[0] = '\0';
+}
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(one_task_per_call_in_order_added){
+  resetRan();
+  DeferredTasks<2> tasks;
+  tasks.add("a", taskA, 0, true);
+  tasks.add("b", taskB, 0, true);
+
+  assertTrue(tasks.runNext());
+  assertEqual(ran, "A");
+  assertTrue(tasks.runNext());
+  assertEqual(ran, "AB");
+  assertFalse(tasks.runNext());
+
+  //Full
+  assertEqual(tasks.add("c", taskA, 0, true), (int8_t)-1);
+}
+
+test(trigger_and_period){
+  resetRan();
+  DeferredTasks<2> tasks;
+  int8_t a = tasks.add("a", taskA, 20, false);
+  int8_t b = tasks.add("b", taskB, 0, false);
+
+  assertFalse(tasks.runNext());
+
+  tasks.trigger(b);
+  assertTrue(tasks.isPending(b));
+  assertTrue(tasks.runNext());
+  assertEqual(ran, "B");
+
+  delay(25);
+  assertTrue(tasks.runNext());
+  assertEqual(ran, "BA");
+  assertEqual(tasks.getRuns(a), (uint32_t)1);
+  assertFalse(tasks.isPending(a)); //Not due again until another period passes
+}
+
+test(metrics_per_task){
+  DeferredTasks<2> tasks;
+  tasks.add("check_update", taskA, 0, true);
+  tasks.runNext();
+
+  BufferPrint out;
+  tasks.printMetrics(out);
+  assertTrue(strstr(out.buf, "dctransistor_task_runs_total{task=\"check_update\"} 1\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_task_last_duration_ms{task=\"check_update\"} ") != NULL);
+}
+
+//Boot with both checks in setup() before the first poll, then with both deferred until after it
+test(deferred_checks_shorten_time_to_first_live_frame){
+  uint32_t boot = millis();
+  slowCheck();
+  slowCheck();
+  delay(POLL_COST_MS);
+  uint32_t blocking_ms = millis() - boot;
+
+  DeferredTasks<2> tasks;
+  boot = millis();
+  tasks.add("check_update", slowCheck, 3600000, true);
+  tasks.add("check_special", slowCheck, 3600000, true);
+  delay(POLL_COST_MS); //First loop: poll and show
+  uint32_t deferred_ms = millis() - boot;
+  tasks.runNext(); //Then first check
+
+  Serial.print(F("Time to first live frame: checks in setup "));
+  Serial.print(blocking_ms);
+  Serial.print(F(" ms, deferred "));
+  Serial.print(deferred_ms);
+  Serial.println(F(" ms"));
+
+  assertMoreOrEqual(blocking_ms, (uint32_t)(2 * CHECK_COST_MS + POLL_COST_MS));
+  assertLess(deferred_ms, (uint32_t)CHECK_COST_MS);
+  assertTrue(tasks.isPending(1)); //Second check waits for the next loop
+}
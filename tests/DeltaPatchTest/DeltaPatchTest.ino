@@ -0,0 +1,180 @@
+#line 2 "DeltaPatchTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/OtaDownload.h"
+#include "../../DCTransistor/DeltaPatch.h"
+#include "delta_fixture.h"
+
+/*
+Unit tests for DeltaPatch applying a delta made by misc_files/make_delta.py (the round trip from host tool to board),
+streamed through OtaDownload in slices: copies split across slices, full images passed through, and deltas for
+another image or with bad ops rejected.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define SLICE_BYTES 512
+#define BURST 100 //Delta bytes arriving from network between slices
+
+//Running image stand-in
+struct RamBase {
+  static const uint8_t* image;
+  static uint32_t len;
+  static const char* md5;
+  static uint32_t size(){ return len; }
+  static bool read(uint32_t offset, uint8_t* data, size_t n){
+    if(offset + n > len){return false;}
+    memcpy(data, image + offset, n);
+    return true;
+  }
+  static bool hasMd5(const char* hex){ return strcasecmp(md5, hex) == 0; }
+};
+const uint8_t* RamBase::image = base_image;
+uint32_t RamBase::len = sizeof(base_image);
+const char* RamBase::md5 = base_md5;
+
+//Update partition stand-in. Checks MD5 given to begin() is the target's, and compares bytes instead of hashing.
+struct RamOut {
+  static uint8_t data[8192];
+  static uint32_t size;
+  static uint32_t written;
+  static char hash[OTA_HASH_LEN];
+  static uint8_t aborts;
+  static bool begin(uint32_t n, const char* h){
+    if(n > sizeof(data)){return false;}
+    size = n;
+    written = 0;
+    strcpy(hash, h); /* Flawfinder: ignore */
+    return true;
+  }
+  static size_t write(const uint8_t* d, size_t n){
+    if(written + n > size){return 0;}
+    memcpy(data + written, d, n);
+    written += n;
+    return n;
+  }
+  static bool end(){
+    return written == size && size == sizeof(target_image) && memcmp(data, target_image, size) == 0 && strcmp(hash, target_md5) == 0;
+  }
+  static void abort(){ aborts++; }
+  static uint16_t room(){ return 0xFFFF; }
+  static uint16_t pump(uint16_t max_bytes){ return 0; }
+};
+uint8_t RamOut::data[8192];
+uint32_t RamOut::size = 0;
+uint32_t RamOut::written = 0;
+char RamOut::hash[OTA_HASH_LEN];
+uint8_t RamOut::aborts = 0;
+
+typedef DeltaPatch<RamBase, RamOut> TestPatch;
+
+//Response body stand-in, with BURST more bytes arriving before each slice
+class BytesStream : public Stream {
+  public:
+    const uint8_t* data;
+    uint32_t len;
+    uint32_t pos;
+    uint32_t released;
+    BytesStream(const uint8_t* data, uint32_t len) : data(data), len(len), pos(0), released(0) {}
+    void arrive(){ released = min(len, released + BURST); }
+    int available() override { return released - pos; }
+    int read() override { return (pos < released) ? data[pos++] : -1; }
+    int peek() override { return (pos < released) ? data[pos] : -1; }
+    size_t write(uint8_t) override { return 0; }
+};
+
+//Run a download of body through OtaDownload a slice at a time. Returns the most work done in one slice.
+uint16_t download(OtaDownload<TestPatch> &ota, const uint8_t* body, uint32_t len){
+  BytesStream in(body, len);
+  ota.setSize(len);
+  uint16_t most = 0;
+  for(uint16_t slice=0; slice<1000 && ota.isActive(); slice++){
+    in.arrive();
+    uint16_t work = ota.receive(in, SLICE_BYTES);
+    most = max(most, work);
+  }
+  return most;
+}
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(applies_host_tool_delta){
+  RamOut::aborts = 0;
+  RamBase::md5 = base_md5;
+  assertTrue(TestPatch::matchesBase(fixture_delta, sizeof(fixture_delta)));
+
+  OtaDownload<TestPatch> ota;
+  TestPatch::setPatching(true);
+  assertTrue(ota.begin(""));
+  uint16_t most = download(ota, fixture_delta, sizeof(fixture_delta));
+
+  assertTrue(ota.isReady());
+  assertEqual(RamOut::written, (uint32_t)sizeof(target_image));
+  assertEqual(memcmp(RamOut::data, target_image, sizeof(target_image)), 0);
+  assertEqual(TestPatch::getCopied() + TestPatch::getLiteral(), (uint32_t)sizeof(target_image));
+  assertLessOrEqual(most, (uint16_t)SLICE_BYTES); //Copies split across slices
+
+  Serial.print(F("Delta "));
+  Serial.print(sizeof(fixture_delta));
+  Serial.print(F(" bytes for "));
+  Serial.print(sizeof(target_image));
+  Serial.print(F(" byte image ("));
+  Serial.print(TestPatch::getCopied());
+  Serial.println(F(" bytes copied from running image)"));
+  assertLess(sizeof(fixture_delta) * 10, sizeof(target_image));
+}
+
+test(full_image_passes_through){
+  OtaDownload<TestPatch> ota;
+  TestPatch::setPatching(false);
+  assertTrue(ota.begin(target_md5));
+  download(ota, target_image, sizeof(target_image));
+
+  assertTrue(ota.isReady());
+  assertEqual(memcmp(RamOut::data, target_image, sizeof(target_image)), 0);
+}
+
+test(delta_for_another_image_rejected){
+  RamOut::aborts = 0;
+  RamBase::md5 = "00000000000000000000000000000000";
+  assertFalse(TestPatch::matchesBase(fixture_delta, sizeof(fixture_delta)));
+
+  OtaDownload<TestPatch> ota;
+  TestPatch::setPatching(true);
+  ota.begin("");
+  download(ota, fixture_delta, sizeof(fixture_delta));
+  assertEqual(ota.getState(), OTA_FAILED);
+  assertEqual(RamOut::aborts, (uint8_t)0); //Never started writing
+
+  RamBase::md5 = base_md5;
+  assertFalse(TestPatch::matchesBase(fixture_delta, DELTA_HEADER_LEN - 1));
+}
+
+test(bad_op_aborts){
+  RamOut::aborts = 0;
+  uint8_t corrupt[sizeof(fixture_delta)];
+  memcpy(corrupt, fixture_delta, sizeof(fixture_delta));
+  corrupt[DELTA_HEADER_LEN] = 0x7F; //First op
+
+  OtaDownload<TestPatch> ota;
+  TestPatch::setPatching(true);
+  ota.begin("");
+  download(ota, corrupt, sizeof(corrupt));
+  assertEqual(ota.getState(), OTA_FAILED);
+  assertEqual(RamOut::aborts, (uint8_t)1);
+}
+
+test(truncated_delta_fails){
+  OtaDownload<TestPatch> ota;
+  TestPatch::setPatching(true);
+  ota.begin("");
+  download(ota, fixture_delta, sizeof(fixture_delta) - 10); //Server sends a shorter file
+  assertEqual(ota.getState(), OTA_FAILED);
+}
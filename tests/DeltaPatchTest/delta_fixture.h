@@ -0,0 +1,367 @@
+//Delta fixture made with misc_files/make_delta.py diff: a 4 KB base image and a release of it with the version bumped,
+//64 bytes of new code at 1024 and every 256th word after that (standing in for addresses) moved by 64.
+const char base_md5[] = "fa8b0466f5cffe1a0eb2585b5782b80f";
+const char target_md5[] = "ddd1d4237ca9465e9cafce0a956d6ddd";
+
+const uint8_t base_image[4096] = {
+  0x52, 0xf2, 0x26, 0x65, 0xa6, 0x0c, 0x12, 0xd2, 0x89, 0x18, 0x5d, 0x95, 0x0e, 0xe8, 0x81, 0x36, 0x09, 0x16, 0x6f, 0x6b, 0x11, 0x3d, 0x17, 0x8d,
+  0x6c, 0x0f, 0xd3, 0x90, 0x1f, 0xf2, 0x39, 0xa1, 0xa0, 0x95, 0xf2, 0x0f, 0x93, 0x95, 0x65, 0x0c, 0xf9, 0x38, 0x0b, 0x8e, 0xdb, 0x22, 0x4a, 0x6b,
+  0x24, 0x8a, 0x1e, 0x92, 0x4e, 0x8f, 0xd0, 0xae, 0x2e, 0x1a, 0x94, 0x92, 0xa3, 0x30, 0x5f, 0x18, 0x8c, 0xb6, 0x10, 0x90, 0x0f, 0x9e, 0x34, 0x7f,
+  0xae, 0x88, 0x6d, 0xc6, 0x50, 0x77, 0x95, 0xec, 0x74, 0x5c, 0x4c, 0x3f, 0xcb, 0x2e, 0xb2, 0xc7, 0x3e, 0x14, 0x93, 0x4c, 0x86, 0x7e, 0xe0, 0x57,
+  0xba, 0x72, 0x49, 0x9b, 0xfa, 0x12, 0x1e, 0x83, 0x6b, 0x2a, 0xc1, 0x57, 0x26, 0xee, 0x7d, 0x6b, 0x0a, 0xf6, 0xab, 0x13, 0xc3, 0x8e, 0x92, 0xca,
+  0xe0, 0xd1, 0x50, 0x57, 0xb1, 0x59, 0x98, 0x7f, 0x94, 0xcc, 0x74, 0x11, 0xd7, 0x17, 0xf1, 0x45, 0x79, 0xb2, 0xaa, 0x10, 0x0f, 0xbb, 0xb3, 0x4f,
+  0xa5, 0x93, 0xfe, 0xae, 0xd2, 0x72, 0x48, 0xb7, 0x62, 0xe3, 0xab, 0x58, 0x05, 0xf0, 0x76, 0x5a, 0x2b, 0x9c, 0x1d, 0x7e, 0x0f, 0x37, 0xc4, 0x49,
+  0x21, 0xbd, 0x3f, 0x65, 0x64, 0xea, 0xdf, 0x7f, 0x14, 0x2a, 0x72, 0x66, 0x8c, 0x47, 0xe2, 0x23, 0xd1, 0x6e, 0xdd, 0x8c, 0x47, 0xb4, 0x6a, 0xfc,
+  0x5b, 0xae, 0xe2, 0x61, 0xf5, 0x3b, 0x26, 0x15, 0x2d, 0x26, 0x3b, 0xa8, 0x3b, 0x03, 0x7c, 0xd4, 0x96, 0x2e, 0x43, 0x48, 0x01, 0x25, 0x6b, 0x88,
+  0x5e, 0x9c, 0x90, 0x51, 0xf3, 0x20, 0xb0, 0xdb, 0x83, 0xf3, 0x9e, 0xa7, 0xad, 0xbd, 0x0d, 0x74, 0xe6, 0xde, 0xc7, 0xf3, 0xdf, 0xae, 0xcc, 0x8f,
+  0x64, 0x65, 0x66, 0x64, 0x1a, 0x7b, 0xa2, 0x66, 0x0f, 0x30, 0x11, 0xfc, 0x35, 0x70, 0x29, 0x1c, 0x57, 0x99, 0x0d, 0x1a, 0x00, 0x91, 0x26, 0x89,
+  0x19, 0xf2, 0x5d, 0x9d, 0x06, 0x12, 0xdf, 0x35, 0x9d, 0x60, 0x26, 0xa2, 0x40, 0xf4, 0x58, 0x9a, 0x5d, 0x79, 0x1f, 0x1d, 0xd9, 0x7c, 0xfe, 0xfa,
+  0x77, 0x7a, 0x7b, 0x4f, 0x15, 0x24, 0x1a, 0xbf, 0x57, 0xbd, 0x43, 0x7a, 0xd4, 0xb1, 0x29, 0x84, 0x05, 0x34, 0xf3, 0xf3, 0x87, 0x5c, 0x25, 0xb0,
+  0x8b, 0xea, 0x06, 0xc2, 0x87, 0x4c, 0xfa, 0xa4, 0xdd, 0x17, 0xb2, 0xd8, 0x42, 0x84, 0x5d, 0xe8, 0x2a, 0x5b, 0xc5, 0x39, 0x88, 0x8a, 0xc7, 0x80,
+  0x54, 0xa2, 0x39, 0x9c, 0xcf, 0xc9, 0xfc, 0xc2, 0xda, 0x31, 0xce, 0x3d, 0xd1, 0x66, 0xbd, 0xcd, 0x3a, 0x33, 0x84, 0x7e, 0x5b, 0xbb, 0x07, 0xfd,
+  0x07, 0xca, 0x47, 0x78, 0x42, 0x31, 0xb1, 0x9a, 0xf4, 0x58, 0x72, 0xce, 0xef, 0xb9, 0xfc, 0x59, 0xf4, 0xf9, 0x5d, 0x14, 0x38, 0x1a, 0x3a, 0x78,
+  0x32, 0x56, 0x34, 0x7b, 0x9f, 0xfc, 0xe6, 0x9c, 0xd7, 0x00, 0x7a, 0xe8, 0xa7, 0x58, 0xcc, 0xa4, 0x15, 0xd5, 0xa9, 0x1e, 0xe8, 0x63, 0xc8, 0xb6,
+  0xc0, 0x33, 0x7a, 0xe3, 0x2d, 0x6f, 0xca, 0xa2, 0x55, 0x16, 0xcd, 0xf2, 0xf8, 0xb8, 0x65, 0x76, 0x66, 0xbe, 0xf2, 0x15, 0xb9, 0x28, 0x2b, 0xfe,
+  0x20, 0x07, 0x26, 0x97, 0xe7, 0x77, 0xce, 0xa7, 0x25, 0x9c, 0xd3, 0x98, 0xfa, 0x79, 0xa8, 0xef, 0x59, 0x27, 0x8c, 0x8c, 0x21, 0x05, 0x03, 0xcc,
+  0xf8, 0xb9, 0xa6, 0x1a, 0x86, 0xbf, 0xef, 0x23, 0x6f, 0xfc, 0xdf, 0x31, 0xd3, 0xdf, 0x36, 0x07, 0x40, 0x36, 0x4a, 0x80, 0x3d, 0xc3, 0x96, 0x53,
+  0x42, 0x8b, 0x6b, 0xd5, 0x21, 0x0f, 0xe8, 0xbd, 0x5a, 0xe5, 0x75, 0xa9, 0x95, 0xd0, 0xe7, 0x84, 0x6b, 0xd3, 0xea, 0xe0, 0x80, 0x21, 0x88, 0x26,
+  0x86, 0x82, 0x04, 0xdf, 0x70, 0xc6, 0x2e, 0x9b, 0x01, 0xc6, 0xcc, 0x26, 0x2c, 0x24, 0x79, 0x9e, 0xb9, 0x1e, 0x8e, 0x0f, 0x53, 0xae, 0x84, 0x87,
+  0x8e, 0x7b, 0xc8, 0xc6, 0x1b, 0xe2, 0x8f, 0x0e, 0x3f, 0x30, 0x46, 0x0a, 0xc5, 0x19, 0x81, 0x73, 0x8f, 0x07, 0xc2, 0xe4, 0xe9, 0x10, 0x71, 0x53,
+  0x9c, 0xf9, 0x81, 0x9b, 0x83, 0x33, 0xb1, 0x46, 0x73, 0x82, 0x88, 0xce, 0x7a, 0x81, 0xf1, 0x3f, 0xb2, 0x85, 0xe0, 0xe0, 0xf1, 0xed, 0x42, 0xec,
+  0x8f, 0xe4, 0xf1, 0x33, 0xd7, 0x72, 0x23, 0x6a, 0x1f, 0x64, 0x71, 0x50, 0x12, 0xab, 0x3d, 0x6d, 0x12, 0x36, 0xab, 0x4d, 0xc8, 0x1f, 0xe5, 0xc6,
+  0x27, 0xf0, 0xb7, 0xa4, 0xa9, 0x5d, 0x24, 0x40, 0xe2, 0x23, 0xf7, 0x77, 0x38, 0xbf, 0xf3, 0x18, 0x65, 0xe2, 0x7c, 0x29, 0xfd, 0xaa, 0xd5, 0x39,
+  0x29, 0xb4, 0x6e, 0xfe, 0x83, 0x67, 0x56, 0x6b, 0x32, 0x5b, 0x51, 0x17, 0xb8, 0x5d, 0x04, 0x56, 0x8d, 0x75, 0x70, 0xb4, 0x04, 0x62, 0x54, 0x84,
+  0x9f, 0x4b, 0x83, 0xf5, 0x10, 0x1c, 0xfc, 0xeb, 0xc9, 0x3a, 0xf8, 0xe0, 0x1a, 0x15, 0x43, 0x45, 0x0a, 0xe7, 0xc7, 0x2e, 0x45, 0xc1, 0x21, 0xd1,
+  0x6c, 0xd9, 0xe9, 0xad, 0xd1, 0xf2, 0x42, 0x67, 0x26, 0x89, 0xeb, 0x83, 0x92, 0x7e, 0xb3, 0x53, 0x16, 0x47, 0x0e, 0xcc, 0xb0, 0x2e, 0x6c, 0xe5,
+  0x12, 0x44, 0xf0, 0x04, 0xa2, 0x16, 0xcd, 0x42, 0x15, 0x9b, 0xdb, 0x38, 0x11, 0x43, 0xdc, 0x1f, 0x74, 0x02, 0x56, 0xfe, 0x8d, 0x6a, 0xed, 0xea,
+  0x44, 0x9f, 0x21, 0x0b, 0x86, 0xb5, 0x3d, 0xf0, 0x1c, 0xf8, 0x29, 0x43, 0x0c, 0x2e, 0x33, 0xee, 0x4f, 0xa0, 0x4e, 0x87, 0xc2, 0x34, 0x4a, 0x72,
+  0x80, 0xac, 0x2d, 0x45, 0x58, 0xcd, 0x04, 0xfe, 0x40, 0x09, 0x03, 0x04, 0xbb, 0x81, 0x8d, 0xfa, 0x30, 0x83, 0x79, 0x3e, 0xef, 0x72, 0x1b, 0xa8,
+  0xd1, 0xa6, 0x6e, 0xa8, 0x7e, 0x8b, 0xd5, 0xe3, 0x64, 0xf8, 0x81, 0x4e, 0xb0, 0x37, 0xfb, 0x3a, 0x57, 0x32, 0xd5, 0xe1, 0xb4, 0xba, 0xa2, 0x23,
+  0x67, 0xfd, 0x58, 0xfb, 0x0d, 0xd6, 0x21, 0x03, 0x12, 0xa0, 0xbd, 0xe1, 0x41, 0x6e, 0x29, 0x0e, 0x15, 0xaa, 0xd7, 0x61, 0xde, 0x81, 0xab, 0xf8,
+  0x48, 0x99, 0x3e, 0xb1, 0x4b, 0x0b, 0x75, 0x2f, 0x28, 0x44, 0x72, 0x00, 0x43, 0x5d, 0xf6, 0x54, 0xf8, 0xfc, 0x8c, 0x52, 0x3e, 0x08, 0xf7, 0xe1,
+  0x4f, 0x37, 0x5b, 0x2e, 0x00, 0x55, 0x61, 0x15, 0x79, 0x47, 0x80, 0xa7, 0x33, 0x3f, 0x81, 0xc6, 0x01, 0x17, 0x43, 0xd1, 0x16, 0x24, 0x66, 0x96,
+  0x0a, 0x64, 0x05, 0x4c, 0x4d, 0xa1, 0x3b, 0x15, 0x95, 0xf5, 0x87, 0xda, 0xc0, 0x27, 0xa8, 0xe4, 0xb7, 0xc8, 0xe1, 0x98, 0x63, 0xc3, 0x53, 0xb8,
+  0xfc, 0x7e, 0x26, 0x48, 0xb9, 0x9e, 0xa4, 0x25, 0x0b, 0xd3, 0xd5, 0xb7, 0xe4, 0x83, 0xa0, 0x6d, 0xbb, 0xb3, 0xcf, 0x81, 0x23, 0xe8, 0x86, 0xc0,
+  0x81, 0x91, 0xd5, 0xd0, 0xcd, 0x04, 0xd3, 0xaf, 0x95, 0xcc, 0xe4, 0xb6, 0xae, 0xf4, 0xb1, 0xa4, 0x3a, 0x15, 0x07, 0x0a, 0x22, 0xa3, 0x5c, 0xf5,
+  0x1a, 0x60, 0xd5, 0x73, 0x8e, 0x0c, 0xa0, 0x04, 0xa0, 0x88, 0xae, 0x3e, 0x7d, 0x43, 0x00, 0x74, 0xcc, 0x11, 0xbf, 0xee, 0x80, 0xe5, 0x89, 0x17,
+  0xa8, 0x86, 0x10, 0xbe, 0xbc, 0x79, 0x40, 0xcf, 0x13, 0xd8, 0x43, 0x3c, 0xba, 0xc1, 0x34, 0x3b, 0xbd, 0xa6, 0xf9, 0x75, 0x7e, 0xd8, 0x61, 0x13,
+  0x7a, 0xe9, 0xaf, 0x49, 0xc4, 0x0b, 0x9d, 0xa1, 0xa4, 0x32, 0x13, 0x99, 0x25, 0x54, 0x41, 0xa6, 0xbe, 0xb1, 0x4d, 0x9f, 0x91, 0x22, 0x03, 0x7b,
+  0x0f, 0x7c, 0x44, 0xf8, 0xac, 0x19, 0xb1, 0x37, 0xac, 0x7d, 0x4a, 0xb5, 0x84, 0x49, 0x76, 0x77, 0x77, 0xc4, 0x1e, 0xfe, 0xe4, 0x8c, 0x33, 0x4f,
+  0xfa, 0x15, 0xef, 0x79, 0x04, 0x4a, 0x75, 0x13, 0xd1, 0x81, 0xf7, 0xfe, 0x73, 0xfe, 0x44, 0x63, 0x35, 0xea, 0xf2, 0xee, 0x35, 0x13, 0x94, 0x17,
+  0x24, 0xbf, 0x86, 0x43, 0xf3, 0x5c, 0x21, 0x9a, 0xd1, 0xa1, 0x82, 0x47, 0xe3, 0x1c, 0xb4, 0x5d, 0x3b, 0x7f, 0xe5, 0xe0, 0x7c, 0x64, 0x06, 0x28,
+  0x00, 0xf3, 0x7d, 0xae, 0x73, 0x67, 0x4d, 0xba, 0x24, 0x6a, 0x58, 0x60, 0x50, 0x1e, 0xd7, 0x54, 0x00, 0x53, 0xc0, 0x56, 0xd6, 0x65, 0x1e, 0xf0,
+  0xed, 0x32, 0xb6, 0x03, 0xe6, 0xbd, 0x4a, 0x40, 0x5f, 0x10, 0x64, 0x63, 0xff, 0xde, 0x96, 0x13, 0x5c, 0xec, 0x6d, 0xc1, 0x46, 0xda, 0x0c, 0x47,
+  0x1a, 0x0d, 0xd5, 0xa9, 0x49, 0xa2, 0xef, 0x26, 0x3f, 0xf8, 0x44, 0x6f, 0x82, 0x50, 0x30, 0xc5, 0x5f, 0xc8, 0xf4, 0x6d, 0xe2, 0x07, 0xcf, 0xc2,
+  0xa1, 0x66, 0xe9, 0xe0, 0xf0, 0x8d, 0x8c, 0x34, 0xb8, 0x14, 0x0c, 0xee, 0xbb, 0x69, 0x73, 0x9d, 0xc0, 0x23, 0xa4, 0xde, 0x49, 0x7c, 0x0c, 0xe9,
+  0xed, 0x8c, 0x20, 0x2b, 0x78, 0x6a, 0x57, 0x48, 0x4c, 0x41, 0xbd, 0xbd, 0xf9, 0xa7, 0x42, 0x67, 0xa7, 0x3d, 0x4d, 0x7b, 0x8e, 0xab, 0x64, 0x1e,
+  0x2a, 0xa4, 0x29, 0x13, 0x35, 0x80, 0xe7, 0xcf, 0x7f, 0x8c, 0x38, 0x73, 0xe8, 0x55, 0xff, 0xc2, 0x73, 0x6d, 0x23, 0x8c, 0x31, 0x3e, 0x17, 0x2c,
+  0x57, 0x8e, 0x17, 0x51, 0x3d, 0x5e, 0x42, 0xcf, 0x91, 0x33, 0xe3, 0x05, 0xbf, 0xde, 0x69, 0x62, 0x69, 0xbe, 0x86, 0x35, 0x60, 0x45, 0x56, 0xc0,
+  0x0f, 0x7f, 0x47, 0x93, 0xf7, 0x5c, 0x20, 0xaf, 0x80, 0x87, 0xa1, 0xca, 0xdc, 0xd9, 0x37, 0x17, 0x45, 0xe5, 0x3f, 0x62, 0x66, 0xa5, 0x72, 0x6e,
+  0xf4, 0x4f, 0xd9, 0xd0, 0xdf, 0xf7, 0x05, 0x20, 0x08, 0x6c, 0xb5, 0xc3, 0xe5, 0xcd, 0x79, 0xf7, 0x96, 0x7d, 0x00, 0x12, 0x64, 0xee, 0xed, 0xed,
+  0xd3, 0x87, 0xda, 0x77, 0xf8, 0x72, 0x3f, 0xc8, 0x1b, 0x39, 0x27, 0x26, 0x85, 0xf8, 0xae, 0x1b, 0xf1, 0xd3, 0xb8, 0xb3, 0xa5, 0xd8, 0xc3, 0xe5,
+  0x75, 0x15, 0x8d, 0xc6, 0x0a, 0x00, 0xc8, 0x20, 0x3b, 0x91, 0xeb, 0x09, 0xa5, 0xb7, 0x4d, 0xf6, 0x20, 0xa0, 0x40, 0x87, 0xa2, 0x6f, 0xb2, 0xc3,
+  0x1c, 0x19, 0x12, 0x4c, 0x86, 0xf1, 0x95, 0x31, 0x63, 0x42, 0x39, 0xca, 0x99, 0x00, 0x02, 0x89, 0x4d, 0xff, 0x75, 0x47, 0xf5, 0x50, 0xa5, 0xd6,
+  0xe2, 0x3e, 0x79, 0x86, 0x3c, 0x8c, 0x3f, 0x07, 0xf5, 0x69, 0xb4, 0xa6, 0x4e, 0x0e, 0x05, 0x31, 0x7f, 0xe2, 0xac, 0xa5, 0x6b, 0x14, 0x41, 0x3a,
+  0xaa, 0x6c, 0xec, 0x5e, 0x3a, 0x7e, 0x08, 0xb2, 0x56, 0xb7, 0x6b, 0x5c, 0xae, 0x65, 0x32, 0x01, 0xcc, 0x4a, 0xbd, 0xd8, 0x81, 0x11, 0x34, 0x7e,
+  0xf8, 0x33, 0x4f, 0xc4, 0xd1, 0x31, 0x3b, 0x77, 0x38, 0x43, 0xc2, 0xe3, 0x4b, 0x1b, 0xf3, 0x9f, 0x7e, 0x9c, 0x2f, 0xe5, 0x39, 0x7c, 0x6a, 0xe9,
+  0xaa, 0x0e, 0xf2, 0x98, 0x25, 0xec, 0x64, 0x0d, 0x36, 0x06, 0xf9, 0x98, 0x24, 0x6a, 0x0d, 0xb5, 0x0f, 0x2f, 0x64, 0x73, 0xe5, 0xb6, 0xe2, 0x50,
+  0xbb, 0x1c, 0xff, 0x14, 0xee, 0x2a, 0x54, 0x30, 0x2f, 0xa7, 0xef, 0x86, 0xbf, 0x77, 0x08, 0x4f, 0xaa, 0xb9, 0x60, 0xd6, 0x5f, 0xfc, 0x54, 0x71,
+  0x2b, 0x1b, 0x00, 0x14, 0x47, 0x14, 0x59, 0x6b, 0xf4, 0xe2, 0x1f, 0x8f, 0xf6, 0xc2, 0x35, 0x61, 0x5b, 0xc4, 0xd2, 0x4f, 0xd2, 0xcd, 0x6e, 0x16,
+  0x0c, 0xb4, 0x79, 0x32, 0x5f, 0x8a, 0xeb, 0x72, 0x31, 0x52, 0x5d, 0xbc, 0xe5, 0x79, 0x07, 0xa1, 0x69, 0x3f, 0xcf, 0xa0, 0xc4, 0x67, 0x0a, 0x60,
+  0x08, 0x76, 0x10, 0xcd, 0xeb, 0x0f, 0x41, 0x31, 0xbf, 0x10, 0xe6, 0x9b, 0x56, 0x5c, 0x45, 0x55, 0xf5, 0xf4, 0x9d, 0x0b, 0x43, 0xbf, 0xb7, 0xb0,
+  0x51, 0xec, 0x46, 0x4c, 0x00, 0xb8, 0xc1, 0x98, 0xea, 0xce, 0xa2, 0xf2, 0xf1, 0x10, 0x06, 0xd3, 0x3b, 0x1b, 0x79, 0xb7, 0xf4, 0x77, 0xf4, 0xc6,
+  0x62, 0xca, 0x40, 0xe9, 0x6e, 0xd0, 0x7e, 0x21, 0xed, 0x7f, 0x2e, 0x02, 0xcd, 0xee, 0xbd, 0x4d, 0xd2, 0xb1, 0xc5, 0x26, 0x9b, 0x3c, 0x53, 0xdc,
+  0x51, 0x75, 0x5c, 0xc8, 0xc8, 0x98, 0x14, 0x83, 0x32, 0x64, 0xc0, 0x28, 0x3f, 0x68, 0x10, 0xa6, 0x08, 0x7b, 0x8d, 0x8b, 0x53, 0x29, 0xfa, 0x6d,
+  0xe2, 0x1a, 0xfc, 0x12, 0x43, 0x9f, 0x15, 0x35, 0x18, 0x6b, 0x7f, 0xfd, 0xb5, 0xf8, 0x72, 0x2c, 0x3b, 0x22, 0x6a, 0x75, 0x9e, 0xe4, 0xac, 0x3c,
+  0xbf, 0x89, 0xd8, 0xc6, 0xaa, 0xc2, 0x1f, 0xc7, 0xd7, 0x4b, 0x4b, 0x47, 0x91, 0x44, 0x5f, 0x41, 0xbc, 0x42, 0x32, 0x70, 0x3f, 0x2f, 0x3e, 0x3c,
+  0x27, 0x48, 0xe2, 0xe8, 0x94, 0x30, 0x53, 0x10, 0x65, 0x40, 0xfe, 0x3e, 0x81, 0x86, 0x3b, 0xa6, 0xce, 0x19, 0xa7, 0x76, 0xfd, 0x09, 0x1a, 0x01,
+  0x79, 0xe2, 0xd1, 0x3b, 0xd7, 0x72, 0xea, 0x5f, 0x0a, 0xe0, 0x4b, 0x3b, 0x1e, 0x0c, 0x30, 0x99, 0xf9, 0xd3, 0x95, 0x31, 0xee, 0x13, 0x5f, 0x83,
+  0xdd, 0x2d, 0x72, 0x9a, 0x42, 0xc6, 0xc7, 0xaa, 0xf2, 0x01, 0x1b, 0xa3, 0x98, 0xb5, 0x9e, 0x59, 0x37, 0x09, 0x5e, 0x57, 0x24, 0x0b, 0x34, 0xff,
+  0x41, 0x09, 0x99, 0xbb, 0xa6, 0xe9, 0x34, 0xd0, 0x02, 0xd1, 0x53, 0x68, 0xad, 0x5f, 0x2f, 0x9e, 0x4f, 0x13, 0x34, 0x08, 0xcb, 0x7e, 0x8c, 0x7b,
+  0x10, 0x68, 0x19, 0xcb, 0x65, 0xa9, 0x8c, 0x27, 0xa3, 0x88, 0x17, 0xa7, 0x29, 0x65, 0xb2, 0x45, 0x68, 0xfc, 0x48, 0xaa, 0x4e, 0x6a, 0xf4, 0x0d,
+  0x4f, 0xbe, 0x91, 0xe2, 0x5b, 0x6a, 0x6a, 0x04, 0xdd, 0xc4, 0xff, 0xcd, 0x5d, 0xa4, 0x32, 0x64, 0xba, 0x67, 0x34, 0xf1, 0x01, 0x6f, 0xe6, 0x28,
+  0x6c, 0x1d, 0xd2, 0x17, 0x67, 0x93, 0xe2, 0x5d, 0x75, 0xc5, 0x29, 0x21, 0x03, 0x0d, 0x8d, 0x24, 0xa4, 0xce, 0xe8, 0x65, 0x16, 0x92, 0x9f, 0xed,
+  0x5e, 0xbc, 0x81, 0x2b, 0x25, 0x59, 0x48, 0x29, 0x85, 0x2b, 0xec, 0x11, 0x1b, 0x62, 0x7d, 0xc0, 0xce, 0xca, 0xf7, 0xce, 0x32, 0x4d, 0x20, 0xd6,
+  0xf1, 0x0b, 0xf9, 0xe9, 0x7b, 0x50, 0x0d, 0x9b, 0xed, 0xa2, 0x63, 0x16, 0xe7, 0xb6, 0x9e, 0xb0, 0xd3, 0xe4, 0x29, 0xa3, 0xc9, 0xdb, 0x38, 0x9e,
+  0x67, 0x9d, 0xd8, 0x32, 0xd4, 0x79, 0x2e, 0x90, 0x37, 0x0a, 0x66, 0xf0, 0x84, 0x28, 0x62, 0x5b, 0x1f, 0x26, 0x3f, 0xf8, 0xb9, 0xd0, 0xe5, 0x31,
+  0x0a, 0xe2, 0x8f, 0xd7, 0xc1, 0xac, 0x09, 0xaa, 0xd6, 0x52, 0x1e, 0x63, 0x99, 0x74, 0x8c, 0xd9, 0xa0, 0xc7, 0x4e, 0xa6, 0x6b, 0x4e, 0x95, 0x3f,
+  0x6c, 0x63, 0xa8, 0x5e, 0x72, 0x80, 0x70, 0x2d, 0x05, 0x00, 0x9e, 0xfc, 0x7d, 0x77, 0x3c, 0x72, 0xc3, 0x9e, 0xc7, 0xd1, 0x75, 0xd6, 0x2d, 0xcf,
+  0x79, 0x66, 0x1b, 0x11, 0x20, 0x5b, 0x6e, 0x5d, 0x17, 0xcd, 0x71, 0x81, 0x82, 0xa8, 0x0a, 0x0a, 0xa2, 0x21, 0x15, 0xec, 0xbb, 0x50, 0xc7, 0xb8,
+  0x82, 0x14, 0x0d, 0xc0, 0x81, 0xe5, 0x60, 0xa7, 0xf3, 0xc8, 0x22, 0x06, 0xdb, 0x10, 0xff, 0x9d, 0xbb, 0xb1, 0xd0, 0x1c, 0x31, 0x21, 0xfb, 0xe2,
+  0x7d, 0x49, 0xf4, 0xcf, 0xea, 0xcb, 0x2a, 0xaf, 0xc9, 0xb8, 0xee, 0x38, 0x10, 0xd5, 0x59, 0x9c, 0xc1, 0x40, 0x28, 0x52, 0xe5, 0x9d, 0x46, 0xe7,
+  0xd0, 0x74, 0x24, 0x41, 0x80, 0xf6, 0xeb, 0x7a, 0x35, 0x97, 0x43, 0x9d, 0x81, 0x3c, 0x51, 0x5f, 0x09, 0x32, 0x2e, 0x67, 0x29, 0xa2, 0xef, 0x47,
+  0xad, 0x53, 0xe5, 0x60, 0x2b, 0xca, 0xc8, 0x43, 0x1d, 0xc4, 0x87, 0x0c, 0xa2, 0xdb, 0x5c, 0xf7, 0xdf, 0x73, 0x8e, 0x85, 0x94, 0xb0, 0xe1, 0xe5,
+  0x1a, 0x40, 0xfe, 0x89, 0xa1, 0xdb, 0x64, 0xbc, 0xcc, 0x5f, 0x43, 0x60, 0xfd, 0x5e, 0x93, 0x25, 0x5c, 0x54, 0xc3, 0x14, 0x71, 0x3a, 0x2d, 0x9d,
+  0xbe, 0xf5, 0x0c, 0x4b, 0xd1, 0x84, 0x40, 0x4f, 0xa3, 0xf7, 0xfb, 0xde, 0x95, 0xed, 0xa9, 0xe5, 0x50, 0xbb, 0x00, 0xbf, 0x08, 0x38, 0x26, 0x4a,
+  0x9d, 0xa0, 0x6e, 0x6a, 0x83, 0x5d, 0xe5, 0x0c, 0x21, 0x7d, 0x3a, 0x9c, 0xa7, 0x0b, 0x05, 0x0d, 0x00, 0x91, 0x5a, 0x4d, 0x1b, 0x85, 0x5b, 0x88,
+  0x39, 0x69, 0x95, 0x4d, 0x96, 0x22, 0x34, 0x5d, 0x9f, 0xd4, 0x79, 0x28, 0x22, 0x03, 0xef, 0xcd, 0x3e, 0xb5, 0x26, 0x73, 0x18, 0x10, 0xa3, 0x25,
+  0xdf, 0xaa, 0xc8, 0x45, 0x66, 0xcf, 0x43, 0xf7, 0x02, 0x0e, 0xa5, 0xd2, 0x8f, 0xe4, 0x59, 0x98, 0xa5, 0x94, 0x71, 0x9a, 0xef, 0x84, 0xbb, 0x7e,
+  0x3f, 0x2a, 0xe7, 0x00, 0x0b, 0x0f, 0x88, 0x06, 0x67, 0x2f, 0x3c, 0x28, 0x0e, 0xe9, 0xc7, 0x1a, 0x03, 0x9c, 0x8d, 0xa8, 0xf0, 0x32, 0x24, 0x69,
+  0x33, 0x84, 0x9b, 0xa4, 0x81, 0xa5, 0xa4, 0x6a, 0xd0, 0x9c, 0x2c, 0x82, 0x4f, 0x10, 0x4c, 0xa0, 0x0c, 0xfe, 0xe3, 0xb9, 0xc8, 0x7a, 0xb7, 0x89,
+  0x01, 0x60, 0xd8, 0x6f, 0xbe, 0xe9, 0x77, 0x14, 0xbd, 0xa7, 0x73, 0x2c, 0x39, 0xff, 0x1a, 0x42, 0x3b, 0xa4, 0x09, 0x1f, 0x55, 0xe4, 0xbf, 0xec,
+  0xb1, 0xf1, 0xd8, 0x43, 0xb6, 0x0d, 0x44, 0xa2, 0x8d, 0xad, 0x6f, 0xaf, 0xc9, 0xea, 0x85, 0xf8, 0x43, 0x4b, 0xa4, 0xed, 0xf7, 0xe4, 0x37, 0x15,
+  0xe1, 0x81, 0x03, 0x2b, 0x42, 0xe7, 0x3c, 0xd7, 0xbe, 0x33, 0xf1, 0x28, 0xbf, 0xea, 0x53, 0x31, 0xe1, 0x63, 0x54, 0x99, 0x3d, 0x61, 0xe8, 0xda,
+  0xa1, 0xeb, 0xb1, 0xfb, 0xaa, 0xd7, 0xfa, 0x89, 0x78, 0x78, 0xd6, 0x87, 0xb2, 0x01, 0xdb, 0x06, 0x6f, 0xf4, 0xb9, 0x3b, 0x92, 0xe2, 0x4e, 0xca,
+  0x36, 0x64, 0x9f, 0x95, 0x13, 0x90, 0xe9, 0x2b, 0x25, 0x08, 0x06, 0x1c, 0x1b, 0x9f, 0xed, 0x29, 0x58, 0xfa, 0x24, 0xb3, 0x07, 0x07, 0x0a, 0x23,
+  0xb1, 0xa4, 0xa2, 0x0a, 0xb2, 0x11, 0xbc, 0x0b, 0x10, 0xdb, 0x97, 0xc3, 0x5d, 0x33, 0xd1, 0xf4, 0xd1, 0x88, 0xe4, 0xaa, 0x10, 0xe1, 0xde, 0xc1,
+  0xea, 0xb6, 0xf1, 0x62, 0x1b, 0x3f, 0x34, 0x34, 0x1c, 0x08, 0x08, 0xf3, 0xd9, 0xe9, 0xcf, 0xc0, 0xa2, 0x16, 0xd3, 0xc0, 0xa1, 0xa1, 0x49, 0x7a,
+  0x19, 0x21, 0x19, 0xca, 0xc1, 0xa5, 0x34, 0x4b, 0x51, 0x56, 0x6c, 0x42, 0x05, 0x59, 0x41, 0xee, 0x48, 0x0c, 0xb7, 0xc2, 0x5e, 0xe9, 0x52, 0xc4,
+  0xf6, 0x9a, 0x80, 0x79, 0xd9, 0x49, 0x9e, 0xbe, 0x07, 0xc9, 0x69, 0x07, 0x6f, 0x84, 0xc5, 0x19, 0x58, 0x78, 0xb4, 0x0c, 0x89, 0x90, 0x37, 0xb6,
+  0xdc, 0xd3, 0x17, 0x93, 0xd1, 0x49, 0x2b, 0x6f, 0x00, 0x86, 0x33, 0x49, 0xc3, 0xc0, 0xfa, 0x0d, 0x01, 0x59, 0x7d, 0x18, 0x7d, 0xb1, 0xcb, 0xd3,
+  0x2f, 0xf7, 0x7e, 0x97, 0x58, 0xf5, 0xd4, 0x83, 0x42, 0x93, 0xf1, 0x28, 0x48, 0xd0, 0x36, 0xf0, 0xb3, 0x3b, 0x7f, 0x2a, 0x1c, 0xf0, 0xa2, 0xc4,
+  0x14, 0x7d, 0xc9, 0xfd, 0xb2, 0x8f, 0xc9, 0x1a, 0xa0, 0x53, 0x5b, 0x18, 0x66, 0xed, 0x65, 0xe4, 0xe3, 0xbe, 0x16, 0x6c, 0xe3, 0xa5, 0x06, 0x5f,
+  0x34, 0x4d, 0x43, 0x6d, 0xe6, 0x8b, 0x80, 0x2b, 0x61, 0xfb, 0xe2, 0xa1, 0x3b, 0xf1, 0x75, 0x20, 0x88, 0x98, 0xc1, 0xb0, 0xc0, 0x9a, 0xa5, 0x08,
+  0x59, 0x94, 0x53, 0x85, 0x27, 0xde, 0xd7, 0x73, 0xa9, 0x8d, 0xbd, 0x52, 0x2b, 0x76, 0x70, 0xb0, 0xc5, 0x41, 0x94, 0x3b, 0x20, 0x55, 0x76, 0xa4,
+  0xe2, 0xb2, 0x3c, 0x81, 0x31, 0x44, 0x4d, 0xc1, 0xb4, 0xd3, 0xd7, 0x9e, 0x27, 0xb9, 0x27, 0xf9, 0x3f, 0xb9, 0x53, 0x9a, 0x85, 0x59, 0x29, 0x3c,
+  0x53, 0xf4, 0x30, 0x42, 0xf9, 0xf4, 0xba, 0xfe, 0x1a, 0x2a, 0xf6, 0xa8, 0x1a, 0x32, 0x62, 0x26, 0xfb, 0x25, 0xcb, 0x4d, 0xbb, 0x4c, 0x6f, 0x46,
+  0x32, 0x1b, 0xa3, 0xe9, 0x1b, 0x47, 0x34, 0xe2, 0x63, 0x76, 0x08, 0x03, 0x66, 0xda, 0xca, 0x6f, 0xb1, 0x38, 0x80, 0xfb, 0xa1, 0x4b, 0x76, 0x05,
+  0x24, 0x41, 0x9a, 0xbc, 0x67, 0x01, 0xbd, 0x3e, 0xe8, 0xda, 0x6e, 0xb3, 0x92, 0x96, 0xbf, 0xa5, 0x6b, 0xd8, 0x3a, 0xaa, 0xb8, 0xa7, 0xe1, 0xe0,
+  0xc6, 0xa4, 0xb3, 0x95, 0xda, 0x3a, 0xad, 0x2e, 0xa4, 0x1f, 0x74, 0x6e, 0x50, 0x42, 0xa0, 0xb3, 0x19, 0xe5, 0x6b, 0x3e, 0xc8, 0x66, 0xb6, 0xb6,
+  0xa1, 0x28, 0x40, 0xd9, 0x6c, 0x7b, 0x74, 0x05, 0x9f, 0xdb, 0x68, 0x84, 0xac, 0xa9, 0xee, 0xdf, 0x2e, 0xe4, 0xa7, 0x53, 0xc7, 0x02, 0x63, 0xd4,
+  0x7d, 0xe8, 0xf9, 0x1b, 0x09, 0x40, 0x8b, 0x37, 0x29, 0xb7, 0xc8, 0xf3, 0xf0, 0x33, 0x84, 0x59, 0x19, 0xd8, 0x93, 0x74, 0x8a, 0x34, 0xb7, 0x79,
+  0x83, 0x04, 0xa3, 0xca, 0xd4, 0x5e, 0x85, 0x57, 0x69, 0xbd, 0xf2, 0x74, 0x35, 0xfd, 0xaf, 0x2f, 0x64, 0x83, 0xc3, 0xee, 0x1f, 0xba, 0xfc, 0x9d,
+  0x5b, 0xa3, 0x0e, 0x40, 0x46, 0x61, 0x66, 0x0f, 0x03, 0x13, 0x6b, 0xea, 0x6b, 0xa0, 0xb2, 0xac, 0x5a, 0x94, 0x43, 0x1b, 0x39, 0x4d, 0xbd, 0x66,
+  0xf0, 0xf4, 0x86, 0xf8, 0x38, 0xfe, 0xcd, 0xf5, 0x64, 0x76, 0x36, 0x2a, 0x21, 0xed, 0xc6, 0x11, 0xcf, 0xcc, 0xa2, 0x31, 0x78, 0xa4, 0x8f, 0xb8,
+  0x39, 0xd0, 0xf6, 0x25, 0x5a, 0xaa, 0xa3, 0xd4, 0xd1, 0xcb, 0xd0, 0x69, 0x77, 0xff, 0x4b, 0xc2, 0x8c, 0xa6, 0x20, 0xc7, 0xd5, 0x78, 0x5a, 0xc8,
+  0xd9, 0x3a, 0x44, 0xb4, 0x60, 0xaf, 0x40, 0xfb, 0x6d, 0xad, 0x2f, 0x7b, 0x00, 0xce, 0xb8, 0xcc, 0x47, 0x5b, 0x3e, 0xa7, 0x4d, 0x52, 0x7a, 0x7c,
+  0x6d, 0x9f, 0xa3, 0x15, 0xa8, 0xe5, 0x5c, 0x27, 0xed, 0x4d, 0xda, 0x62, 0x0e, 0x15, 0xd3, 0x90, 0xe7, 0x53, 0xc8, 0xf1, 0x23, 0x87, 0xd4, 0x58,
+  0xa2, 0x95, 0x03, 0xa8, 0x02, 0x35, 0xf3, 0x12, 0xa7, 0x4b, 0x40, 0x9b, 0x19, 0x94, 0x24, 0xda, 0x3b, 0x2f, 0xc6, 0x73, 0x58, 0xc8, 0x27, 0x35,
+  0xe7, 0x67, 0xca, 0x88, 0x2a, 0x9c, 0xe4, 0xb0, 0x9b, 0xfa, 0xc8, 0x17, 0xab, 0xe6, 0xe4, 0x8c, 0xc9, 0xa2, 0xd6, 0x4c, 0x32, 0x7e, 0xb1, 0x36,
+  0x87, 0x14, 0xbd, 0xd6, 0x70, 0xab, 0xe1, 0x1d, 0x8e, 0x1e, 0x43, 0x6b, 0x3b, 0xd3, 0x23, 0x79, 0x7e, 0x8e, 0x0e, 0x7b, 0x77, 0xe7, 0x24, 0xb3,
+  0x7d, 0x3f, 0x7f, 0x2a, 0x8a, 0x99, 0xdc, 0xbc, 0x01, 0x29, 0xd7, 0x52, 0x77, 0xb2, 0x90, 0x7f, 0xaa, 0x4b, 0xd7, 0x77, 0x5f, 0x6d, 0x6b, 0xff,
+  0x32, 0x2e, 0x30, 0x2e, 0x37, 0x36, 0xa2, 0xa5, 0x07, 0x05, 0x9c, 0x0b, 0xae, 0xbc, 0xee, 0xff, 0x54, 0xcf, 0xfb, 0x18, 0x82, 0x7b, 0x7c, 0xc1,
+  0xe5, 0x24, 0x08, 0x36, 0xb7, 0x6a, 0xa0, 0x20, 0x56, 0x18, 0xdc, 0xa8, 0x5d, 0x57, 0x79, 0xc7, 0x86, 0x8d, 0xc5, 0xe9, 0x35, 0x48, 0x6f, 0x57,
+  0x6c, 0x40, 0x8d, 0x0d, 0xd3, 0x4a, 0x4a, 0x5a, 0xd3, 0x7e, 0x67, 0x55, 0x80, 0xfb, 0x45, 0xdf, 0x81, 0x58, 0xf9, 0x34, 0xa7, 0x7e, 0xca, 0x1e,
+  0x54, 0x31, 0x51, 0xb6, 0x4c, 0x20, 0x96, 0xf9, 0xa2, 0x16, 0xc8, 0xff, 0x0a, 0x66, 0xb9, 0x8d, 0xe2, 0x67, 0x8b, 0x92, 0x0c, 0x66, 0x4c, 0x1b,
+  0x01, 0x0b, 0x30, 0xd2, 0xeb, 0x79, 0x9b, 0xc4, 0xa8, 0x0f, 0xc9, 0x80, 0xe8, 0x8b, 0x9c, 0x60, 0x9d, 0x25, 0xa0, 0xac, 0xb2, 0xb0, 0x98, 0xe0,
+  0xae, 0x15, 0x36, 0x0a, 0xaa, 0xa2, 0x75, 0xa0, 0xc3, 0x2c, 0x19, 0xa9, 0x2e, 0xde, 0x09, 0x6b, 0xc6, 0x19, 0xea, 0xee, 0xa7, 0x03, 0x5e, 0xdf,
+  0xd2, 0x23, 0xc9, 0x4f, 0x8f, 0xb5, 0x42, 0xdc, 0x4d, 0x2f, 0x6b, 0x08, 0x51, 0x05, 0x6e, 0x90, 0xa4, 0x94, 0xef, 0xe9, 0x0d, 0x7f, 0x91, 0x85,
+  0x0a, 0xd3, 0x1e, 0xc6, 0xcf, 0x6b, 0x93, 0xb2, 0xeb, 0x67, 0x72, 0x11, 0x03, 0xae, 0x63, 0x98, 0x97, 0xfe, 0xf0, 0xa8, 0xfb, 0x27, 0x79, 0xc5,
+  0x69, 0x8c, 0x1a, 0x15, 0xa4, 0x78, 0x36, 0xe5, 0x26, 0xa0, 0x03, 0x6d, 0x01, 0x02, 0xaf, 0xab, 0x1f, 0xfc, 0xf7, 0xdb, 0x16, 0x37, 0xde, 0x1f,
+  0x21, 0x78, 0x04, 0x46, 0xb8, 0x91, 0x3e, 0x73, 0xbb, 0xbe, 0x2f, 0xec, 0x0c, 0x5d, 0xc6, 0xbf, 0xb6, 0xb1, 0xdb, 0x25, 0xba, 0xc2, 0x15, 0x4b,
+  0xa0, 0x8e, 0xb5, 0x7f, 0x75, 0xab, 0xee, 0xe3, 0x41, 0xe9, 0xf6, 0x0d, 0xb7, 0x08, 0x02, 0x0f, 0x03, 0xe2, 0xa6, 0xaf, 0xd1, 0x9e, 0x14, 0x63,
+  0x4f, 0x4f, 0xba, 0x99, 0x2a, 0xf5, 0xdc, 0xd5, 0x7c, 0x9b, 0x0f, 0x50, 0x5e, 0xf2, 0x93, 0xba, 0x70, 0x78, 0xad, 0x2a, 0x25, 0xf7, 0xcc, 0x1d,
+  0x5c, 0xf4, 0xa5, 0x29, 0xa1, 0xcd, 0x6a, 0x7a, 0x62, 0xc7, 0xc9, 0x73, 0xf1, 0x45, 0xc8, 0xc1, 0x91, 0x55, 0x4a, 0x47, 0x0f, 0x9f, 0xf9, 0xa6,
+  0xb4, 0xcd, 0xd3, 0x99, 0x55, 0xde, 0x9b, 0xb9, 0xfa, 0x03, 0xd4, 0x26, 0x99, 0xd5, 0x4f, 0x95, 0x6d, 0xf9, 0xe3, 0x3f, 0x60, 0x63, 0xaf, 0x60,
+  0x9a, 0xc5, 0xe5, 0x3b, 0xce, 0x73, 0x48, 0xb0, 0x00, 0x52, 0x43, 0x44, 0x6c, 0x28, 0x96, 0xeb, 0xd0, 0xc3, 0xe3, 0xc8, 0x0a, 0x49, 0xd5, 0x24,
+  0xcf, 0xe3, 0xde, 0xfe, 0x92, 0x25, 0x46, 0xf9, 0xd9, 0xcc, 0xce, 0x8c, 0xaf, 0xc6, 0xe9, 0x7f, 0x58, 0x88, 0x15, 0x8a, 0x8d, 0x7c, 0xcc, 0x61,
+  0x33, 0xc9, 0xc0, 0xb8, 0xee, 0xfb, 0x3b, 0x4f, 0x9b, 0x0e, 0xad, 0x65, 0x77, 0xb5, 0x34, 0xed, 0x41, 0x96, 0xc0, 0x02, 0xca, 0x62, 0x75, 0x8a,
+  0x16, 0x89, 0xce, 0x5a, 0xc5, 0x10, 0x3b, 0x65, 0x94, 0x85, 0xe5, 0x42, 0xe2, 0xd5, 0x85, 0x52, 0x7a, 0x81, 0x96, 0x33, 0x30, 0x36, 0x31, 0x17,
+  0x2e, 0xce, 0xb3, 0x4a, 0x5c, 0x93, 0x90, 0x5b, 0x67, 0xc7, 0x84, 0xdb, 0x26, 0x3f, 0x0b, 0xec, 0xff, 0x7e, 0x5f, 0xdd, 0x1b, 0x5f, 0xa1, 0x76,
+  0xc9, 0x14, 0x27, 0x50, 0x98, 0x07, 0x58, 0x47, 0x84, 0x9b, 0x05, 0x18, 0x08, 0x34, 0xfd, 0xde, 0xdd, 0x90, 0x7c, 0x96, 0x91, 0x36, 0x42, 0xec,
+  0xc7, 0x47, 0x6d, 0x18, 0xf2, 0x72, 0xc4, 0x97, 0xd1, 0x9b, 0xf6, 0x21, 0x41, 0xd7, 0x09, 0x56, 0x33, 0xfe, 0x2e, 0x60, 0x15, 0x07, 0x0d, 0x08,
+  0x8e, 0x5e, 0xde, 0xb4, 0x75, 0x7c, 0xf2, 0xd8, 0xe8, 0xe5, 0x10, 0xdc, 0x99, 0xa3, 0x65, 0xec, 0x1e, 0xb4, 0xf5, 0x17, 0x41, 0x51, 0x90, 0x3b,
+  0xa4, 0x16, 0xf4, 0xeb, 0xab, 0x81, 0x64, 0x2e, 0x72, 0xd9, 0x28, 0x5e, 0xf7, 0x3c, 0xfd, 0xb8, 0x38, 0x2c, 0x09, 0xf1, 0x41, 0xf0, 0x5a, 0x0f,
+  0xe7, 0x8d, 0xe7, 0x07, 0xd6, 0xeb, 0x0c, 0x42, 0xc9, 0x83, 0xb5, 0xbd, 0xa5, 0xc2, 0xfc, 0x7b, 0x0e, 0x19, 0x25, 0x51, 0xc1, 0x01, 0xf0, 0x32,
+  0xad, 0xbf, 0x4c, 0x96, 0x97, 0x70, 0xc2, 0xa7, 0x1a, 0x78, 0x52, 0x5f, 0x41, 0x63, 0x1f, 0x5f, 0x7b, 0x61, 0x2b, 0x70, 0x3d, 0xce, 0x24, 0xea,
+  0xad, 0xe4, 0x03, 0x77, 0xb7, 0xe9, 0x31, 0xcc, 0x09, 0x28, 0xed, 0xd5, 0x38, 0x13, 0xef, 0x9e, 0xdd, 0x5f, 0xe3, 0xbf, 0x23, 0xc7, 0x72, 0xf5,
+  0x18, 0xed, 0xed, 0x62, 0xd7, 0x05, 0xa0, 0x13, 0x73, 0xf8, 0x56, 0x52, 0xd2, 0x3b, 0x7a, 0x1d, 0xa0, 0x5d, 0x24, 0x54, 0x38, 0xbc, 0x0e, 0x2e,
+  0xb6, 0x73, 0x8d, 0xe3, 0x25, 0x70, 0xde, 0x26, 0x44, 0x6b, 0x69, 0x3f, 0x27, 0x06, 0x45, 0x92, 0xd6, 0x4b, 0x55, 0xcd, 0x2a, 0x42, 0x7d, 0x1b,
+  0x51, 0x74, 0xe7, 0x7b, 0x1d, 0x27, 0xfa, 0x83, 0x0e, 0xa1, 0xe5, 0xc9, 0xab, 0xec, 0x36, 0x8f, 0x7a, 0xd5, 0x49, 0x1e, 0x41, 0xc1, 0x33, 0xf8,
+  0x5d, 0x6e, 0xfd, 0x42, 0xff, 0x3d, 0xec, 0x3c, 0x18, 0x63, 0x4a, 0x6a, 0xe5, 0x29, 0x0e, 0xd5, 0xb9, 0xfa, 0x4b, 0x24, 0xfa, 0xa3, 0x04, 0x71,
+  0xce, 0x81, 0x57, 0x82, 0x23, 0x71, 0x00, 0xca, 0xd5, 0xf1, 0x86, 0x49, 0x2f, 0x5c, 0x6f, 0x0a, 0xe9, 0x68, 0x37, 0x46, 0x92, 0x2e, 0x23, 0xd7,
+  0x2e, 0x85, 0xc5, 0x3a, 0xb6, 0x2c, 0x32, 0x99, 0x14, 0xd4, 0x16, 0xe3, 0x9b, 0xbb, 0x7e, 0xc2, 0x46, 0x2c, 0x34, 0x23, 0x9c, 0xab, 0xb5, 0xa0,
+  0xcf, 0x31, 0x95, 0x4e, 0x33, 0x02, 0x10, 0xb1, 0xbb, 0x85, 0x68, 0xd7, 0xb8, 0xea, 0x0e, 0x84, 0xcf, 0x58, 0x55, 0x48, 0xd7, 0xa3, 0xdd, 0xf2,
+  0x7e, 0x17, 0x03, 0x68, 0xe9, 0xc3, 0x7a, 0x22, 0xdf, 0xaa, 0x44, 0x3f, 0x2f, 0x90, 0xd4, 0xfc, 0x5d, 0x09, 0x29, 0xb3, 0x5f, 0x93, 0x98, 0xdb,
+  0x01, 0x5b, 0x85, 0xee, 0x72, 0xf7, 0x84, 0x12, 0x1e, 0x5b, 0xb6, 0x3e, 0xd1, 0xd4, 0xdd, 0xe9, 0x52, 0xc7, 0xb6, 0xde, 0x61, 0x93, 0xc0, 0xe5,
+  0x0f, 0x4a, 0xdf, 0x1b, 0xf4, 0xbb, 0x7e, 0x72, 0x83, 0x06, 0x87, 0xcd, 0x89, 0x22, 0x05, 0x3e, 0xf7, 0x16, 0x39, 0x9e, 0x2e, 0x2a, 0x1a, 0x4f,
+  0x40, 0x8e, 0xd1, 0xf4, 0x07, 0x04, 0x18, 0xed, 0xb2, 0xbd, 0x31, 0x42, 0x04, 0xd6, 0x99, 0xa3, 0x93, 0x76, 0x85, 0x3d, 0xb3, 0x71, 0x1a, 0x59,
+  0xde, 0x18, 0xb7, 0x2d, 0x0b, 0x45, 0x1f, 0x77, 0x7e, 0x95, 0x80, 0xc2, 0x47, 0x1c, 0x1f, 0x1f, 0x67, 0xe2, 0x23, 0x8a, 0x97, 0x3a, 0xdc, 0x3a,
+  0x25, 0xab, 0x92, 0x76, 0xbf, 0x65, 0x2a, 0xf2, 0xd3, 0x04, 0xf0, 0xa2, 0x63, 0xb1, 0x6b, 0x98, 0xd6, 0x9a, 0x86, 0x09, 0x65, 0xf8, 0xf0, 0x0d,
+  0xc6, 0x5c, 0x56, 0x66, 0x3d, 0xd6, 0x55, 0xb7, 0x6f, 0xd7, 0xfb, 0x90, 0xcd, 0xfc, 0xe9, 0x52, 0xd0, 0x66, 0xd8, 0x8f, 0x0d, 0x53, 0x84, 0x25,
+  0xf5, 0xae, 0xef, 0x5a, 0x3f, 0xde, 0x6c, 0xa9, 0xa1, 0x02, 0x5d, 0x1b, 0x87, 0x2f, 0x11, 0x53, 0x6e, 0x33, 0x81, 0xab, 0x05, 0x39, 0x23, 0x6b,
+  0xf8, 0x65, 0xc6, 0xff, 0xef, 0x74, 0xa2, 0x0b, 0xcf, 0xfa, 0xe2, 0xf9, 0xe2, 0x0a, 0x08, 0xdd, 0xa4, 0x9e, 0x44, 0xea, 0xad, 0x9f, 0x45, 0xa0,
+  0x8a, 0xce, 0xec, 0x09, 0x9f, 0x19, 0x40, 0x1f, 0x85, 0x03, 0x6f, 0x3c, 0xf3, 0x0a, 0x49, 0x1c, 0x4e, 0x58, 0xa5, 0x2a, 0x1e, 0x0f, 0x98, 0xf5,
+  0xf4, 0xeb, 0x83, 0xe6, 0x44, 0x15, 0x77, 0x97, 0x88, 0xee, 0x25, 0x70, 0x1f, 0x82, 0x21, 0xe2, 0x4b, 0xea, 0x68, 0x93, 0x49, 0x46, 0x3e, 0xbc,
+  0x16, 0xbd, 0x8b, 0x49, 0xd6, 0x74, 0x9c, 0xb1, 0x91, 0x38, 0xa6, 0x62, 0x33, 0x8c, 0xb5, 0x5d, 0x75, 0xe4, 0x8c, 0x4d, 0x9c, 0x7a, 0x78, 0xd1,
+  0x4f, 0x07, 0x3e, 0x55, 0x38, 0x30, 0x83, 0x8b, 0x62, 0xf8, 0x95, 0x65, 0x03, 0xec, 0x5a, 0x29,
+};
+
+const uint8_t target_image[4160] = {
+  0x52, 0xf2, 0x26, 0x65, 0xa6, 0x0c, 0x12, 0xd2, 0x89, 0x18, 0x5d, 0x95, 0x0e, 0xe8, 0x81, 0x36, 0x09, 0x16, 0x6f, 0x6b, 0x11, 0x3d, 0x17, 0x8d,
+  0x6c, 0x0f, 0xd3, 0x90, 0x1f, 0xf2, 0x39, 0xa1, 0xa0, 0x95, 0xf2, 0x0f, 0x93, 0x95, 0x65, 0x0c, 0xf9, 0x38, 0x0b, 0x8e, 0xdb, 0x22, 0x4a, 0x6b,
+  0x24, 0x8a, 0x1e, 0x92, 0x4e, 0x8f, 0xd0, 0xae, 0x2e, 0x1a, 0x94, 0x92, 0xa3, 0x30, 0x5f, 0x18, 0x8c, 0xb6, 0x10, 0x90, 0x0f, 0x9e, 0x34, 0x7f,
+  0xae, 0x88, 0x6d, 0xc6, 0x50, 0x77, 0x95, 0xec, 0x74, 0x5c, 0x4c, 0x3f, 0xcb, 0x2e, 0xb2, 0xc7, 0x3e, 0x14, 0x93, 0x4c, 0x86, 0x7e, 0xe0, 0x57,
+  0xba, 0x72, 0x49, 0x9b, 0xfa, 0x12, 0x1e, 0x83, 0x6b, 0x2a, 0xc1, 0x57, 0x26, 0xee, 0x7d, 0x6b, 0x0a, 0xf6, 0xab, 0x13, 0xc3, 0x8e, 0x92, 0xca,
+  0xe0, 0xd1, 0x50, 0x57, 0xb1, 0x59, 0x98, 0x7f, 0x94, 0xcc, 0x74, 0x11, 0xd7, 0x17, 0xf1, 0x45, 0x79, 0xb2, 0xaa, 0x10, 0x0f, 0xbb, 0xb3, 0x4f,
+  0xa5, 0x93, 0xfe, 0xae, 0xd2, 0x72, 0x48, 0xb7, 0x62, 0xe3, 0xab, 0x58, 0x05, 0xf0, 0x76, 0x5a, 0x2b, 0x9c, 0x1d, 0x7e, 0x0f, 0x37, 0xc4, 0x49,
+  0x21, 0xbd, 0x3f, 0x65, 0x64, 0xea, 0xdf, 0x7f, 0x14, 0x2a, 0x72, 0x66, 0x8c, 0x47, 0xe2, 0x23, 0xd1, 0x6e, 0xdd, 0x8c, 0x47, 0xb4, 0x6a, 0xfc,
+  0x5b, 0xae, 0xe2, 0x61, 0xf5, 0x3b, 0x26, 0x15, 0x2d, 0x26, 0x3b, 0xa8, 0x3b, 0x03, 0x7c, 0xd4, 0x96, 0x2e, 0x43, 0x48, 0x01, 0x25, 0x6b, 0x88,
+  0x5e, 0x9c, 0x90, 0x51, 0xf3, 0x20, 0xb0, 0xdb, 0x83, 0xf3, 0x9e, 0xa7, 0xad, 0xbd, 0x0d, 0x74, 0xe6, 0xde, 0xc7, 0xf3, 0xdf, 0xae, 0xcc, 0x8f,
+  0x64, 0x65, 0x66, 0x64, 0x1a, 0x7b, 0xa2, 0x66, 0x0f, 0x30, 0x11, 0xfc, 0x35, 0x70, 0x29, 0x1c, 0x57, 0x99, 0x0d, 0x1a, 0x00, 0x91, 0x26, 0x89,
+  0x19, 0xf2, 0x5d, 0x9d, 0x06, 0x12, 0xdf, 0x35, 0x9d, 0x60, 0x26, 0xa2, 0x40, 0xf4, 0x58, 0x9a, 0x5d, 0x79, 0x1f, 0x1d, 0xd9, 0x7c, 0xfe, 0xfa,
+  0x77, 0x7a, 0x7b, 0x4f, 0x15, 0x24, 0x1a, 0xbf, 0x57, 0xbd, 0x43, 0x7a, 0xd4, 0xb1, 0x29, 0x84, 0x05, 0x34, 0xf3, 0xf3, 0x87, 0x5c, 0x25, 0xb0,
+  0x8b, 0xea, 0x06, 0xc2, 0x87, 0x4c, 0xfa, 0xa4, 0xdd, 0x17, 0xb2, 0xd8, 0x42, 0x84, 0x5d, 0xe8, 0x2a, 0x5b, 0xc5, 0x39, 0x88, 0x8a, 0xc7, 0x80,
+  0x54, 0xa2, 0x39, 0x9c, 0xcf, 0xc9, 0xfc, 0xc2, 0xda, 0x31, 0xce, 0x3d, 0xd1, 0x66, 0xbd, 0xcd, 0x3a, 0x33, 0x84, 0x7e, 0x5b, 0xbb, 0x07, 0xfd,
+  0x07, 0xca, 0x47, 0x78, 0x42, 0x31, 0xb1, 0x9a, 0xf4, 0x58, 0x72, 0xce, 0xef, 0xb9, 0xfc, 0x59, 0xf4, 0xf9, 0x5d, 0x14, 0x38, 0x1a, 0x3a, 0x78,
+  0x32, 0x56, 0x34, 0x7b, 0x9f, 0xfc, 0xe6, 0x9c, 0xd7, 0x00, 0x7a, 0xe8, 0xa7, 0x58, 0xcc, 0xa4, 0x15, 0xd5, 0xa9, 0x1e, 0xe8, 0x63, 0xc8, 0xb6,
+  0xc0, 0x33, 0x7a, 0xe3, 0x2d, 0x6f, 0xca, 0xa2, 0x55, 0x16, 0xcd, 0xf2, 0xf8, 0xb8, 0x65, 0x76, 0x66, 0xbe, 0xf2, 0x15, 0xb9, 0x28, 0x2b, 0xfe,
+  0x20, 0x07, 0x26, 0x97, 0xe7, 0x77, 0xce, 0xa7, 0x25, 0x9c, 0xd3, 0x98, 0xfa, 0x79, 0xa8, 0xef, 0x59, 0x27, 0x8c, 0x8c, 0x21, 0x05, 0x03, 0xcc,
+  0xf8, 0xb9, 0xa6, 0x1a, 0x86, 0xbf, 0xef, 0x23, 0x6f, 0xfc, 0xdf, 0x31, 0xd3, 0xdf, 0x36, 0x07, 0x40, 0x36, 0x4a, 0x80, 0x3d, 0xc3, 0x96, 0x53,
+  0x42, 0x8b, 0x6b, 0xd5, 0x21, 0x0f, 0xe8, 0xbd, 0x5a, 0xe5, 0x75, 0xa9, 0x95, 0xd0, 0xe7, 0x84, 0x6b, 0xd3, 0xea, 0xe0, 0x80, 0x21, 0x88, 0x26,
+  0x86, 0x82, 0x04, 0xdf, 0x70, 0xc6, 0x2e, 0x9b, 0x01, 0xc6, 0xcc, 0x26, 0x2c, 0x24, 0x79, 0x9e, 0xb9, 0x1e, 0x8e, 0x0f, 0x53, 0xae, 0x84, 0x87,
+  0x8e, 0x7b, 0xc8, 0xc6, 0x1b, 0xe2, 0x8f, 0x0e, 0x3f, 0x30, 0x46, 0x0a, 0xc5, 0x19, 0x81, 0x73, 0x8f, 0x07, 0xc2, 0xe4, 0xe9, 0x10, 0x71, 0x53,
+  0x9c, 0xf9, 0x81, 0x9b, 0x83, 0x33, 0xb1, 0x46, 0x73, 0x82, 0x88, 0xce, 0x7a, 0x81, 0xf1, 0x3f, 0xb2, 0x85, 0xe0, 0xe0, 0xf1, 0xed, 0x42, 0xec,
+  0x8f, 0xe4, 0xf1, 0x33, 0xd7, 0x72, 0x23, 0x6a, 0x1f, 0x64, 0x71, 0x50, 0x12, 0xab, 0x3d, 0x6d, 0x12, 0x36, 0xab, 0x4d, 0xc8, 0x1f, 0xe5, 0xc6,
+  0x27, 0xf0, 0xb7, 0xa4, 0xa9, 0x5d, 0x24, 0x40, 0xe2, 0x23, 0xf7, 0x77, 0x38, 0xbf, 0xf3, 0x18, 0x65, 0xe2, 0x7c, 0x29, 0xfd, 0xaa, 0xd5, 0x39,
+  0x29, 0xb4, 0x6e, 0xfe, 0x83, 0x67, 0x56, 0x6b, 0x32, 0x5b, 0x51, 0x17, 0xb8, 0x5d, 0x04, 0x56, 0x8d, 0x75, 0x70, 0xb4, 0x04, 0x62, 0x54, 0x84,
+  0x9f, 0x4b, 0x83, 0xf5, 0x10, 0x1c, 0xfc, 0xeb, 0xc9, 0x3a, 0xf8, 0xe0, 0x1a, 0x15, 0x43, 0x45, 0x0a, 0xe7, 0xc7, 0x2e, 0x45, 0xc1, 0x21, 0xd1,
+  0x6c, 0xd9, 0xe9, 0xad, 0xd1, 0xf2, 0x42, 0x67, 0x26, 0x89, 0xeb, 0x83, 0x92, 0x7e, 0xb3, 0x53, 0x16, 0x47, 0x0e, 0xcc, 0xb0, 0x2e, 0x6c, 0xe5,
+  0x12, 0x44, 0xf0, 0x04, 0xa2, 0x16, 0xcd, 0x42, 0x15, 0x9b, 0xdb, 0x38, 0x11, 0x43, 0xdc, 0x1f, 0x74, 0x02, 0x56, 0xfe, 0x8d, 0x6a, 0xed, 0xea,
+  0x44, 0x9f, 0x21, 0x0b, 0x86, 0xb5, 0x3d, 0xf0, 0x1c, 0xf8, 0x29, 0x43, 0x0c, 0x2e, 0x33, 0xee, 0x4f, 0xa0, 0x4e, 0x87, 0xc2, 0x34, 0x4a, 0x72,
+  0x80, 0xac, 0x2d, 0x45, 0x58, 0xcd, 0x04, 0xfe, 0x40, 0x09, 0x03, 0x04, 0xbb, 0x81, 0x8d, 0xfa, 0x30, 0x83, 0x79, 0x3e, 0xef, 0x72, 0x1b, 0xa8,
+  0xd1, 0xa6, 0x6e, 0xa8, 0x7e, 0x8b, 0xd5, 0xe3, 0x64, 0xf8, 0x81, 0x4e, 0xb0, 0x37, 0xfb, 0x3a, 0x57, 0x32, 0xd5, 0xe1, 0xb4, 0xba, 0xa2, 0x23,
+  0x67, 0xfd, 0x58, 0xfb, 0x0d, 0xd6, 0x21, 0x03, 0x12, 0xa0, 0xbd, 0xe1, 0x41, 0x6e, 0x29, 0x0e, 0x15, 0xaa, 0xd7, 0x61, 0xde, 0x81, 0xab, 0xf8,
+  0x48, 0x99, 0x3e, 0xb1, 0x4b, 0x0b, 0x75, 0x2f, 0x28, 0x44, 0x72, 0x00, 0x43, 0x5d, 0xf6, 0x54, 0xf8, 0xfc, 0x8c, 0x52, 0x3e, 0x08, 0xf7, 0xe1,
+  0x4f, 0x37, 0x5b, 0x2e, 0x00, 0x55, 0x61, 0x15, 0x79, 0x47, 0x80, 0xa7, 0x33, 0x3f, 0x81, 0xc6, 0x01, 0x17, 0x43, 0xd1, 0x16, 0x24, 0x66, 0x96,
+  0x0a, 0x64, 0x05, 0x4c, 0x4d, 0xa1, 0x3b, 0x15, 0x95, 0xf5, 0x87, 0xda, 0xc0, 0x27, 0xa8, 0xe4, 0xb7, 0xc8, 0xe1, 0x98, 0x63, 0xc3, 0x53, 0xb8,
+  0xfc, 0x7e, 0x26, 0x48, 0xb9, 0x9e, 0xa4, 0x25, 0x0b, 0xd3, 0xd5, 0xb7, 0xe4, 0x83, 0xa0, 0x6d, 0xbb, 0xb3, 0xcf, 0x81, 0x23, 0xe8, 0x86, 0xc0,
+  0x81, 0x91, 0xd5, 0xd0, 0xcd, 0x04, 0xd3, 0xaf, 0x95, 0xcc, 0xe4, 0xb6, 0xae, 0xf4, 0xb1, 0xa4, 0x3a, 0x15, 0x07, 0x0a, 0x22, 0xa3, 0x5c, 0xf5,
+  0x1a, 0x60, 0xd5, 0x73, 0x8e, 0x0c, 0xa0, 0x04, 0xa0, 0x88, 0xae, 0x3e, 0x7d, 0x43, 0x00, 0x74, 0xcc, 0x11, 0xbf, 0xee, 0x80, 0xe5, 0x89, 0x17,
+  0xa8, 0x86, 0x10, 0xbe, 0xbc, 0x79, 0x40, 0xcf, 0x13, 0xd8, 0x43, 0x3c, 0xba, 0xc1, 0x34, 0x3b, 0xbd, 0xa6, 0xf9, 0x75, 0x7e, 0xd8, 0x61, 0x13,
+  0x7a, 0xe9, 0xaf, 0x49, 0xc4, 0x0b, 0x9d, 0xa1, 0xa4, 0x32, 0x13, 0x99, 0x25, 0x54, 0x41, 0xa6, 0xbe, 0xb1, 0x4d, 0x9f, 0x91, 0x22, 0x03, 0x7b,
+  0x0f, 0x7c, 0x44, 0xf8, 0xac, 0x19, 0xb1, 0x37, 0xac, 0x7d, 0x4a, 0xb5, 0x84, 0x49, 0x76, 0x77, 0xdc, 0xf3, 0x3d, 0x52, 0x8e, 0x53, 0x7d, 0x45,
+  0x48, 0xe0, 0xfc, 0x37, 0x4b, 0x0e, 0xc5, 0x05, 0x28, 0x8d, 0x11, 0x9b, 0xdf, 0x59, 0x70, 0xa8, 0x0f, 0x84, 0x63, 0xd5, 0x70, 0x5a, 0xbc, 0xc3,
+  0x1b, 0x85, 0x39, 0xfd, 0xf5, 0xad, 0xbd, 0xef, 0x27, 0x6a, 0x56, 0xab, 0x5a, 0x23, 0xac, 0x33, 0x9d, 0x9c, 0xd9, 0x46, 0xd2, 0xd6, 0x84, 0x18,
+  0xbd, 0xdb, 0xbe, 0xec, 0xc2, 0xfe, 0x79, 0x44, 0x77, 0xc4, 0x1e, 0xfe, 0xe4, 0x8c, 0x33, 0x4f, 0xfa, 0x15, 0xef, 0x79, 0x04, 0x4a, 0x75, 0x13,
+  0x11, 0x82, 0xf7, 0xfe, 0x73, 0xfe, 0x44, 0x63, 0x35, 0xea, 0xf2, 0xee, 0x35, 0x13, 0x94, 0x17, 0x24, 0xbf, 0x86, 0x43, 0xf3, 0x5c, 0x21, 0x9a,
+  0xd1, 0xa1, 0x82, 0x47, 0xe3, 0x1c, 0xb4, 0x5d, 0x3b, 0x7f, 0xe5, 0xe0, 0x7c, 0x64, 0x06, 0x28, 0x00, 0xf3, 0x7d, 0xae, 0x73, 0x67, 0x4d, 0xba,
+  0x24, 0x6a, 0x58, 0x60, 0x50, 0x1e, 0xd7, 0x54, 0x00, 0x53, 0xc0, 0x56, 0xd6, 0x65, 0x1e, 0xf0, 0xed, 0x32, 0xb6, 0x03, 0xe6, 0xbd, 0x4a, 0x40,
+  0x5f, 0x10, 0x64, 0x63, 0xff, 0xde, 0x96, 0x13, 0x5c, 0xec, 0x6d, 0xc1, 0x46, 0xda, 0x0c, 0x47, 0x1a, 0x0d, 0xd5, 0xa9, 0x49, 0xa2, 0xef, 0x26,
+  0x3f, 0xf8, 0x44, 0x6f, 0x82, 0x50, 0x30, 0xc5, 0x5f, 0xc8, 0xf4, 0x6d, 0xe2, 0x07, 0xcf, 0xc2, 0xa1, 0x66, 0xe9, 0xe0, 0xf0, 0x8d, 0x8c, 0x34,
+  0xb8, 0x14, 0x0c, 0xee, 0xbb, 0x69, 0x73, 0x9d, 0xc0, 0x23, 0xa4, 0xde, 0x49, 0x7c, 0x0c, 0xe9, 0xed, 0x8c, 0x20, 0x2b, 0x78, 0x6a, 0x57, 0x48,
+  0x4c, 0x41, 0xbd, 0xbd, 0xf9, 0xa7, 0x42, 0x67, 0xa7, 0x3d, 0x4d, 0x7b, 0x8e, 0xab, 0x64, 0x1e, 0x2a, 0xa4, 0x29, 0x13, 0x35, 0x80, 0xe7, 0xcf,
+  0x7f, 0x8c, 0x38, 0x73, 0xe8, 0x55, 0xff, 0xc2, 0x73, 0x6d, 0x23, 0x8c, 0x31, 0x3e, 0x17, 0x2c, 0x57, 0x8e, 0x17, 0x51, 0x3d, 0x5e, 0x42, 0xcf,
+  0x91, 0x33, 0xe3, 0x05, 0xbf, 0xde, 0x69, 0x62, 0x69, 0xbe, 0x86, 0x35, 0x60, 0x45, 0x56, 0xc0, 0x0f, 0x7f, 0x47, 0x93, 0xf7, 0x5c, 0x20, 0xaf,
+  0x80, 0x87, 0xa1, 0xca, 0xdc, 0xd9, 0x37, 0x17, 0x45, 0xe5, 0x3f, 0x62, 0x66, 0xa5, 0x72, 0x6e, 0xf4, 0x4f, 0xd9, 0xd0, 0xdf, 0xf7, 0x05, 0x20,
+  0x08, 0x6c, 0xb5, 0xc3, 0xe5, 0xcd, 0x79, 0xf7, 0x96, 0x7d, 0x00, 0x12, 0x64, 0xee, 0xed, 0xed, 0x13, 0x88, 0xda, 0x77, 0xf8, 0x72, 0x3f, 0xc8,
+  0x1b, 0x39, 0x27, 0x26, 0x85, 0xf8, 0xae, 0x1b, 0xf1, 0xd3, 0xb8, 0xb3, 0xa5, 0xd8, 0xc3, 0xe5, 0x75, 0x15, 0x8d, 0xc6, 0x0a, 0x00, 0xc8, 0x20,
+  0x3b, 0x91, 0xeb, 0x09, 0xa5, 0xb7, 0x4d, 0xf6, 0x20, 0xa0, 0x40, 0x87, 0xa2, 0x6f, 0xb2, 0xc3, 0x1c, 0x19, 0x12, 0x4c, 0x86, 0xf1, 0x95, 0x31,
+  0x63, 0x42, 0x39, 0xca, 0x99, 0x00, 0x02, 0x89, 0x4d, 0xff, 0x75, 0x47, 0xf5, 0x50, 0xa5, 0xd6, 0xe2, 0x3e, 0x79, 0x86, 0x3c, 0x8c, 0x3f, 0x07,
+  0xf5, 0x69, 0xb4, 0xa6, 0x4e, 0x0e, 0x05, 0x31, 0x7f, 0xe2, 0xac, 0xa5, 0x6b, 0x14, 0x41, 0x3a, 0xaa, 0x6c, 0xec, 0x5e, 0x3a, 0x7e, 0x08, 0xb2,
+  0x56, 0xb7, 0x6b, 0x5c, 0xae, 0x65, 0x32, 0x01, 0xcc, 0x4a, 0xbd, 0xd8, 0x81, 0x11, 0x34, 0x7e, 0xf8, 0x33, 0x4f, 0xc4, 0xd1, 0x31, 0x3b, 0x77,
+  0x38, 0x43, 0xc2, 0xe3, 0x4b, 0x1b, 0xf3, 0x9f, 0x7e, 0x9c, 0x2f, 0xe5, 0x39, 0x7c, 0x6a, 0xe9, 0xaa, 0x0e, 0xf2, 0x98, 0x25, 0xec, 0x64, 0x0d,
+  0x36, 0x06, 0xf9, 0x98, 0x24, 0x6a, 0x0d, 0xb5, 0x0f, 0x2f, 0x64, 0x73, 0xe5, 0xb6, 0xe2, 0x50, 0xbb, 0x1c, 0xff, 0x14, 0xee, 0x2a, 0x54, 0x30,
+  0x2f, 0xa7, 0xef, 0x86, 0xbf, 0x77, 0x08, 0x4f, 0xaa, 0xb9, 0x60, 0xd6, 0x5f, 0xfc, 0x54, 0x71, 0x2b, 0x1b, 0x00, 0x14, 0x47, 0x14, 0x59, 0x6b,
+  0xf4, 0xe2, 0x1f, 0x8f, 0xf6, 0xc2, 0x35, 0x61, 0x5b, 0xc4, 0xd2, 0x4f, 0xd2, 0xcd, 0x6e, 0x16, 0x0c, 0xb4, 0x79, 0x32, 0x5f, 0x8a, 0xeb, 0x72,
+  0x31, 0x52, 0x5d, 0xbc, 0xe5, 0x79, 0x07, 0xa1, 0x69, 0x3f, 0xcf, 0xa0, 0xc4, 0x67, 0x0a, 0x60, 0x08, 0x76, 0x10, 0xcd, 0xeb, 0x0f, 0x41, 0x31,
+  0xbf, 0x10, 0xe6, 0x9b, 0x56, 0x5c, 0x45, 0x55, 0x35, 0xf5, 0x9d, 0x0b, 0x43, 0xbf, 0xb7, 0xb0, 0x51, 0xec, 0x46, 0x4c, 0x00, 0xb8, 0xc1, 0x98,
+  0xea, 0xce, 0xa2, 0xf2, 0xf1, 0x10, 0x06, 0xd3, 0x3b, 0x1b, 0x79, 0xb7, 0xf4, 0x77, 0xf4, 0xc6, 0x62, 0xca, 0x40, 0xe9, 0x6e, 0xd0, 0x7e, 0x21,
+  0xed, 0x7f, 0x2e, 0x02, 0xcd, 0xee, 0xbd, 0x4d, 0xd2, 0xb1, 0xc5, 0x26, 0x9b, 0x3c, 0x53, 0xdc, 0x51, 0x75, 0x5c, 0xc8, 0xc8, 0x98, 0x14, 0x83,
+  0x32, 0x64, 0xc0, 0x28, 0x3f, 0x68, 0x10, 0xa6, 0x08, 0x7b, 0x8d, 0x8b, 0x53, 0x29, 0xfa, 0x6d, 0xe2, 0x1a, 0xfc, 0x12, 0x43, 0x9f, 0x15, 0x35,
+  0x18, 0x6b, 0x7f, 0xfd, 0xb5, 0xf8, 0x72, 0x2c, 0x3b, 0x22, 0x6a, 0x75, 0x9e, 0xe4, 0xac, 0x3c, 0xbf, 0x89, 0xd8, 0xc6, 0xaa, 0xc2, 0x1f, 0xc7,
+  0xd7, 0x4b, 0x4b, 0x47, 0x91, 0x44, 0x5f, 0x41, 0xbc, 0x42, 0x32, 0x70, 0x3f, 0x2f, 0x3e, 0x3c, 0x27, 0x48, 0xe2, 0xe8, 0x94, 0x30, 0x53, 0x10,
+  0x65, 0x40, 0xfe, 0x3e, 0x81, 0x86, 0x3b, 0xa6, 0xce, 0x19, 0xa7, 0x76, 0xfd, 0x09, 0x1a, 0x01, 0x79, 0xe2, 0xd1, 0x3b, 0xd7, 0x72, 0xea, 0x5f,
+  0x0a, 0xe0, 0x4b, 0x3b, 0x1e, 0x0c, 0x30, 0x99, 0xf9, 0xd3, 0x95, 0x31, 0xee, 0x13, 0x5f, 0x83, 0xdd, 0x2d, 0x72, 0x9a, 0x42, 0xc6, 0xc7, 0xaa,
+  0xf2, 0x01, 0x1b, 0xa3, 0x98, 0xb5, 0x9e, 0x59, 0x37, 0x09, 0x5e, 0x57, 0x24, 0x0b, 0x34, 0xff, 0x41, 0x09, 0x99, 0xbb, 0xa6, 0xe9, 0x34, 0xd0,
+  0x02, 0xd1, 0x53, 0x68, 0xad, 0x5f, 0x2f, 0x9e, 0x4f, 0x13, 0x34, 0x08, 0xcb, 0x7e, 0x8c, 0x7b, 0x10, 0x68, 0x19, 0xcb, 0x65, 0xa9, 0x8c, 0x27,
+  0xa3, 0x88, 0x17, 0xa7, 0x29, 0x65, 0xb2, 0x45, 0x68, 0xfc, 0x48, 0xaa, 0x4e, 0x6a, 0xf4, 0x0d, 0x4f, 0xbe, 0x91, 0xe2, 0x5b, 0x6a, 0x6a, 0x04,
+  0x1d, 0xc5, 0xff, 0xcd, 0x5d, 0xa4, 0x32, 0x64, 0xba, 0x67, 0x34, 0xf1, 0x01, 0x6f, 0xe6, 0x28, 0x6c, 0x1d, 0xd2, 0x17, 0x67, 0x93, 0xe2, 0x5d,
+  0x75, 0xc5, 0x29, 0x21, 0x03, 0x0d, 0x8d, 0x24, 0xa4, 0xce, 0xe8, 0x65, 0x16, 0x92, 0x9f, 0xed, 0x5e, 0xbc, 0x81, 0x2b, 0x25, 0x59, 0x48, 0x29,
+  0x85, 0x2b, 0xec, 0x11, 0x1b, 0x62, 0x7d, 0xc0, 0xce, 0xca, 0xf7, 0xce, 0x32, 0x4d, 0x20, 0xd6, 0xf1, 0x0b, 0xf9, 0xe9, 0x7b, 0x50, 0x0d, 0x9b,
+  0xed, 0xa2, 0x63, 0x16, 0xe7, 0xb6, 0x9e, 0xb0, 0xd3, 0xe4, 0x29, 0xa3, 0xc9, 0xdb, 0x38, 0x9e, 0x67, 0x9d, 0xd8, 0x32, 0xd4, 0x79, 0x2e, 0x90,
+  0x37, 0x0a, 0x66, 0xf0, 0x84, 0x28, 0x62, 0x5b, 0x1f, 0x26, 0x3f, 0xf8, 0xb9, 0xd0, 0xe5, 0x31, 0x0a, 0xe2, 0x8f, 0xd7, 0xc1, 0xac, 0x09, 0xaa,
+  0xd6, 0x52, 0x1e, 0x63, 0x99, 0x74, 0x8c, 0xd9, 0xa0, 0xc7, 0x4e, 0xa6, 0x6b, 0x4e, 0x95, 0x3f, 0x6c, 0x63, 0xa8, 0x5e, 0x72, 0x80, 0x70, 0x2d,
+  0x05, 0x00, 0x9e, 0xfc, 0x7d, 0x77, 0x3c, 0x72, 0xc3, 0x9e, 0xc7, 0xd1, 0x75, 0xd6, 0x2d, 0xcf, 0x79, 0x66, 0x1b, 0x11, 0x20, 0x5b, 0x6e, 0x5d,
+  0x17, 0xcd, 0x71, 0x81, 0x82, 0xa8, 0x0a, 0x0a, 0xa2, 0x21, 0x15, 0xec, 0xbb, 0x50, 0xc7, 0xb8, 0x82, 0x14, 0x0d, 0xc0, 0x81, 0xe5, 0x60, 0xa7,
+  0xf3, 0xc8, 0x22, 0x06, 0xdb, 0x10, 0xff, 0x9d, 0xbb, 0xb1, 0xd0, 0x1c, 0x31, 0x21, 0xfb, 0xe2, 0x7d, 0x49, 0xf4, 0xcf, 0xea, 0xcb, 0x2a, 0xaf,
+  0xc9, 0xb8, 0xee, 0x38, 0x10, 0xd5, 0x59, 0x9c, 0xc1, 0x40, 0x28, 0x52, 0xe5, 0x9d, 0x46, 0xe7, 0xd0, 0x74, 0x24, 0x41, 0x80, 0xf6, 0xeb, 0x7a,
+  0x35, 0x97, 0x43, 0x9d, 0x81, 0x3c, 0x51, 0x5f, 0x09, 0x32, 0x2e, 0x67, 0x29, 0xa2, 0xef, 0x47, 0xed, 0x53, 0xe5, 0x60, 0x2b, 0xca, 0xc8, 0x43,
+  0x1d, 0xc4, 0x87, 0x0c, 0xa2, 0xdb, 0x5c, 0xf7, 0xdf, 0x73, 0x8e, 0x85, 0x94, 0xb0, 0xe1, 0xe5, 0x1a, 0x40, 0xfe, 0x89, 0xa1, 0xdb, 0x64, 0xbc,
+  0xcc, 0x5f, 0x43, 0x60, 0xfd, 0x5e, 0x93, 0x25, 0x5c, 0x54, 0xc3, 0x14, 0x71, 0x3a, 0x2d, 0x9d, 0xbe, 0xf5, 0x0c, 0x4b, 0xd1, 0x84, 0x40, 0x4f,
+  0xa3, 0xf7, 0xfb, 0xde, 0x95, 0xed, 0xa9, 0xe5, 0x50, 0xbb, 0x00, 0xbf, 0x08, 0x38, 0x26, 0x4a, 0x9d, 0xa0, 0x6e, 0x6a, 0x83, 0x5d, 0xe5, 0x0c,
+  0x21, 0x7d, 0x3a, 0x9c, 0xa7, 0x0b, 0x05, 0x0d, 0x00, 0x91, 0x5a, 0x4d, 0x1b, 0x85, 0x5b, 0x88, 0x39, 0x69, 0x95, 0x4d, 0x96, 0x22, 0x34, 0x5d,
+  0x9f, 0xd4, 0x79, 0x28, 0x22, 0x03, 0xef, 0xcd, 0x3e, 0xb5, 0x26, 0x73, 0x18, 0x10, 0xa3, 0x25, 0xdf, 0xaa, 0xc8, 0x45, 0x66, 0xcf, 0x43, 0xf7,
+  0x02, 0x0e, 0xa5, 0xd2, 0x8f, 0xe4, 0x59, 0x98, 0xa5, 0x94, 0x71, 0x9a, 0xef, 0x84, 0xbb, 0x7e, 0x3f, 0x2a, 0xe7, 0x00, 0x0b, 0x0f, 0x88, 0x06,
+  0x67, 0x2f, 0x3c, 0x28, 0x0e, 0xe9, 0xc7, 0x1a, 0x03, 0x9c, 0x8d, 0xa8, 0xf0, 0x32, 0x24, 0x69, 0x33, 0x84, 0x9b, 0xa4, 0x81, 0xa5, 0xa4, 0x6a,
+  0xd0, 0x9c, 0x2c, 0x82, 0x4f, 0x10, 0x4c, 0xa0, 0x0c, 0xfe, 0xe3, 0xb9, 0xc8, 0x7a, 0xb7, 0x89, 0x01, 0x60, 0xd8, 0x6f, 0xbe, 0xe9, 0x77, 0x14,
+  0xbd, 0xa7, 0x73, 0x2c, 0x39, 0xff, 0x1a, 0x42, 0x3b, 0xa4, 0x09, 0x1f, 0x55, 0xe4, 0xbf, 0xec, 0xb1, 0xf1, 0xd8, 0x43, 0xb6, 0x0d, 0x44, 0xa2,
+  0x8d, 0xad, 0x6f, 0xaf, 0xc9, 0xea, 0x85, 0xf8, 0x43, 0x4b, 0xa4, 0xed, 0xf7, 0xe4, 0x37, 0x15, 0xe1, 0x81, 0x03, 0x2b, 0x42, 0xe7, 0x3c, 0xd7,
+  0xbe, 0x33, 0xf1, 0x28, 0xbf, 0xea, 0x53, 0x31, 0x21, 0x64, 0x54, 0x99, 0x3d, 0x61, 0xe8, 0xda, 0xa1, 0xeb, 0xb1, 0xfb, 0xaa, 0xd7, 0xfa, 0x89,
+  0x78, 0x78, 0xd6, 0x87, 0xb2, 0x01, 0xdb, 0x06, 0x6f, 0xf4, 0xb9, 0x3b, 0x92, 0xe2, 0x4e, 0xca, 0x36, 0x64, 0x9f, 0x95, 0x13, 0x90, 0xe9, 0x2b,
+  0x25, 0x08, 0x06, 0x1c, 0x1b, 0x9f, 0xed, 0x29, 0x58, 0xfa, 0x24, 0xb3, 0x07, 0x07, 0x0a, 0x23, 0xb1, 0xa4, 0xa2, 0x0a, 0xb2, 0x11, 0xbc, 0x0b,
+  0x10, 0xdb, 0x97, 0xc3, 0x5d, 0x33, 0xd1, 0xf4, 0xd1, 0x88, 0xe4, 0xaa, 0x10, 0xe1, 0xde, 0xc1, 0xea, 0xb6, 0xf1, 0x62, 0x1b, 0x3f, 0x34, 0x34,
+  0x1c, 0x08, 0x08, 0xf3, 0xd9, 0xe9, 0xcf, 0xc0, 0xa2, 0x16, 0xd3, 0xc0, 0xa1, 0xa1, 0x49, 0x7a, 0x19, 0x21, 0x19, 0xca, 0xc1, 0xa5, 0x34, 0x4b,
+  0x51, 0x56, 0x6c, 0x42, 0x05, 0x59, 0x41, 0xee, 0x48, 0x0c, 0xb7, 0xc2, 0x5e, 0xe9, 0x52, 0xc4, 0xf6, 0x9a, 0x80, 0x79, 0xd9, 0x49, 0x9e, 0xbe,
+  0x07, 0xc9, 0x69, 0x07, 0x6f, 0x84, 0xc5, 0x19, 0x58, 0x78, 0xb4, 0x0c, 0x89, 0x90, 0x37, 0xb6, 0xdc, 0xd3, 0x17, 0x93, 0xd1, 0x49, 0x2b, 0x6f,
+  0x00, 0x86, 0x33, 0x49, 0xc3, 0xc0, 0xfa, 0x0d, 0x01, 0x59, 0x7d, 0x18, 0x7d, 0xb1, 0xcb, 0xd3, 0x2f, 0xf7, 0x7e, 0x97, 0x58, 0xf5, 0xd4, 0x83,
+  0x42, 0x93, 0xf1, 0x28, 0x48, 0xd0, 0x36, 0xf0, 0xb3, 0x3b, 0x7f, 0x2a, 0x1c, 0xf0, 0xa2, 0xc4, 0x14, 0x7d, 0xc9, 0xfd, 0xb2, 0x8f, 0xc9, 0x1a,
+  0xa0, 0x53, 0x5b, 0x18, 0x66, 0xed, 0x65, 0xe4, 0xe3, 0xbe, 0x16, 0x6c, 0xe3, 0xa5, 0x06, 0x5f, 0x34, 0x4d, 0x43, 0x6d, 0xe6, 0x8b, 0x80, 0x2b,
+  0x61, 0xfb, 0xe2, 0xa1, 0x3b, 0xf1, 0x75, 0x20, 0x88, 0x98, 0xc1, 0xb0, 0xc0, 0x9a, 0xa5, 0x08, 0x59, 0x94, 0x53, 0x85, 0x27, 0xde, 0xd7, 0x73,
+  0xe9, 0x8d, 0xbd, 0x52, 0x2b, 0x76, 0x70, 0xb0, 0xc5, 0x41, 0x94, 0x3b, 0x20, 0x55, 0x76, 0xa4, 0xe2, 0xb2, 0x3c, 0x81, 0x31, 0x44, 0x4d, 0xc1,
+  0xb4, 0xd3, 0xd7, 0x9e, 0x27, 0xb9, 0x27, 0xf9, 0x3f, 0xb9, 0x53, 0x9a, 0x85, 0x59, 0x29, 0x3c, 0x53, 0xf4, 0x30, 0x42, 0xf9, 0xf4, 0xba, 0xfe,
+  0x1a, 0x2a, 0xf6, 0xa8, 0x1a, 0x32, 0x62, 0x26, 0xfb, 0x25, 0xcb, 0x4d, 0xbb, 0x4c, 0x6f, 0x46, 0x32, 0x1b, 0xa3, 0xe9, 0x1b, 0x47, 0x34, 0xe2,
+  0x63, 0x76, 0x08, 0x03, 0x66, 0xda, 0xca, 0x6f, 0xb1, 0x38, 0x80, 0xfb, 0xa1, 0x4b, 0x76, 0x05, 0x24, 0x41, 0x9a, 0xbc, 0x67, 0x01, 0xbd, 0x3e,
+  0xe8, 0xda, 0x6e, 0xb3, 0x92, 0x96, 0xbf, 0xa5, 0x6b, 0xd8, 0x3a, 0xaa, 0xb8, 0xa7, 0xe1, 0xe0, 0xc6, 0xa4, 0xb3, 0x95, 0xda, 0x3a, 0xad, 0x2e,
+  0xa4, 0x1f, 0x74, 0x6e, 0x50, 0x42, 0xa0, 0xb3, 0x19, 0xe5, 0x6b, 0x3e, 0xc8, 0x66, 0xb6, 0xb6, 0xa1, 0x28, 0x40, 0xd9, 0x6c, 0x7b, 0x74, 0x05,
+  0x9f, 0xdb, 0x68, 0x84, 0xac, 0xa9, 0xee, 0xdf, 0x2e, 0xe4, 0xa7, 0x53, 0xc7, 0x02, 0x63, 0xd4, 0x7d, 0xe8, 0xf9, 0x1b, 0x09, 0x40, 0x8b, 0x37,
+  0x29, 0xb7, 0xc8, 0xf3, 0xf0, 0x33, 0x84, 0x59, 0x19, 0xd8, 0x93, 0x74, 0x8a, 0x34, 0xb7, 0x79, 0x83, 0x04, 0xa3, 0xca, 0xd4, 0x5e, 0x85, 0x57,
+  0x69, 0xbd, 0xf2, 0x74, 0x35, 0xfd, 0xaf, 0x2f, 0x64, 0x83, 0xc3, 0xee, 0x1f, 0xba, 0xfc, 0x9d, 0x5b, 0xa3, 0x0e, 0x40, 0x46, 0x61, 0x66, 0x0f,
+  0x03, 0x13, 0x6b, 0xea, 0x6b, 0xa0, 0xb2, 0xac, 0x5a, 0x94, 0x43, 0x1b, 0x39, 0x4d, 0xbd, 0x66, 0xf0, 0xf4, 0x86, 0xf8, 0x38, 0xfe, 0xcd, 0xf5,
+  0x64, 0x76, 0x36, 0x2a, 0x21, 0xed, 0xc6, 0x11, 0xcf, 0xcc, 0xa2, 0x31, 0x78, 0xa4, 0x8f, 0xb8, 0x79, 0xd0, 0xf6, 0x25, 0x5a, 0xaa, 0xa3, 0xd4,
+  0xd1, 0xcb, 0xd0, 0x69, 0x77, 0xff, 0x4b, 0xc2, 0x8c, 0xa6, 0x20, 0xc7, 0xd5, 0x78, 0x5a, 0xc8, 0xd9, 0x3a, 0x44, 0xb4, 0x60, 0xaf, 0x40, 0xfb,
+  0x6d, 0xad, 0x2f, 0x7b, 0x00, 0xce, 0xb8, 0xcc, 0x47, 0x5b, 0x3e, 0xa7, 0x4d, 0x52, 0x7a, 0x7c, 0x6d, 0x9f, 0xa3, 0x15, 0xa8, 0xe5, 0x5c, 0x27,
+  0xed, 0x4d, 0xda, 0x62, 0x0e, 0x15, 0xd3, 0x90, 0xe7, 0x53, 0xc8, 0xf1, 0x23, 0x87, 0xd4, 0x58, 0xa2, 0x95, 0x03, 0xa8, 0x02, 0x35, 0xf3, 0x12,
+  0xa7, 0x4b, 0x40, 0x9b, 0x19, 0x94, 0x24, 0xda, 0x3b, 0x2f, 0xc6, 0x73, 0x58, 0xc8, 0x27, 0x35, 0xe7, 0x67, 0xca, 0x88, 0x2a, 0x9c, 0xe4, 0xb0,
+  0x9b, 0xfa, 0xc8, 0x17, 0xab, 0xe6, 0xe4, 0x8c, 0xc9, 0xa2, 0xd6, 0x4c, 0x32, 0x7e, 0xb1, 0x36, 0x87, 0x14, 0xbd, 0xd6, 0x70, 0xab, 0xe1, 0x1d,
+  0x8e, 0x1e, 0x43, 0x6b, 0x3b, 0xd3, 0x23, 0x79, 0x7e, 0x8e, 0x0e, 0x7b, 0x77, 0xe7, 0x24, 0xb3, 0x7d, 0x3f, 0x7f, 0x2a, 0x8a, 0x99, 0xdc, 0xbc,
+  0x01, 0x29, 0xd7, 0x52, 0x77, 0xb2, 0x90, 0x7f, 0xaa, 0x4b, 0xd7, 0x77, 0x5f, 0x6d, 0x6b, 0xff, 0x32, 0x2e, 0x30, 0x2e, 0x37, 0x37, 0xa2, 0xa5,
+  0x07, 0x05, 0x9c, 0x0b, 0xae, 0xbc, 0xee, 0xff, 0x54, 0xcf, 0xfb, 0x18, 0x82, 0x7b, 0x7c, 0xc1, 0xe5, 0x24, 0x08, 0x36, 0xb7, 0x6a, 0xa0, 0x20,
+  0x56, 0x18, 0xdc, 0xa8, 0x5d, 0x57, 0x79, 0xc7, 0x86, 0x8d, 0xc5, 0xe9, 0x35, 0x48, 0x6f, 0x57, 0x6c, 0x40, 0x8d, 0x0d, 0xd3, 0x4a, 0x4a, 0x5a,
+  0xd3, 0x7e, 0x67, 0x55, 0x80, 0xfb, 0x45, 0xdf, 0x81, 0x58, 0xf9, 0x34, 0xa7, 0x7e, 0xca, 0x1e, 0x54, 0x31, 0x51, 0xb6, 0x4c, 0x20, 0x96, 0xf9,
+  0xa2, 0x16, 0xc8, 0xff, 0x0a, 0x66, 0xb9, 0x8d, 0x22, 0x68, 0x8b, 0x92, 0x0c, 0x66, 0x4c, 0x1b, 0x01, 0x0b, 0x30, 0xd2, 0xeb, 0x79, 0x9b, 0xc4,
+  0xa8, 0x0f, 0xc9, 0x80, 0xe8, 0x8b, 0x9c, 0x60, 0x9d, 0x25, 0xa0, 0xac, 0xb2, 0xb0, 0x98, 0xe0, 0xae, 0x15, 0x36, 0x0a, 0xaa, 0xa2, 0x75, 0xa0,
+  0xc3, 0x2c, 0x19, 0xa9, 0x2e, 0xde, 0x09, 0x6b, 0xc6, 0x19, 0xea, 0xee, 0xa7, 0x03, 0x5e, 0xdf, 0xd2, 0x23, 0xc9, 0x4f, 0x8f, 0xb5, 0x42, 0xdc,
+  0x4d, 0x2f, 0x6b, 0x08, 0x51, 0x05, 0x6e, 0x90, 0xa4, 0x94, 0xef, 0xe9, 0x0d, 0x7f, 0x91, 0x85, 0x0a, 0xd3, 0x1e, 0xc6, 0xcf, 0x6b, 0x93, 0xb2,
+  0xeb, 0x67, 0x72, 0x11, 0x03, 0xae, 0x63, 0x98, 0x97, 0xfe, 0xf0, 0xa8, 0xfb, 0x27, 0x79, 0xc5, 0x69, 0x8c, 0x1a, 0x15, 0xa4, 0x78, 0x36, 0xe5,
+  0x26, 0xa0, 0x03, 0x6d, 0x01, 0x02, 0xaf, 0xab, 0x1f, 0xfc, 0xf7, 0xdb, 0x16, 0x37, 0xde, 0x1f, 0x21, 0x78, 0x04, 0x46, 0xb8, 0x91, 0x3e, 0x73,
+  0xbb, 0xbe, 0x2f, 0xec, 0x0c, 0x5d, 0xc6, 0xbf, 0xb6, 0xb1, 0xdb, 0x25, 0xba, 0xc2, 0x15, 0x4b, 0xa0, 0x8e, 0xb5, 0x7f, 0x75, 0xab, 0xee, 0xe3,
+  0x41, 0xe9, 0xf6, 0x0d, 0xb7, 0x08, 0x02, 0x0f, 0x03, 0xe2, 0xa6, 0xaf, 0xd1, 0x9e, 0x14, 0x63, 0x4f, 0x4f, 0xba, 0x99, 0x2a, 0xf5, 0xdc, 0xd5,
+  0x7c, 0x9b, 0x0f, 0x50, 0x5e, 0xf2, 0x93, 0xba, 0x70, 0x78, 0xad, 0x2a, 0x25, 0xf7, 0xcc, 0x1d, 0x5c, 0xf4, 0xa5, 0x29, 0xa1, 0xcd, 0x6a, 0x7a,
+  0x62, 0xc7, 0xc9, 0x73, 0xf1, 0x45, 0xc8, 0xc1, 0x91, 0x55, 0x4a, 0x47, 0x0f, 0x9f, 0xf9, 0xa6, 0xb4, 0xcd, 0xd3, 0x99, 0x55, 0xde, 0x9b, 0xb9,
+  0xfa, 0x03, 0xd4, 0x26, 0x99, 0xd5, 0x4f, 0x95, 0x6d, 0xf9, 0xe3, 0x3f, 0x60, 0x63, 0xaf, 0x60, 0x9a, 0xc5, 0xe5, 0x3b, 0xce, 0x73, 0x48, 0xb0,
+  0x40, 0x52, 0x43, 0x44, 0x6c, 0x28, 0x96, 0xeb, 0xd0, 0xc3, 0xe3, 0xc8, 0x0a, 0x49, 0xd5, 0x24, 0xcf, 0xe3, 0xde, 0xfe, 0x92, 0x25, 0x46, 0xf9,
+  0xd9, 0xcc, 0xce, 0x8c, 0xaf, 0xc6, 0xe9, 0x7f, 0x58, 0x88, 0x15, 0x8a, 0x8d, 0x7c, 0xcc, 0x61, 0x33, 0xc9, 0xc0, 0xb8, 0xee, 0xfb, 0x3b, 0x4f,
+  0x9b, 0x0e, 0xad, 0x65, 0x77, 0xb5, 0x34, 0xed, 0x41, 0x96, 0xc0, 0x02, 0xca, 0x62, 0x75, 0x8a, 0x16, 0x89, 0xce, 0x5a, 0xc5, 0x10, 0x3b, 0x65,
+  0x94, 0x85, 0xe5, 0x42, 0xe2, 0xd5, 0x85, 0x52, 0x7a, 0x81, 0x96, 0x33, 0x30, 0x36, 0x31, 0x17, 0x2e, 0xce, 0xb3, 0x4a, 0x5c, 0x93, 0x90, 0x5b,
+  0x67, 0xc7, 0x84, 0xdb, 0x26, 0x3f, 0x0b, 0xec, 0xff, 0x7e, 0x5f, 0xdd, 0x1b, 0x5f, 0xa1, 0x76, 0xc9, 0x14, 0x27, 0x50, 0x98, 0x07, 0x58, 0x47,
+  0x84, 0x9b, 0x05, 0x18, 0x08, 0x34, 0xfd, 0xde, 0xdd, 0x90, 0x7c, 0x96, 0x91, 0x36, 0x42, 0xec, 0xc7, 0x47, 0x6d, 0x18, 0xf2, 0x72, 0xc4, 0x97,
+  0xd1, 0x9b, 0xf6, 0x21, 0x41, 0xd7, 0x09, 0x56, 0x33, 0xfe, 0x2e, 0x60, 0x15, 0x07, 0x0d, 0x08, 0x8e, 0x5e, 0xde, 0xb4, 0x75, 0x7c, 0xf2, 0xd8,
+  0xe8, 0xe5, 0x10, 0xdc, 0x99, 0xa3, 0x65, 0xec, 0x1e, 0xb4, 0xf5, 0x17, 0x41, 0x51, 0x90, 0x3b, 0xa4, 0x16, 0xf4, 0xeb, 0xab, 0x81, 0x64, 0x2e,
+  0x72, 0xd9, 0x28, 0x5e, 0xf7, 0x3c, 0xfd, 0xb8, 0x38, 0x2c, 0x09, 0xf1, 0x41, 0xf0, 0x5a, 0x0f, 0xe7, 0x8d, 0xe7, 0x07, 0xd6, 0xeb, 0x0c, 0x42,
+  0xc9, 0x83, 0xb5, 0xbd, 0xa5, 0xc2, 0xfc, 0x7b, 0x0e, 0x19, 0x25, 0x51, 0xc1, 0x01, 0xf0, 0x32, 0xad, 0xbf, 0x4c, 0x96, 0x97, 0x70, 0xc2, 0xa7,
+  0x1a, 0x78, 0x52, 0x5f, 0x41, 0x63, 0x1f, 0x5f, 0x7b, 0x61, 0x2b, 0x70, 0x3d, 0xce, 0x24, 0xea, 0xed, 0xe4, 0x03, 0x77, 0xb7, 0xe9, 0x31, 0xcc,
+  0x09, 0x28, 0xed, 0xd5, 0x38, 0x13, 0xef, 0x9e, 0xdd, 0x5f, 0xe3, 0xbf, 0x23, 0xc7, 0x72, 0xf5, 0x18, 0xed, 0xed, 0x62, 0xd7, 0x05, 0xa0, 0x13,
+  0x73, 0xf8, 0x56, 0x52, 0xd2, 0x3b, 0x7a, 0x1d, 0xa0, 0x5d, 0x24, 0x54, 0x38, 0xbc, 0x0e, 0x2e, 0xb6, 0x73, 0x8d, 0xe3, 0x25, 0x70, 0xde, 0x26,
+  0x44, 0x6b, 0x69, 0x3f, 0x27, 0x06, 0x45, 0x92, 0xd6, 0x4b, 0x55, 0xcd, 0x2a, 0x42, 0x7d, 0x1b, 0x51, 0x74, 0xe7, 0x7b, 0x1d, 0x27, 0xfa, 0x83,
+  0x0e, 0xa1, 0xe5, 0xc9, 0xab, 0xec, 0x36, 0x8f, 0x7a, 0xd5, 0x49, 0x1e, 0x41, 0xc1, 0x33, 0xf8, 0x5d, 0x6e, 0xfd, 0x42, 0xff, 0x3d, 0xec, 0x3c,
+  0x18, 0x63, 0x4a, 0x6a, 0xe5, 0x29, 0x0e, 0xd5, 0xb9, 0xfa, 0x4b, 0x24, 0xfa, 0xa3, 0x04, 0x71, 0xce, 0x81, 0x57, 0x82, 0x23, 0x71, 0x00, 0xca,
+  0xd5, 0xf1, 0x86, 0x49, 0x2f, 0x5c, 0x6f, 0x0a, 0xe9, 0x68, 0x37, 0x46, 0x92, 0x2e, 0x23, 0xd7, 0x2e, 0x85, 0xc5, 0x3a, 0xb6, 0x2c, 0x32, 0x99,
+  0x14, 0xd4, 0x16, 0xe3, 0x9b, 0xbb, 0x7e, 0xc2, 0x46, 0x2c, 0x34, 0x23, 0x9c, 0xab, 0xb5, 0xa0, 0xcf, 0x31, 0x95, 0x4e, 0x33, 0x02, 0x10, 0xb1,
+  0xbb, 0x85, 0x68, 0xd7, 0xb8, 0xea, 0x0e, 0x84, 0xcf, 0x58, 0x55, 0x48, 0xd7, 0xa3, 0xdd, 0xf2, 0x7e, 0x17, 0x03, 0x68, 0xe9, 0xc3, 0x7a, 0x22,
+  0xdf, 0xaa, 0x44, 0x3f, 0x2f, 0x90, 0xd4, 0xfc, 0x5d, 0x09, 0x29, 0xb3, 0x5f, 0x93, 0x98, 0xdb, 0x01, 0x5b, 0x85, 0xee, 0x72, 0xf7, 0x84, 0x12,
+  0x1e, 0x5b, 0xb6, 0x3e, 0xd1, 0xd4, 0xdd, 0xe9, 0x52, 0xc7, 0xb6, 0xde, 0x61, 0x93, 0xc0, 0xe5, 0x0f, 0x4a, 0xdf, 0x1b, 0xf4, 0xbb, 0x7e, 0x72,
+  0x83, 0x06, 0x87, 0xcd, 0x89, 0x22, 0x05, 0x3e, 0x37, 0x17, 0x39, 0x9e, 0x2e, 0x2a, 0x1a, 0x4f, 0x40, 0x8e, 0xd1, 0xf4, 0x07, 0x04, 0x18, 0xed,
+  0xb2, 0xbd, 0x31, 0x42, 0x04, 0xd6, 0x99, 0xa3, 0x93, 0x76, 0x85, 0x3d, 0xb3, 0x71, 0x1a, 0x59, 0xde, 0x18, 0xb7, 0x2d, 0x0b, 0x45, 0x1f, 0x77,
+  0x7e, 0x95, 0x80, 0xc2, 0x47, 0x1c, 0x1f, 0x1f, 0x67, 0xe2, 0x23, 0x8a, 0x97, 0x3a, 0xdc, 0x3a, 0x25, 0xab, 0x92, 0x76, 0xbf, 0x65, 0x2a, 0xf2,
+  0xd3, 0x04, 0xf0, 0xa2, 0x63, 0xb1, 0x6b, 0x98, 0xd6, 0x9a, 0x86, 0x09, 0x65, 0xf8, 0xf0, 0x0d, 0xc6, 0x5c, 0x56, 0x66, 0x3d, 0xd6, 0x55, 0xb7,
+  0x6f, 0xd7, 0xfb, 0x90, 0xcd, 0xfc, 0xe9, 0x52, 0xd0, 0x66, 0xd8, 0x8f, 0x0d, 0x53, 0x84, 0x25, 0xf5, 0xae, 0xef, 0x5a, 0x3f, 0xde, 0x6c, 0xa9,
+  0xa1, 0x02, 0x5d, 0x1b, 0x87, 0x2f, 0x11, 0x53, 0x6e, 0x33, 0x81, 0xab, 0x05, 0x39, 0x23, 0x6b, 0xf8, 0x65, 0xc6, 0xff, 0xef, 0x74, 0xa2, 0x0b,
+  0xcf, 0xfa, 0xe2, 0xf9, 0xe2, 0x0a, 0x08, 0xdd, 0xa4, 0x9e, 0x44, 0xea, 0xad, 0x9f, 0x45, 0xa0, 0x8a, 0xce, 0xec, 0x09, 0x9f, 0x19, 0x40, 0x1f,
+  0x85, 0x03, 0x6f, 0x3c, 0xf3, 0x0a, 0x49, 0x1c, 0x4e, 0x58, 0xa5, 0x2a, 0x1e, 0x0f, 0x98, 0xf5, 0xf4, 0xeb, 0x83, 0xe6, 0x44, 0x15, 0x77, 0x97,
+  0x88, 0xee, 0x25, 0x70, 0x1f, 0x82, 0x21, 0xe2, 0x4b, 0xea, 0x68, 0x93, 0x49, 0x46, 0x3e, 0xbc, 0x16, 0xbd, 0x8b, 0x49, 0xd6, 0x74, 0x9c, 0xb1,
+  0x91, 0x38, 0xa6, 0x62, 0x33, 0x8c, 0xb5, 0x5d, 0x75, 0xe4, 0x8c, 0x4d, 0x9c, 0x7a, 0x78, 0xd1, 0x4f, 0x07, 0x3e, 0x55, 0x38, 0x30, 0x83, 0x8b,
+  0x62, 0xf8, 0x95, 0x65, 0x03, 0xec, 0x5a, 0x29,
+};
+
+const uint8_t fixture_delta[200] = {
+  0x44, 0x43, 0x44, 0x4c, 0x01, 0x00, 0x10, 0x00, 0x00, 0xfa, 0x8b, 0x04, 0x66, 0xf5, 0xcf, 0xfe, 0x1a, 0x0e, 0xb2, 0x58, 0x5b, 0x57, 0x82, 0xb8,
+  0x0f, 0x40, 0x10, 0x00, 0x00, 0xdd, 0xd1, 0xd4, 0x23, 0x7c, 0xa9, 0x46, 0x5e, 0x9c, 0xaf, 0xce, 0x0a, 0x95, 0x6d, 0x6d, 0xdd, 0x01, 0x80, 0x08,
+  0x03, 0x40, 0xdc, 0xf3, 0x3d, 0x52, 0x8e, 0x53, 0x7d, 0x45, 0x48, 0xe0, 0xfc, 0x37, 0x4b, 0x0e, 0xc5, 0x05, 0x28, 0x8d, 0x11, 0x9b, 0xdf, 0x59,
+  0x70, 0xa8, 0x0f, 0x84, 0x63, 0xd5, 0x70, 0x5a, 0xbc, 0xc3, 0x1b, 0x85, 0x39, 0xfd, 0xf5, 0xad, 0xbd, 0xef, 0x27, 0x6a, 0x56, 0xab, 0x5a, 0x23,
+  0xac, 0x33, 0x9d, 0x9c, 0xd9, 0x46, 0xd2, 0xd6, 0x84, 0x18, 0xbd, 0xdb, 0xbe, 0xec, 0xc2, 0xfe, 0x79, 0x44, 0x01, 0x10, 0x02, 0x02, 0x11, 0x82,
+  0x01, 0xfe, 0x01, 0x02, 0x02, 0x13, 0x88, 0x01, 0xfe, 0x01, 0x02, 0x02, 0x35, 0xf5, 0x01, 0xfe, 0x01, 0x02, 0x02, 0x1d, 0xc5, 0x01, 0xfe, 0x01,
+  0x02, 0x01, 0xed, 0x01, 0xff, 0x01, 0x02, 0x02, 0x21, 0x64, 0x01, 0xfe, 0x01, 0x02, 0x01, 0xe9, 0x01, 0xff, 0x01, 0x02, 0x01, 0x79, 0x01, 0xac,
+  0x01, 0x02, 0x01, 0x37, 0x01, 0x52, 0x02, 0x02, 0x22, 0x68, 0x01, 0xfe, 0x01, 0x02, 0x01, 0x40, 0x01, 0xff, 0x01, 0x02, 0x01, 0xed, 0x01, 0xff,
+  0x01, 0x02, 0x02, 0x37, 0x17, 0x01, 0xee, 0x01,
+};
@@ -0,0 +1,197 @@
+#line 2 "FlightRecorderTest.ino"
+
+#include <AUnit.h>
+#include "../../DCTransistor/LoopProfiler.h"
+#include "../../DCTransistor/FlightRecorder.h"
+
+/*
+Unit tests for FlightRecorder. RTC user memory is stood in for by a RAM array that outlives each
+recorder object, so constructing a new recorder and calling begin() is a reboot.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+uint32_t fake_rtc[96];
+uint16_t rtc_writes = 0; //Blocks written
+
+struct RamStore {
+  static bool read(uint8_t block, uint32_t* data, size_t bytes){
+    memcpy(data, &fake_rtc[block], bytes);
+    return true;
+  }
+  static bool write(uint8_t block, uint32_t* data, size_t bytes){
+    memcpy(&fake_rtc[block], data, bytes);
+    rtc_writes += bytes / 4;
+    return true;
+  }
+};
+
+typedef FlightRecorder<RamStore, 4> TestRecorder;
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[1024];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+//Power loss leaves RTC memory random
+void powerLoss(){
+  for(uint8_t i=0; i<96; i++){fake_rtc[i] = 0xA5A5A5A5 ^ (i * 2654435761u);}
+}
+
+void runLoop(TestRecorder &recorder, uint16_t loop, int16_t http_code){
+  recorder.beginLoop(loop);
+  recorder.setPhase(PROF_HANDSHAKE);
+  recorder.setFetch(http_code, 900);
+  recorder.noteHeap(41000, 12);
+  recorder.noteHeap(23000, 30);
+  recorder.setPhase(PROF_DESERIALIZE);
+  recorder.setParse(350, 80);
+  recorder.setPhase(PROF_COMPOSITE);
+  recorder.endLoop();
+}
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(power_on_has_no_history){
+  powerLoss();
+  TestRecorder recorder;
+  recorder.begin();
+  assertEqual(recorder.getPreviousCount(), (uint8_t)0);
+  assertEqual(recorder.getBootCount(), (uint32_t)1);
+}
+
+test(records_survive_reset){
+  powerLoss();
+  {
+    TestRecorder recorder;
+    recorder.begin();
+    runLoop(recorder, 1, 200);
+    runLoop(recorder, 2, 503);
+  }
+
+  TestRecorder rebooted;
+  rebooted.begin();
+  assertEqual(rebooted.getBootCount(), (uint32_t)2);
+  assertEqual(rebooted.getPreviousCount(), (uint8_t)2);
+
+  const FlightRecord &r = rebooted.getPrevious(1);
+  assertEqual(r.loop, (uint16_t)2);
+  assertEqual(r.http_code, (int16_t)503);
+  assertEqual(r.fetch_ms, (uint16_t)900);
+  assertEqual(r.parse_ms, (uint16_t)350);
+  assertEqual(r.heap_min, (uint16_t)23000);
+  assertEqual(r.fragmentation_max, (uint8_t)30);
+  assertEqual(r.trains, (uint8_t)80);
+  assertEqual(r.phase, (uint8_t)PROF_COMPOSITE);
+  assertEqual(r.flags, (uint8_t)0);
+
+  //Reading back starts a fresh ring
+  TestRecorder again;
+  again.begin();
+  assertEqual(again.getPreviousCount(), (uint8_t)0);
+  assertEqual(again.getBootCount(), (uint32_t)3);
+}
+
+test(crash_mid_loop_keeps_phase){
+  powerLoss();
+  {
+    TestRecorder recorder;
+    recorder.begin();
+    for(uint16_t l=1; l<=6; l++){
+      runLoop(recorder, l, 200);
+    }
+
+    //Board resets during handshake of loop 7
+    recorder.beginLoop(7);
+    recorder.setPhase(PROF_HANDSHAKE);
+  }
+
+  TestRecorder rebooted;
+  rebooted.begin();
+
+  //Ring was full, so unfinished loop replaced the oldest finished one
+  assertEqual(rebooted.getPreviousCount(), (uint8_t)4);
+  assertEqual(rebooted.getPrevious(0).loop, (uint16_t)4);
+  assertEqual(rebooted.getPrevious(2).loop, (uint16_t)6);
+  assertEqual(rebooted.getPrevious(3).loop, (uint16_t)7);
+  assertEqual(rebooted.getPrevious(3).phase, (uint8_t)PROF_HANDSHAKE);
+  assertTrue(rebooted.getPrevious(3).flags & FLIGHT_IN_PROGRESS);
+}
+
+test(earlier_crash_not_reported_as_in_progress){
+  powerLoss();
+  {
+    TestRecorder recorder;
+    recorder.begin();
+    runLoop(recorder, 0, 200);
+    runLoop(recorder, 1, 200);
+    recorder.beginLoop(2); //Crashes in slot 2
+    recorder.setPhase(PROF_HANDSHAKE);
+  }
+  {
+    //Next boot finishes two loops, then restarts between loops (e.g. to apply an update)
+    TestRecorder recorder;
+    recorder.begin();
+    assertEqual(recorder.getPreviousCount(), (uint8_t)3);
+    runLoop(recorder, 0, 200);
+    runLoop(recorder, 1, 503);
+  }
+
+  //Slot 2 still held the first boot's unfinished loop 2, which mustn't show up as this boot's
+  TestRecorder rebooted;
+  rebooted.begin();
+  assertEqual(rebooted.getPreviousCount(), (uint8_t)2);
+  assertEqual(rebooted.getPrevious(1).loop, (uint16_t)1);
+  assertEqual(rebooted.getPrevious(1).http_code, (int16_t)503);
+  assertFalse(rebooted.getPrevious(1).flags & FLIGHT_IN_PROGRESS);
+}
+
+test(phase_change_writes_one_block){
+  powerLoss();
+  TestRecorder recorder;
+  recorder.begin();
+  recorder.beginLoop(1);
+
+  rtc_writes = 0;
+  recorder.setPhase(PROF_FIND);
+  assertEqual(rtc_writes, (uint16_t)1);
+}
+
+test(report_format){
+  powerLoss();
+  {
+    TestRecorder recorder;
+    recorder.begin();
+    runLoop(recorder, 1, 200);
+    recorder.beginLoop(2);
+    recorder.setPhase(PROF_HANDSHAKE);
+  }
+
+  TestRecorder rebooted;
+  rebooted.begin();
+
+  BufferPrint out;
+  CrashInfo crash = {"Hardware Watchdog", 4, 0x40201234, 0};
+  rebooted.printReport(out, crash, profile_phase_names, NUM_PROFILE_PHASES);
+
+  assertEqual(out.buf,
+    "boot 2 reset=Hardware Watchdog exccause=4 epc1=0x40201234 excvaddr=0x0\n"
+    "loop http fetch_ms parse_ms loop_ms heap_min frag_max trains flags phase\n"
+    "1 200 900 350 0 23000 30 80 0x0 composite\n"
+    "2 0 0 0 0 65535 0 0 0x1 handshake\n");
+}
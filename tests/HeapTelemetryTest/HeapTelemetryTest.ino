@@ -0,0 +1,96 @@
+#line 2 "HeapTelemetryTest.ino"
+
+#include <AUnit.h>
+#include "../../DCTransistor/HeapTelemetry.h"
+
+/*
+Unit tests for HeapTelemetry ring buffer, per-phase min / max and low-water marks.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[1024];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(ring_keeps_most_recent){
+  HeapTelemetry<4> telemetry;
+  assertEqual(telemetry.getSampleCount(), (uint8_t)0);
+
+  for(uint16_t i=0; i<6; i++){
+    telemetry.nextLoop();
+    telemetry.record(HEAP_PRE_TLS, 40000 - i, 30000, 10);
+  }
+
+  assertEqual(telemetry.getSampleCount(), (uint8_t)4);
+  assertEqual(telemetry.getSample(0).free_heap, (uint16_t)39995);
+  assertEqual(telemetry.getSample(3).free_heap, (uint16_t)39998);
+  assertEqual(telemetry.getSample(0).loop, (uint16_t)6);
+}
+
+test(phase_min_max_and_low_water){
+  HeapTelemetry<8> telemetry;
+
+  telemetry.nextLoop();
+  telemetry.record(HEAP_PRE_TLS, 40000, 32000, 5);
+  telemetry.record(HEAP_POST_HANDSHAKE, 14000, 9000, 30);
+  telemetry.record(HEAP_POST_RENDER, 39000, 31000, 6);
+
+  telemetry.nextLoop();
+  telemetry.record(HEAP_PRE_TLS, 38000, 33000, 4);
+  telemetry.record(HEAP_POST_HANDSHAKE, 15000, 8000, 25);
+
+  const HeapPhaseStats &pre = telemetry.getPhaseStats(HEAP_PRE_TLS);
+  assertEqual(pre.min_free, (uint16_t)38000);
+  assertEqual(pre.max_free, (uint16_t)40000);
+  assertEqual(pre.min_block, (uint16_t)32000);
+  assertEqual(pre.max_fragmentation, (uint8_t)5);
+  assertEqual(pre.count, (uint32_t)2);
+
+  assertEqual(telemetry.getLowWaterFree(), (uint16_t)14000);
+  assertEqual(telemetry.getLowWaterBlock(), (uint16_t)8000);
+  assertEqual(telemetry.getHighWaterFragmentation(), (uint8_t)30);
+
+  //No samples for mid_parse, so it's left out of low-water marks and output
+  assertEqual(telemetry.getPhaseStats(HEAP_MID_PARSE).count, (uint32_t)0);
+}
+
+test(large_values_clamp){
+  HeapTelemetry<2> telemetry;
+  telemetry.record(HEAP_PRE_TLS, 100000, 70000, 0);
+  assertEqual(telemetry.getSample(0).free_heap, (uint16_t)0xFFFF);
+  assertEqual(telemetry.getSample(0).max_block, (uint16_t)0xFFFF);
+}
+
+test(prometheus_metrics){
+  HeapTelemetry<8> telemetry;
+  telemetry.record(HEAP_POST_HANDSHAKE, 14000, 9000, 30);
+
+  BufferPrint out;
+  telemetry.printMetrics(out);
+
+  assertTrue(strstr(out.buf, "# TYPE dctransistor_heap_free_min_bytes gauge\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_heap_free_min_bytes{phase=\"post_handshake\"} 14000\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_heap_block_min_bytes{phase=\"post_handshake\"} 9000\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_heap_fragmentation_max_percent{phase=\"post_handshake\"} 30\n") != NULL);
+  assertTrue(strstr(out.buf, "pre_tls") == NULL);
+  assertTrue(strchr(out.buf, '\r') == NULL);
+}
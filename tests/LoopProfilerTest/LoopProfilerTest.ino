@@ -0,0 +1,97 @@
+#line 2 "LoopProfilerTest.ino"
+
+#include <AUnit.h>
+
+#define PROFILE
+#include "../../DCTransistor/LoopProfiler.h"
+
+/*
+Unit tests for LoopProfiler histogram buckets, per-phase summaries, scoped timers and report format.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[1024];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(buckets_are_log2){
+  assertEqual(LoopProfiler::bucketFor(0), (uint8_t)0);
+  assertEqual(LoopProfiler::bucketFor(1), (uint8_t)0);
+  assertEqual(LoopProfiler::bucketFor(2), (uint8_t)1);
+  assertEqual(LoopProfiler::bucketFor(3), (uint8_t)1);
+  assertEqual(LoopProfiler::bucketFor(1023), (uint8_t)9);
+  assertEqual(LoopProfiler::bucketFor(1024), (uint8_t)10);
+
+  //Anything past the last bucket lands in it
+  assertEqual(LoopProfiler::bucketFor(1UL << 23), (uint8_t)(PROFILE_BUCKETS - 1));
+  assertEqual(LoopProfiler::bucketFor(0xFFFFFFFF), (uint8_t)(PROFILE_BUCKETS - 1));
+}
+
+test(record_keeps_summary_per_phase){
+  LoopProfiler profiler;
+  profiler.record(PROF_HANDSHAKE, 400000);
+  profiler.record(PROF_HANDSHAKE, 900000);
+  profiler.record(PROF_HANDSHAKE, 5000000);
+
+  const PhaseHistogram &hist = profiler.getPhase(PROF_HANDSHAKE);
+  assertEqual(hist.count, (uint32_t)3);
+  assertEqual(hist.min_us, (uint32_t)400000);
+  assertEqual(hist.max_us, (uint32_t)5000000);
+  assertEqual((uint32_t)hist.total_us, (uint32_t)6300000);
+  assertEqual(hist.buckets[18], (uint32_t)1); //400ms
+  assertEqual(hist.buckets[19], (uint32_t)1); //900ms
+  assertEqual(hist.buckets[22], (uint32_t)1); //5s
+
+  //Other phases untouched
+  assertEqual(profiler.getPhase(PROF_DNS).count, (uint32_t)0);
+
+  profiler.reset();
+  assertEqual(profiler.getPhase(PROF_HANDSHAKE).count, (uint32_t)0);
+}
+
+test(scoped_timer_records_once){
+  loop_profiler.reset();
+  {
+    PROFILE_START(timer, PROF_SHOW);
+    PROFILE_STOP(timer);
+    PROFILE_STOP(timer); //Second stop and destructor must not record again
+  }
+  {
+    PROFILE_SCOPE(PROF_SHOW);
+  }
+
+  assertEqual(loop_profiler.getPhase(PROF_SHOW).count, (uint32_t)2);
+}
+
+test(report_format){
+  LoopProfiler profiler;
+  profiler.record(PROF_DNS, 3);
+  profiler.record(PROF_DNS, 5);
+
+  BufferPrint out;
+  profiler.printReport(out);
+
+  assertEqual(out.buf,
+    "#PROFILE 24\n"
+    "dns count=2 total_us=8 min_us=3 max_us=5 hist=0,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0\n"
+    "#END\n");
+}
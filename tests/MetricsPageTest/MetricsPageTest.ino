@@ -0,0 +1,284 @@
+#line 2 "MetricsPageTest.ino"
+
+#include <AUnit.h>
+
+//Values normally defined in config.h. Board sizes are the larger of the two boards'.
+#define CYCLES_AT_END 2
+#define TOTAL_SYSTEM_STATIONS 100
+#define MAX_SPECIAL_TRAINS 4
+#define MAX_CAMPAIGNS 8
+#define MAX_SPECIAL_CARS 8
+#define TLS_HOSTS 4
+#define LED_COUNT 207
+#define NUM_STATUS_LEDS 3
+#define NUM_LINES 6
+#define LED_BRIGHTNESS 3
+#define GAMMA_RED_X10 10
+#define GAMMA_GREEN_X10 10
+#define GAMMA_BLUE_X10 10
+#define LED_CHANNEL_UA 20000
+#define LED_IDLE_UA 600
+#define LED_POWER_BUDGET_MA 500
+#define MULTIPLEX_SHARED_STATIONS true
+#define FADE_MS 1000
+#define FRAME_MS 33
+
+#include "../../DCTransistor/FlashData.h"
+#include "../../DCTransistor/LoopProfiler.h"
+#include "../../DCTransistor/YieldMonitor.h"
+#include "../../DCTransistor/HttpStream.h"
+#include "../../DCTransistor/FlashFile.h"
+#include "../../DCTransistor/WallClock.h"
+#include "../../DCTransistor/CampaignCache.h"
+#include "../../DCTransistor/SpecialTrains.h"
+#include "../../DCTransistor/DeferredTasks.h"
+#include "../../DCTransistor/TlsPins.h"
+#include "../../DCTransistor/TlsBuffers.h"
+#include "../../DCTransistor/UpdateManifest.h"
+#include "../../DCTransistor/OtaDownload.h"
+
+//NeoPixel strip stand-in. Only the Compositor's metrics are used here.
+class Adafruit_NeoPixel {
+  public:
+    void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b){}
+    void show(){}
+};
+
+#include "../../DCTransistor/Compositor.h"
+#include "../../DCTransistor/WarmStart.h"
+#include "../../DCTransistor/MetricsPage.h"
+
+/*
+Unit tests for the /metrics page: fetch statistics, Prometheus formatting, and that a full board's page fits
+the buffer the boards allocate. Exercises the same formatMetrics call the endpoint serves, without a web server.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define NUM_TEST_LINES 6
+
+const StationCode test_codes[3] FLASH_TABLE = {"A01", "A02", "A03"};
+const uint8_t test_leds[3] FLASH_TABLE = {10, 11, 12};
+
+typedef TrainLine<2, 34> TestLine;
+
+TestLine red(3, test_codes, "Red", 0xFF0000, 100, 100, test_leds, test_leds);
+TestLine blue(3, test_codes, "Blue", 0x0000FF, 100, 100, test_leds, test_leds);
+TestLine orange(3, test_codes, "Orange", 0xFF8000, 100, 100, test_leds, test_leds);
+TestLine silver(3, test_codes, "Silver", 0x808080, 100, 100, test_leds, test_leds);
+TestLine yellow(3, test_codes, "Yellow", 0xFFFF00, 100, 100, test_leds, test_leds);
+TestLine green(3, test_codes, "Green", 0x00FF00, 100, 100, test_leds, test_leds);
+TestLine* test_lines[NUM_TEST_LINES] = {&red, &blue, &orange, &silver, &yellow, &green};
+
+//Flash file, update partition and TLS client stand-ins. Nothing is stored or connected, only counted on the page.
+struct NullStore {
+  static bool read(uint8_t* out, size_t n){return false;}
+  static bool write(const uint8_t* in, size_t n){return true;}
+};
+
+struct NullSink {
+  static bool begin(uint32_t n, const char* h){return true;}
+  static size_t write(const uint8_t* d, size_t n){return n;}
+  static bool end(){return true;}
+  static void abort(){}
+  static uint16_t room(){return 0xFFFF;}
+  static uint16_t pump(uint16_t max_bytes){return 0;}
+};
+
+void noTask(){}
+
+#define TEST_PIN "25 A4 C6 13 0A 81 28 F8 01 DC 1B 14 90 88 50 49 93 16 51 37"
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(fetch_histogram_is_cumulative){
+  FetchStats fetch;
+  fetch.record(50, true, false);
+  fetch.record(300, true, true);
+  fetch.record(20000, false, false);
+
+  assertEqual(fetch.getPolls(), (uint32_t)3);
+  assertEqual(fetch.getFailures(), (uint32_t)1);
+  assertEqual(fetch.getRedundant(), (uint32_t)1);
+  assertEqual(fetch.getRedundantPermille(), (uint16_t)500);
+
+  MetricsPage<1024> page;
+  fetch.printMetrics(page);
+  assertTrue(strstr(page.c_str(), "dctransistor_fetch_duration_ms_bucket{le=\"100\"} 1\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_fetch_duration_ms_bucket{le=\"250\"} 1\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_fetch_duration_ms_bucket{le=\"500\"} 2\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_fetch_duration_ms_bucket{le=\"+Inf\"} 3\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_fetch_duration_ms_sum 20350\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_redundant_poll_ratio 0.500\n") != NULL);
+}
+
+test(full_page_fits_board_buffer){
+  HeapTelemetry<32> heap;
+  for(uint8_t p=0; p<NUM_HEAP_PHASES; p++){
+    heap.record((HeapPhase)p, 45000, 30000, 12);
+  }
+
+  FetchStats fetch;
+  fetch.record(800, true, false);
+
+  FreshnessStats freshness;
+  freshness.record(1700000000000ULL, 1700000021500ULL);
+
+  red.setTrainStateByCode("A02-A1-010", 0);
+  red.setTrainStateByCode("A03-A1-010", 1);
+
+  BoardStatus status = {"2.0.76", "Hardware Watchdog", 3600, 7, 1, 180, 9500};
+
+  MetricsPage<METRICS_PAGE_LEN> page;
+  formatMetrics(page, status, test_lines, NUM_TEST_LINES, fetch, freshness, heap);
+  red.clearState();
+
+  assertFalse(page.overflowed());
+  assertTrue(strstr(page.c_str(), "dctransistor_build_info{version=\"2.0.76\"} 1\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_reset_reason_info{reason=\"Hardware Watchdog\"} 1\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_time_to_first_frame_ms 180\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_time_to_live_frame_ms 9500\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_line_trains{line=\"Red\"} 2\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_line_trains{line=\"Green\"} 0\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_tls_handshakes_total 7\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_data_freshness_seconds{quantile=\"0.99\"} 21.500\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_heap_free_min_bytes{phase=\"post_render\"} 45000\n") != NULL);
+
+  //Every line is a comment or "name value" with a bare \n
+  assertEqual(page.c_str()[page.length() - 1], '\n');
+  assertTrue(strstr(page.c_str(), "\r") == NULL);
+}
+
+//Everything update_metrics_page adds to a board's page, with every labelled series present: all TLS hosts, background
+//tasks, special trains and yield phases. Counters that are still 1 digit here can reach 10 (uint32_t) on a board that
+//has run for a while, so the page must fit with 9 more bytes for every sample.
+test(whole_board_page_fits_worst_case){
+  HeapTelemetry<32> heap;
+  for(uint8_t p=0; p<NUM_HEAP_PHASES; p++){
+    heap.record((HeapPhase)p, 45000, 30000, 12);
+  }
+  FetchStats fetch;
+  fetch.record(800, true, false);
+  FreshnessStats freshness;
+  freshness.record(1700000000000ULL, 1700000021500ULL);
+  BoardStatus status = {"2.0.76", "Hardware Watchdog", 3600, 7, 1, 180, 9500};
+
+  Adafruit_NeoPixel strip;
+  Compositor compositor(strip);
+
+  YieldMonitor yields;
+  yields.setBudget(0);
+  for(uint8_t p=0; p<NUM_PROFILE_PHASES; p++){
+    yields.setPhase(p);
+    delay(1);
+    yields.yieldPoint();
+  }
+
+  WarmStart<NullStore, NUM_LINES, 2, 34> warm_start(0);
+  WallClock wall_clock;
+  CampaignCache<NullStore, MAX_CAMPAIGNS, MAX_SPECIAL_CARS> campaign_cache;
+
+  SpecialTrains<MAX_SPECIAL_TRAINS> special_trains;
+  for(uint8_t i=0; i<MAX_SPECIAL_TRAINS; i++){
+    special_trains.add(-32000 - i, i);
+  }
+
+  DeferredTasks<2> background_tasks;
+  background_tasks.add("check_update", noTask, 1000, true);
+  background_tasks.add("check_special", noTask, 1000, true);
+
+  TlsPins<TLS_HOSTS> tls_pins;
+  TlsBuffers<TLS_HOSTS> tls_buffers;
+  const char* hosts[TLS_HOSTS] = {"api.wmata.com", "gis.wmata.com", "gisservices.wmata.com", "raw.githubusercontent.com"};
+  for(uint8_t h=0; h<TLS_HOSTS; h++){
+    assertTrue(tls_pins.add(hosts[h], PSTR(TEST_PIN), h == TLS_HOSTS - 1));
+    assertTrue(tls_buffers.add(hosts[h]));
+  }
+
+  UpdateManifest update_manifest;
+  OtaDownload<NullSink> ota;
+
+  //Same order as update_metrics_page
+  MetricsPage<METRICS_PAGE_LEN> page;
+  formatMetrics(page, status, test_lines, NUM_TEST_LINES, fetch, freshness, heap);
+  compositor.printMetrics(page);
+  yields.printMetrics(page);
+  warm_start.printMetrics(page);
+  wall_clock.printMetrics(page);
+  campaign_cache.printMetrics(page);
+  special_trains.printMetrics(page);
+  background_tasks.printMetrics(page);
+  tls_pins.printMetrics(page);
+  tls_buffers.printMetrics(page);
+  update_manifest.printMetrics(page);
+  ota.printMetrics(page);
+
+  assertFalse(page.overflowed());
+  assertTrue(strstr(page.c_str(), "dctransistor_ota_failures_total 0\n") != NULL); //Last series made it in
+
+  uint16_t samples = 0;
+  const char* line = page.c_str();
+  while(*line != '\0'){
+    if(*line != '#'){samples++;}
+    line = strchr(line, '\n') + 1;
+  }
+  Serial.print(F("Worst case metrics page: "));
+  Serial.print(page.length());
+  Serial.print(F(" bytes, "));
+  Serial.print(samples);
+  Serial.println(F(" samples"));
+  assertLess((uint32_t)page.length() + (samples * 9UL), (uint32_t)METRICS_PAGE_LEN);
+}
+
+test(freshness_percentiles){
+  FreshnessStats freshness;
+  assertEqual(freshness.getPercentile(50), (uint32_t)0);
+
+  //Unsynced clock or missing ETIME isn't counted
+  freshness.record(0, 1700000000000ULL);
+  freshness.record(1700000000000ULL, 0);
+  assertEqual(freshness.getCount(), (uint32_t)0);
+
+  //Lags of 1..10 seconds, recorded out of order
+  const uint8_t lags_s[10] = {7, 3, 10, 1, 5, 9, 2, 8, 4, 6};
+  for(uint8_t i=0; i<10; i++){
+    freshness.record(1700000000000ULL, 1700000000000ULL + (lags_s[i] * 1000));
+  }
+  assertEqual(freshness.getCount(), (uint32_t)10);
+  assertEqual(freshness.getPercentile(10), (uint32_t)1000);
+  assertEqual(freshness.getPercentile(50), (uint32_t)5000);
+  assertEqual(freshness.getPercentile(95), (uint32_t)10000);
+  assertEqual(freshness.getPercentile(99), (uint32_t)10000);
+
+  //Window keeps last FRESHNESS_WINDOW polls only
+  for(uint8_t i=0; i<FRESHNESS_WINDOW; i++){
+    freshness.record(1700000000000ULL, 1700000000250ULL);
+  }
+  assertEqual(freshness.getPercentile(99), (uint32_t)250);
+
+  //WMATA clock ahead of ours counts as no lag
+  freshness.record(1700000005000ULL, 1700000000000ULL);
+  assertEqual(freshness.getLast(), (uint32_t)0);
+
+  MetricsPage<512> page;
+  freshness.printMetrics(page);
+  assertTrue(strstr(page.c_str(), "dctransistor_data_freshness_seconds_count 75\n") != NULL);
+  assertTrue(strstr(page.c_str(), "dctransistor_data_freshness_last_seconds 0.000\n") != NULL);
+}
+
+test(small_page_flags_overflow){
+  MetricsPage<16> page;
+  page.value("dctransistor_polls_total", 12345);
+  assertTrue(page.overflowed());
+  assertEqual(page.length(), (uint16_t)15);
+
+  page.begin();
+  assertFalse(page.overflowed());
+  assertEqual(page.length(), (uint16_t)0);
+}
@@ -0,0 +1,283 @@
+#line 2 "OtaDownloadTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/FlashFile.h"
+#include "../../DCTransistor/OtaDownload.h"
+
+/*
+Unit tests for OtaDownload slicing, resuming after a dropped connection, hash and write failures, and metrics, and a
+simulated download that compares the longest frame stall of one blocking download with the sliced one.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define IMAGE_LEN 32768
+#define SLICE_BYTES 4096
+#define CHUNK_COST_MS 1 //Stand-in for writing one chunk to flash
+
+uint8_t image[IMAGE_LEN];
+char image_hash[9]; /* Flawfinder: ignore */
+
+//Update partition stand-in. Hash is the image's CRC-32 as 8 hex characters.
+struct RamSink {
+  static uint8_t data[IMAGE_LEN];
+  static uint32_t size;
+  static uint32_t written;
+  static char hash[OTA_HASH_LEN];
+  static bool fail_writes;
+  static uint32_t write_cost_ms;
+  static uint8_t aborts;
+
+  static bool begin(uint32_t n, const char* h){
+    if(n > IMAGE_LEN){return false;}
+    size = n;
+    written = 0;
+    strcpy(hash, h); /* Flawfinder: ignore */
+    return true;
+  }
+  static size_t write(const uint8_t* d, size_t n){
+    if(fail_writes){return 0;}
+    delay(write_cost_ms);
+    memcpy(data + written, d, n);
+    written += n;
+    return n;
+  }
+  static bool end(){
+    char actual[9]; /* Flawfinder: ignore */
+    snprintf(actual, sizeof(actual), "%08x", (unsigned int)crc32(data, size));
+    return written == size && strcmp(actual, hash) == 0;
+  }
+  static void abort(){
+    aborts++;
+  }
+  static uint16_t room(){
+    return 0xFFFF;
+  }
+  static uint16_t pump(uint16_t max_bytes){
+    return 0;
+  }
+  static void reset(){
+    size = 0;
+    written = 0;
+    fail_writes = false;
+    write_cost_ms = 0;
+    aborts = 0;
+  }
+};
+uint8_t RamSink::data[IMAGE_LEN];
+uint32_t RamSink::size = 0;
+uint32_t RamSink::written = 0;
+char RamSink::hash[OTA_HASH_LEN];
+bool RamSink::fail_writes = false;
+uint32_t RamSink::write_cost_ms = 0;
+uint8_t RamSink::aborts = 0;
+
+//Response body stand-in: bytes [from, to) of image, with at most `burst` available at a time
+class ImageStream : public Stream {
+  public:
+    uint32_t pos;
+    uint32_t to;
+    uint32_t burst;
+    uint32_t released; //Bytes made available so far
+    ImageStream(uint32_t from, uint32_t to, uint32_t burst) : pos(from), to(to), burst(burst), released(from) {}
+    void arrive(){ released = min(to, released + burst); } //Next burst of bytes comes in from network
+    int available() override { return released - pos; }
+    int read() override { return (pos < released) ? image[pos++] : -1; }
+    int peek() override { return (pos < released) ? image[pos] : -1; }
+    size_t write(uint8_t) override { return 0; }
+};
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[1024];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+void setup() {
+  Serial.begin(9600);
+  for(uint32_t i=0; i<IMAGE_LEN; i++){
+    image[i] = (uint8_t)((i * 31) ^ (i >> 7));
+  }
+  snprintf(image_hash, sizeof(image_hash), "%08x", (unsigned int)crc32(image, IMAGE_LEN));
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(whole_image_in_slices){
+  RamSink::reset();
+  OtaDownload<RamSink> ota;
+  assertTrue(ota.begin(image_hash));
+  assertEqual(ota.getState(), OTA_STARTING);
+  assertTrue(ota.setSize(IMAGE_LEN));
+
+  ImageStream body(0, IMAGE_LEN, IMAGE_LEN);
+  body.arrive();
+  uint8_t slices = 0;
+  while(ota.isActive()){
+    assertEqual(ota.receive(body, SLICE_BYTES), (uint16_t)SLICE_BYTES); //Never more than one slice at a time
+    slices++;
+  }
+  assertEqual(slices, (uint8_t)(IMAGE_LEN / SLICE_BYTES));
+  assertTrue(ota.isReady());
+  assertEqual(memcmp(RamSink::data, image, IMAGE_LEN), 0);
+
+  assertFalse(ota.begin(image_hash)); //Waiting to reboot into this one
+}
+
+test(only_reads_bytes_already_arrived){
+  RamSink::reset();
+  OtaDownload<RamSink> ota;
+  ota.begin(image_hash);
+  ota.setSize(IMAGE_LEN);
+
+  ImageStream body(0, IMAGE_LEN, 700);
+  assertEqual(ota.receive(body, SLICE_BYTES), (uint16_t)0);
+  body.arrive();
+  assertEqual(ota.receive(body, SLICE_BYTES), (uint16_t)700);
+  assertEqual(ota.getOffset(), (uint32_t)700);
+}
+
+test(resumes_from_offset_after_drop){
+  RamSink::reset();
+  OtaDownload<RamSink> ota;
+  ota.begin(image_hash);
+  ota.setSize(IMAGE_LEN);
+
+  //First response drops part way through
+  ImageStream first(0, 10000, IMAGE_LEN);
+  first.arrive();
+  while(ota.receive(first, SLICE_BYTES) > 0){}
+  ota.interrupted();
+  assertEqual(ota.getOffset(), (uint32_t)10000);
+  assertTrue(ota.isActive());
+
+  //Range response for the rest must be for the same image
+  assertFalse(ota.setSize(IMAGE_LEN + 1));
+  assertTrue(ota.setSize(IMAGE_LEN));
+  ImageStream rest(ota.getOffset(), IMAGE_LEN, IMAGE_LEN);
+  rest.arrive();
+  while(ota.receive(rest, SLICE_BYTES) > 0){}
+
+  assertTrue(ota.isReady());
+  assertEqual(memcmp(RamSink::data, image, IMAGE_LEN), 0);
+
+  BufferPrint out;
+  ota.printMetrics(out);
+  assertTrue(strstr(out.buf, "dctransistor_ota_resumes_total 1\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_ota_bytes 32768\n") != NULL);
+}
+
+test(hash_mismatch_fails){
+  RamSink::reset();
+  OtaDownload<RamSink> ota;
+  ota.begin("00000000");
+  ota.setSize(IMAGE_LEN);
+  ImageStream body(0, IMAGE_LEN, IMAGE_LEN);
+  body.arrive();
+  while(ota.receive(body, SLICE_BYTES) > 0){}
+
+  assertEqual(ota.getState(), OTA_FAILED);
+  assertFalse(ota.isReady());
+
+  //Next update check starts over
+  assertTrue(ota.begin(image_hash));
+  assertEqual(ota.getOffset(), (uint32_t)0);
+}
+
+test(write_failure_aborts){
+  RamSink::reset();
+  OtaDownload<RamSink> ota;
+  ota.begin(image_hash);
+  ota.setSize(IMAGE_LEN);
+  RamSink::fail_writes = true;
+
+  ImageStream body(0, IMAGE_LEN, IMAGE_LEN);
+  body.arrive();
+  assertEqual(ota.receive(body, SLICE_BYTES), (uint16_t)0);
+  assertEqual(ota.getState(), OTA_FAILED);
+  assertEqual(RamSink::aborts, (uint8_t)1);
+
+  //Image too big for partition
+  RamSink::reset();
+  ota.begin(image_hash);
+  assertFalse(ota.setSize(IMAGE_LEN * 2));
+  assertEqual(ota.getState(), OTA_FAILED);
+}
+
+test(metrics_report_throughput_and_stall){
+  RamSink::reset();
+  OtaDownload<RamSink> ota;
+  ota.begin(image_hash);
+  ota.setSize(IMAGE_LEN);
+  ota.noteSlice(12);
+  ota.noteSlice(30);
+
+  BufferPrint out;
+  ota.printMetrics(out);
+  assertTrue(strstr(out.buf, "dctransistor_ota_state 2\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_ota_size_bytes 32768\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_ota_slices_total 2\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_ota_stall_ms_total 42\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_ota_stall_max_ms 30\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_ota_throughput_bytes_per_sec ") != NULL);
+}
+
+//Whole image written in one go (as ESPhttpUpdate did), then one slice between each frame
+test(slices_bound_longest_frame_stall){
+  RamSink::reset();
+  RamSink::write_cost_ms = CHUNK_COST_MS;
+
+  OtaDownload<RamSink> blocking;
+  blocking.begin(image_hash);
+  blocking.setSize(IMAGE_LEN);
+  ImageStream all(0, IMAGE_LEN, IMAGE_LEN);
+  all.arrive();
+  uint32_t start = millis();
+  while(blocking.receive(all, 0xFFFF) > 0){}
+  uint32_t blocking_ms = millis() - start;
+  assertTrue(blocking.isReady());
+
+  OtaDownload<RamSink> sliced;
+  sliced.begin(image_hash);
+  sliced.setSize(IMAGE_LEN);
+  ImageStream body(0, IMAGE_LEN, IMAGE_LEN);
+  body.arrive();
+  uint16_t frames = 0;
+  while(sliced.isActive()){
+    start = millis();
+    sliced.receive(body, SLICE_BYTES);
+    sliced.noteSlice(millis() - start);
+    frames++;
+  }
+  assertTrue(sliced.isReady());
+
+  BufferPrint out;
+  sliced.printMetrics(out);
+  const char* max_line = strstr(out.buf, "\ndctransistor_ota_stall_max_ms "); //Sample line, not # TYPE line
+  assertTrue(max_line != NULL);
+  uint32_t sliced_max_ms = strtoul(max_line + strlen("\ndctransistor_ota_stall_max_ms "), NULL, 10);
+
+  Serial.print(F("Longest frame stall: blocking "));
+  Serial.print(blocking_ms);
+  Serial.print(F(" ms, sliced "));
+  Serial.print(sliced_max_ms);
+  Serial.print(F(" ms over "));
+  Serial.print(frames);
+  Serial.println(F(" frames"));
+
+  assertMoreOrEqual(blocking_ms, (uint32_t)(IMAGE_LEN / OTA_CHUNK_LEN * CHUNK_COST_MS));
+  assertMoreOrEqual(sliced_max_ms, (uint32_t)(SLICE_BYTES / OTA_CHUNK_LEN * CHUNK_COST_MS));
+  assertLess(sliced_max_ms * 4, blocking_ms);
+  RamSink::write_cost_ms = 0;
+}
@@ -0,0 +1,104 @@
+#line 2 "SpecialTrainsTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/SpecialTrains.h"
+
+/*
+Unit tests for SpecialTrains lookup by ITT (including hash collisions), capacity, sightings and metrics.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[512];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(add_and_find){
+  SpecialTrains<4> specials;
+  assertEqual(specials.find(123), (int8_t)-1);
+
+  assertTrue(specials.add(123, 0));
+  assertTrue(specials.add(456, 1));
+  assertFalse(specials.add(123, 2)); //Already added
+  assertFalse(specials.add(-1, 2)); //Train not found by check
+
+  assertEqual(specials.getCount(), (uint8_t)2);
+  assertEqual(specials.find(123), (int8_t)0);
+  assertEqual(specials.find(456), (int8_t)1);
+  assertEqual(specials.getPalette(1), (uint8_t)1);
+  assertEqual(specials.find(789), (int8_t)-1);
+  assertEqual(specials.find(-1), (int8_t)-1);
+  assertEqual(specials.getId(3), (int16_t)-1);
+
+  specials.clear();
+  assertEqual(specials.getCount(), (uint8_t)0);
+  assertEqual(specials.find(123), (int8_t)-1);
+}
+
+test(full_set_and_every_id_found){
+  SpecialTrains<8> specials;
+
+  //Consecutive ITTs and multiples of the table size, to force shared slots
+  const int16_t ids[8] = {100, 101, 102, 16, 32, 48, 64, 5000};
+  for(uint8_t i=0; i<8; i++){
+    assertTrue(specials.add(ids[i], i));
+  }
+  assertFalse(specials.add(6000, 0));
+
+  for(uint8_t i=0; i<8; i++){
+    assertEqual(specials.find(ids[i]), (int8_t)i);
+  }
+  for(int16_t id=0; id<1000; id++){
+    int8_t found = specials.find(id);
+    assertTrue(found == -1 || specials.getId(found) == id);
+  }
+}
+
+test(sightings){
+  SpecialTrains<4> specials;
+  specials.add(123, 0);
+  specials.add(456, 1);
+  assertEqual(specials.getLine(0), (int8_t)-1);
+
+  specials.sight(1, 2, 17, 1);
+  assertEqual(specials.getSeenCount(), (uint8_t)1);
+  assertEqual(specials.getLine(1), (int8_t)2);
+  assertEqual(specials.getIndex(1), (uint8_t)17);
+  assertEqual(specials.getDir(1), (uint8_t)1);
+
+  specials.clearSightings();
+  assertEqual(specials.getSeenCount(), (uint8_t)0);
+  assertEqual(specials.getCount(), (uint8_t)2);
+}
+
+test(metrics_per_train){
+  SpecialTrains<4> specials;
+  specials.add(123, 0);
+  specials.add(456, 2);
+  specials.sight(0, 0, 3, 0);
+
+  BufferPrint out;
+  specials.printMetrics(out);
+  assertTrue(strstr(out.buf, "dctransistor_special_trains 2\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_special_train_seen{itt=\"123\",palette=\"0\"} 1\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_special_train_seen{itt=\"456\",palette=\"2\"} 0\n") != NULL);
+}
@@ -0,0 +1,131 @@
+#line 2 "TlsBuffersTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/TlsBuffers.h"
+
+/*
+Unit tests for TlsBuffers probing each host for Max Fragment Length once, choosing the smallest size it accepts, setting
+buffers on every connect, and falling back to full-size buffers when a handshake doesn't agree the probed size.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+//WiFiClientSecure stand-in: server accepts fragment lengths of at least `server_min` (0 = no MFLN support)
+struct FakeTlsClient {
+  uint16_t server_min;
+  bool server_agrees; //Handshake negotiates MFLN (false if server only claimed support in the probe)
+  uint8_t probes;
+  int rx;
+  int tx;
+
+  FakeTlsClient(uint16_t server_min) : server_min(server_min), server_agrees(true), probes(0), rx(0), tx(0) {}
+  bool probeMaxFragmentLength(const char* host, uint16_t port, uint16_t len){
+    probes++;
+    return server_min > 0 && len >= server_min;
+  }
+  void setBufferSizes(int recv, int xmit){
+    rx = recv;
+    tx = xmit;
+  }
+  bool getMFLNStatus(){
+    return server_agrees && server_min > 0 && rx < TLS_DEFAULT_RX_LEN;
+  }
+};
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[1024];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(smallest_accepted_size_probed_once){
+  TlsBuffers<2> buffers;
+  buffers.add("raw.githubusercontent.com");
+  assertEqual(buffers.getRxLen("raw.githubusercontent.com"), (uint16_t)0);
+
+  FakeTlsClient client(512);
+  for(uint8_t i=0; i<3; i++){
+    buffers.prepare(client, "raw.githubusercontent.com", 443);
+    assertEqual(client.rx, 512);
+    assertEqual(client.tx, TLS_TX_LEN);
+    buffers.connected(client, "raw.githubusercontent.com", true);
+  }
+  assertEqual(client.probes, (uint8_t)1); //Cached after first connect
+  assertTrue(buffers.isNegotiated("raw.githubusercontent.com"));
+
+  FakeTlsClient only_1k(1024);
+  TlsBuffers<1> other;
+  other.add("api.wmata.com");
+  other.prepare(only_1k, "api.wmata.com", 443);
+  assertEqual(only_1k.rx, 1024);
+  assertEqual(only_1k.probes, (uint8_t)2);
+}
+
+test(no_mfln_keeps_default_buffers){
+  TlsBuffers<1> buffers;
+  buffers.add("gis.wmata.com");
+  FakeTlsClient client(0);
+  buffers.prepare(client, "gis.wmata.com", 443);
+  assertEqual(client.rx, TLS_DEFAULT_RX_LEN);
+  assertEqual(client.probes, (uint8_t)TLS_NUM_MFLN_SIZES);
+
+  buffers.prepare(client, "gis.wmata.com", 443);
+  assertEqual(client.probes, (uint8_t)TLS_NUM_MFLN_SIZES);
+}
+
+//Small buffers set for one host must not carry over to the next host on the shared client
+test(buffers_set_for_every_host){
+  TlsBuffers<2> buffers;
+  buffers.add("raw.githubusercontent.com");
+  buffers.add("gis.wmata.com");
+  FakeTlsClient small(512);
+  buffers.prepare(small, "raw.githubusercontent.com", 443);
+  assertEqual(small.rx, 512);
+
+  small.server_min = 0; //Same client, next host doesn't do MFLN
+  buffers.prepare(small, "gis.wmata.com", 443);
+  assertEqual(small.rx, TLS_DEFAULT_RX_LEN);
+
+  buffers.prepare(small, "unknown.example.com", 443);
+  assertEqual(small.rx, TLS_DEFAULT_RX_LEN);
+}
+
+test(handshake_without_mfln_falls_back){
+  TlsBuffers<1> buffers;
+  buffers.add("gisservices.wmata.com");
+  FakeTlsClient client(512);
+  client.server_agrees = false;
+
+  buffers.prepare(client, "gisservices.wmata.com", 443);
+  assertEqual(client.rx, 512);
+  buffers.connected(client, "gisservices.wmata.com", false); //Failed connects say nothing about the size
+  assertEqual(buffers.getRxLen("gisservices.wmata.com"), (uint16_t)512);
+  buffers.connected(client, "gisservices.wmata.com", true);
+  assertEqual(buffers.getRxLen("gisservices.wmata.com"), (uint16_t)TLS_DEFAULT_RX_LEN);
+
+  buffers.prepare(client, "gisservices.wmata.com", 443);
+  assertEqual(client.rx, TLS_DEFAULT_RX_LEN);
+
+  BufferPrint out;
+  buffers.printMetrics(out);
+  assertTrue(strstr(out.buf, "dctransistor_tls_rx_buffer_bytes{host=\"gisservices.wmata.com\"} 16384\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_tls_mfln_negotiated{host=\"gisservices.wmata.com\"} 0\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_tls_mfln_fallbacks_total{host=\"gisservices.wmata.com\"} 1\n") != NULL);
+}
@@ -0,0 +1,147 @@
+#line 2 "TlsPinsTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/TlsPins.h"
+
+/*
+Unit tests for TlsPins parsing fingerprint lists as written by the update-fingerprints workflow, trying the pin that
+matched last first, counting handshakes spent on stale pins, and only allowing setInsecure on hosts that ask for it.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define PIN_A "25 A4 C6 13 0A 81 28 F8 01 DC 1B 14 90 88 50 49 93 16 51 37"
+#define PIN_B "72 B7 FA 5A 30 C7 47 F8 BA 69 7F 97 F9 2C 02 A8 00 93 47 72"
+#define PIN_C "3F:87:BE:75:1A:02:3B:A4:D2:51:D2:72:92:A0:00:61:D1:D0:D7:12"
+
+//WiFiClientSecure stand-in: server presents the certificate with fingerprint `served`
+struct FakeTlsClient {
+  uint8_t served[TLS_FINGERPRINT_LEN];
+  uint8_t pinned[TLS_FINGERPRINT_LEN];
+  bool insecure;
+  bool reachable;
+  int last_error;
+  uint8_t handshakes;
+
+  FakeTlsClient(PGM_P cert) : insecure(false), reachable(true), last_error(0), handshakes(0) {
+    parseTlsPin(cert, 0, served);
+  }
+  void setFingerprint(const uint8_t* fingerprint){
+    memcpy(pinned, fingerprint, TLS_FINGERPRINT_LEN);
+    insecure = false;
+  }
+  void setInsecure(){ insecure = true; }
+  bool connect(const char* host, uint16_t port){
+    handshakes++;
+    if(!reachable){
+      last_error = -1;
+      return false;
+    }
+    last_error = (insecure || memcmp(pinned, served, TLS_FINGERPRINT_LEN) == 0) ? 0 : TLS_PIN_MISMATCH;
+    return last_error == 0;
+  }
+  int getLastSSLError(){ return last_error; }
+};
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[1024];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(parses_fingerprint_lists){
+  uint8_t fingerprint[TLS_FINGERPRINT_LEN];
+  assertTrue(parseTlsPin(PSTR(PIN_A ", " PIN_B ", " PIN_C), 2, fingerprint));
+  assertEqual(fingerprint[0], (uint8_t)0x3F);
+  assertEqual(fingerprint[19], (uint8_t)0x12);
+  assertFalse(parseTlsPin(PSTR(PIN_A ", " PIN_B ", " PIN_C), 3, fingerprint));
+  assertFalse(parseTlsPin(PSTR("25 A4 C6"), 0, fingerprint)); //Cut-off fingerprint
+
+  TlsPins<2> pins;
+  assertTrue(pins.add("api.wmata.com", PSTR(PIN_A ", " PIN_B)));
+  assertEqual(pins.getNumPins("api.wmata.com"), (uint8_t)2);
+  assertFalse(pins.add("gis.wmata.com", PSTR("")));
+  assertTrue(pins.add("gis.wmata.com", PSTR(PIN_B)));
+  assertFalse(pins.add("raw.githubusercontent.com", PSTR(PIN_C))); //Full
+}
+
+test(current_pin_is_one_handshake){
+  TlsPins<1> pins;
+  pins.add("api.wmata.com", PSTR(PIN_A ", " PIN_B));
+  FakeTlsClient client(PSTR(PIN_A));
+  for(uint8_t i=0; i<5; i++){
+    assertEqual(pins.connect(client, "api.wmata.com", 443), TLS_CONNECTED);
+  }
+  assertEqual(client.handshakes, (uint8_t)5);
+  assertEqual(pins.getPinMisses("api.wmata.com"), (uint32_t)0);
+}
+
+//Certificate rotated to one the board has as an older pin: one extra handshake once, then one per connection again
+test(rotation_costs_one_miss_once){
+  TlsPins<1> pins;
+  pins.add("api.wmata.com", PSTR(PIN_A ", " PIN_B ", " PIN_C));
+  FakeTlsClient client(PSTR(PIN_C));
+
+  assertEqual(pins.connect(client, "api.wmata.com", 443), TLS_CONNECTED);
+  assertEqual(client.handshakes, (uint8_t)3);
+  assertEqual(pins.getPreferred("api.wmata.com"), (uint8_t)2);
+
+  for(uint8_t i=0; i<5; i++){
+    pins.connect(client, "api.wmata.com", 443);
+  }
+  assertEqual(client.handshakes, (uint8_t)8);
+  assertEqual(pins.getPinMisses("api.wmata.com"), (uint32_t)2);
+  assertFalse(client.insecure);
+}
+
+test(network_error_doesnt_try_other_pins){
+  TlsPins<1> pins;
+  pins.add("api.wmata.com", PSTR(PIN_A ", " PIN_B ", " PIN_C));
+  FakeTlsClient client(PSTR(PIN_A));
+  client.reachable = false;
+
+  assertEqual(pins.connect(client, "api.wmata.com", 443), TLS_CONNECT_FAILED);
+  assertEqual(client.handshakes, (uint8_t)1);
+  assertEqual(pins.getPinMisses("api.wmata.com"), (uint32_t)0);
+
+  assertEqual(pins.connect(client, "example.com", 443), TLS_UNKNOWN_HOST);
+  assertEqual(client.handshakes, (uint8_t)1);
+}
+
+test(insecure_only_when_allowed_and_no_pin_matches){
+  TlsPins<2> pins;
+  pins.add("api.wmata.com", PSTR(PIN_A));
+  pins.add("raw.githubusercontent.com", PSTR(PIN_A ", " PIN_B), true);
+  FakeTlsClient client(PSTR(PIN_C));
+
+  assertEqual(pins.connect(client, "api.wmata.com", 443), TLS_NO_PIN_MATCHED);
+  assertFalse(client.insecure);
+
+  assertEqual(pins.connect(client, "raw.githubusercontent.com", 443), TLS_CONNECTED);
+  assertTrue(client.insecure);
+
+  BufferPrint out;
+  pins.printMetrics(out);
+  assertTrue(strstr(out.buf, "dctransistor_tls_pin_misses_total{host=\"api.wmata.com\"} 1\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_tls_pin_misses_total{host=\"raw.githubusercontent.com\"} 2\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_tls_pin_no_match_total{host=\"api.wmata.com\"} 1\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_tls_insecure_connects_total{host=\"api.wmata.com\"} 0\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_tls_insecure_connects_total{host=\"raw.githubusercontent.com\"} 1\n") != NULL);
+}
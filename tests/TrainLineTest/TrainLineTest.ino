@@ -0,0 +1,165 @@
+#line 2 "TrainLineTest.ino"
+
+#include <AUnit.h>
+
+//Values normally defined in config.h
+#define CYCLES_AT_END 2
+#define TOTAL_SYSTEM_STATIONS 100
+
+#include "../../DCTransistor/FlashData.h"
+#include "../../DCTransistor/TrainLine.h"
+
+/*
+Unit tests for TrainLine class template, instantiated as both the standard (1 direction)
+and bidirectional (2 direction) boards use it. Ends with a simple benchmark of the per-train hot path.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define NUM_TEST_STATIONS 5
+#define TEST_MAX_STATIONS 34
+
+const StationCode test_codes[NUM_TEST_STATIONS] FLASH_TABLE = {"A01", "A02", "A03", "A04", "A05"};
+const uint8_t test_leds_0[NUM_TEST_STATIONS] FLASH_TABLE = {10, 11, 12, 13, 14};
+const uint8_t test_leds_1[NUM_TEST_STATIONS] FLASH_TABLE = {20, 21, 22, 23, 24};
+
+typedef TrainLine<1, TEST_MAX_STATIONS> StandardLine;
+typedef TrainLine<2, TEST_MAX_STATIONS> BidirectionalLine;
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(packed_station_codes){
+  assertEqual(packStationCode("A03"), readStationCode(test_codes, 2));
+  assertNotEqual(packStationCode("A0"), readStationCode(test_codes, 0));
+  assertEqual(packStationCode("N98A"), (uint32_t)0);
+  assertEqual(packStationCode(""), (uint32_t)0);
+}
+
+test(standard_code_to_station){
+  StandardLine line(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0);
+
+  assertEqual(line.setTrainStateByCode("A03-A1-010", 0), 2);
+  assertEqual(line.setTrainStateByCode("A02-A2-010", 1), 1);
+  assertEqual(line.setTrainStateByCode("Z99-A2-010", 1), -1);
+  assertEqual(line.getTrainCount(), (uint8_t)2);
+
+  //Both directions share one state and one LED per station
+  assertTrue(line.getState(0).isSet(2));
+  assertTrue(line.getState(1).isSet(1));
+  assertTrue(line.trainAtLED(12));
+  assertTrue(line.trainAtLED(11));
+  assertFalse(line.trainAtLED(13));
+  assertEqual(line.getLEDForIndex(4, 1), (uint8_t)14);
+
+  line.clearState();
+  assertFalse(line.getState().any());
+  assertEqual(line.getTrainCount(), (uint8_t)0);
+}
+
+test(bidirectional_code_to_station){
+  BidirectionalLine line(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0, test_leds_1);
+
+  line.setTrainStateByCode("A03-A1-010", 0);
+  line.setTrainStateByCode("A02-A2-010", 1);
+
+  assertTrue(line.getState(0).isSet(2));
+  assertFalse(line.getState(0).isSet(1));
+  assertTrue(line.getState(1).isSet(1));
+  assertTrue(line.trainAtLED(12));
+  assertTrue(line.trainAtLED(21));
+  assertFalse(line.trainAtLED(11));
+  assertEqual(line.getLEDForIndex(4, 1), (uint8_t)24);
+  assertEqual(line.getLEDs(1)[0], (uint8_t)20);
+}
+
+test(unknown_direction_skipped){
+  StandardLine standard(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0);
+  BidirectionalLine bidirectional(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0, test_leds_1);
+
+  //TRIP_DIRECTION missing from the feed reads as 0, so the train arrives with direction 255
+  assertEqual(standard.setTrainStateByCode("A05-A1-050", 255), -1);
+  assertEqual(standard.setTrainStateByCode("A03-A1-010", 2), -1);
+  assertEqual(bidirectional.setTrainStateByCode("A01-A2-010", 255), -1);
+  assertEqual(standard.getTrainCount(), (uint8_t)0);
+  assertEqual(bidirectional.getTrainCount(), (uint8_t)0);
+  assertFalse(standard.getState().any());
+  assertFalse(bidirectional.getState(0).any());
+  assertFalse(bidirectional.getState(1).any());
+}
+
+test(end_of_line_track_removed){
+  BidirectionalLine line(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0, test_leds_1);
+
+  //Train sitting on storage track past last station is dropped, but one on the platform is kept
+  assertEqual(line.setTrainStateByCode("A05-A1-150", 0), -1);
+  assertEqual(line.setTrainStateByCode("A05-A1-050", 0), 4);
+  assertEqual(line.setTrainStateByCode("A01-A2-150", 1), -1);
+}
+
+test(end_of_line_times_out){
+  StandardLine line(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0);
+
+  for(uint8_t i=0; i<CYCLES_AT_END; i++){
+    line.clearState();
+    line.setTrainStateByCode("A05-A1-050", 0);
+    line.setEndLED();
+    assertTrue(line.getState().isSet(4));
+  }
+
+  line.clearState();
+  line.setTrainStateByCode("A05-A1-050", 0);
+  line.setEndLED();
+  assertFalse(line.getState().isSet(4));
+}
+
+test(default_shift_display){
+  BidirectionalLine line(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0, test_leds_1);
+
+  line.defaultShiftDisplay(0, true);
+  line.defaultShiftDisplay(1, false);
+  for(uint8_t i=0; i<NUM_TEST_STATIONS-1; i++){
+    line.defaultShiftDisplay(0, false);
+  }
+  assertTrue(line.getState(0).isSet(NUM_TEST_STATIONS-1));
+  assertFalse(line.getState(1).any());
+
+  //Train shifted past last station drops off, even though state has room for more
+  line.defaultShiftDisplay(0, false);
+  assertFalse(line.getState(0).any());
+}
+
+//Time the per-train path (code parse + state set) for both specializations. Prints results; only fails on wrong output.
+template<typename Line>
+uint32_t benchmarkLine(Line &line){
+  const char* trk_ids[4] = {"A01-A1-010", "A03-A2-010", "A04-A1-010", "Z99-A1-010"};
+  const uint16_t iterations = 10000;
+
+  uint32_t start = micros();
+  for(uint16_t i=0; i<iterations; i++){
+    if((i & 63) == 0){line.clearState();}
+    line.setTrainStateByCode(trk_ids[i & 3], (i >> 2) & 1);
+  }
+  return micros() - start;
+}
+
+test(benchmark_set_train_state){
+  StandardLine standard(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0);
+  BidirectionalLine bidirectional(NUM_TEST_STATIONS, test_codes, "Test", 0xFF0000, 100, 100, test_leds_0, test_leds_1);
+
+  uint32_t standard_us = benchmarkLine(standard);
+  uint32_t bidirectional_us = benchmarkLine(bidirectional);
+
+  Serial.print("setTrainStateByCode x10000 (us) - standard: ");
+  Serial.print(standard_us);
+  Serial.print(", bidirectional: ");
+  Serial.println(bidirectional_us);
+
+  assertTrue(standard.getState().any());
+  assertTrue(bidirectional.getState(0).any() || bidirectional.getState(1).any());
+}
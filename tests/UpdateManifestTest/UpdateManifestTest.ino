@@ -0,0 +1,174 @@
+#line 2 "UpdateManifestTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/HttpStream.h"
+#include "../../DCTransistor/UpdateManifest.h"
+
+/*
+Unit tests for UpdateManifest parsing (as written by the compile-sketches workflow), rejecting incomplete manifests
+without losing the last good one, and conditional request headers across 200 / 304 / failed checks.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+//Response body stand-in
+class MemoryStream : public Stream {
+  private:
+    const char* data;
+    size_t len;
+    size_t pos;
+
+  public:
+    MemoryStream(const char* text) : data(text), len(strlen(text)), pos(0) {}
+    int available() override {return len - pos;}
+    int read() override {return (pos < len) ? data[pos++] : -1;}
+    int peek() override {return (pos < len) ? data[pos] : -1;}
+    size_t write(uint8_t) override {return 0;}
+};
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[512];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+const char* full_manifest =
+  "version=2.0.77\n"
+  "size=359643\n"
+  "md5=a6344e83c167f897cc43db9d1ac2c141\n"
+  "delta_base=44e3dac4d5ed5fd09f92d654a986bde5\n"
+  "delta_size=55\n";
+
+const char* etag = "W/\"6b1f0c2a\"";
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(parses_workflow_manifest){
+  UpdateManifest manifest;
+  MemoryStream body(full_manifest);
+  assertTrue(manifest.parse(body, etag));
+
+  assertTrue(manifest.isValid());
+  assertEqual(manifest.getVersion(), "2.0.77");
+  assertEqual(manifest.getSize(), (uint32_t)359643);
+  assertEqual(manifest.getMd5(), "a6344e83c167f897cc43db9d1ac2c141");
+  assertTrue(manifest.hasDelta());
+  assertEqual(manifest.getDeltaBase(), "44e3dac4d5ed5fd09f92d654a986bde5");
+  assertEqual(manifest.getDeltaSize(), (uint32_t)55);
+
+  assertTrue(manifest.differsFrom("2.0.76"));
+  assertFalse(manifest.differsFrom("2.0.77"));
+}
+
+test(no_delta_and_unknown_keys){
+  UpdateManifest manifest;
+  MemoryStream body("version=2.0.77\r\nchannel=beta\r\nsize=359643\r\nmd5=A6344E83C167F897CC43DB9D1AC2C141\r\n");
+  assertTrue(manifest.parse(body, NULL));
+  assertFalse(manifest.hasDelta());
+  assertEqual(manifest.getVersion(), "2.0.77");
+
+  //A delta without its size can't be checked, so isn't used
+  MemoryStream half_delta("version=2.0.77\nsize=1\nmd5=a6344e83c167f897cc43db9d1ac2c141\ndelta_base=44e3dac4d5ed5fd09f92d654a986bde5\n");
+  assertTrue(manifest.parse(half_delta, NULL));
+  assertFalse(manifest.hasDelta());
+}
+
+test(incomplete_manifest_rejected){
+  UpdateManifest manifest;
+
+  MemoryStream no_md5("version=2.0.77\nsize=359643\n");
+  assertFalse(manifest.parse(no_md5, etag));
+  assertFalse(manifest.isValid());
+  assertFalse(manifest.differsFrom("2.0.76")); //Never an update from a bad manifest
+
+  MemoryStream short_md5("version=2.0.77\nsize=359643\nmd5=a6344e83\n");
+  assertFalse(manifest.parse(short_md5, etag));
+
+  MemoryStream html("<html><body>404: Not Found</body></html>");
+  assertFalse(manifest.parse(html, etag));
+
+  MemoryStream long_version("version=2.0.77-with-a-very-long-suffix\nsize=359643\nmd5=a6344e83c167f897cc43db9d1ac2c141\n");
+  assertFalse(manifest.parse(long_version, etag));
+
+  char buf[96];
+  assertEqual(manifest.appendConditionalHeaders(buf, 0, sizeof(buf)), (uint16_t)0);
+}
+
+test(malformed_response_keeps_last_manifest){
+  UpdateManifest manifest;
+  MemoryStream body(full_manifest);
+  assertTrue(manifest.parse(body, etag));
+
+  //A 200 that isn't a manifest (e.g. a captive portal page) is a failure, not an empty manifest
+  MemoryStream html("<html><body>Sign in to WiFi</body></html>");
+  assertFalse(manifest.parse(html, "\"portal\""));
+  MemoryStream no_md5("version=2.0.78\nsize=1\n");
+  assertFalse(manifest.parse(no_md5, NULL));
+
+  assertTrue(manifest.isValid());
+  assertEqual(manifest.getVersion(), "2.0.77");
+  assertEqual(manifest.getMd5(), "a6344e83c167f897cc43db9d1ac2c141");
+  assertTrue(manifest.hasDelta());
+  assertEqual(manifest.getDeltaSize(), (uint32_t)55);
+
+  //Still asks with the last good manifest's ETag
+  char buf[96];
+  uint16_t len = manifest.appendConditionalHeaders(buf, 0, sizeof(buf));
+  buf[len] = '\0';
+  assertEqual(buf, "If-None-Match: W/\"6b1f0c2a\"\r\n");
+
+  BufferPrint out;
+  manifest.printMetrics(out);
+  assertTrue(strstr(out.buf, "dctransistor_update_manifest_failures_total 2\n") != NULL);
+}
+
+test(conditional_get_after_manifest){
+  UpdateManifest manifest;
+  char buf[96];
+  assertEqual(manifest.appendConditionalHeaders(buf, 0, sizeof(buf)), (uint16_t)0);
+
+  MemoryStream body(full_manifest);
+  manifest.parse(body, etag);
+  uint16_t len = manifest.appendConditionalHeaders(buf, 0, sizeof(buf));
+  buf[len] = '\0';
+  assertEqual(buf, "If-None-Match: W/\"6b1f0c2a\"\r\n");
+
+  //304 and failed checks keep the last manifest, so a failed update is tried again
+  manifest.notModified();
+  manifest.failed();
+  assertTrue(manifest.differsFrom("2.0.76"));
+  assertTrue(manifest.hasDelta());
+
+  BufferPrint out;
+  manifest.printMetrics(out);
+  assertTrue(strstr(out.buf, "dctransistor_update_manifest_downloads_total 1\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_update_manifest_not_modified_total 1\n") != NULL);
+  assertTrue(strstr(out.buf, "dctransistor_update_manifest_failures_total 1\n") != NULL);
+}
+
+test(truncated_etag_not_sent){
+  UpdateManifest manifest;
+  char long_etag[MANIFEST_ETAG_LEN]; /* Flawfinder: ignore */
+  memset(long_etag, 'a', sizeof(long_etag) - 1);
+  long_etag[sizeof(long_etag) - 1] = '\0';
+
+  MemoryStream body(full_manifest);
+  assertTrue(manifest.parse(body, long_etag));
+  char buf[96];
+  assertEqual(manifest.appendConditionalHeaders(buf, 0, sizeof(buf)), (uint16_t)0);
+}
@@ -0,0 +1,64 @@
+#line 2 "WallClockTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/WallClock.h"
+
+/*
+Unit tests for WallClock source preference, advancing harvested time with millis(), and HTTP Date parsing.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(parse_http_date){
+  assertEqual((long long)parseHttpDate("Sun, 06 Nov 1994 08:49:37 GMT"), 784111777LL);
+  assertEqual((long long)parseHttpDate("Thu, 29 Feb 2024 00:00:00 GMT"), 1709164800LL);
+  assertEqual((long long)parseHttpDate("Thu, 01 Jan 1970 00:00:00 GMT"), 0LL);
+
+  assertEqual((long long)parseHttpDate(""), 0LL);
+  assertEqual((long long)parseHttpDate("06 Nov 1994 08:49:37 GMT"), 0LL);
+  assertEqual((long long)parseHttpDate("Sun, 06 Foo 1994 08:49:37 GMT"), 0LL);
+  assertEqual((long long)parseHttpDate("Sun, 06 ovD 1994 08:49:37 GMT"), 0LL);
+}
+
+test(no_source){
+  WallClock clock;
+  assertEqual(clock.epochMs(0), (uint64_t)0);
+  assertEqual(clock.getSource(), CLOCK_NONE);
+}
+
+test(prefers_feed_then_sntp_then_date){
+  WallClock clock;
+  assertTrue(clock.setFromHttpDate("Thu, 29 Feb 2024 00:00:00 GMT"));
+  assertFalse(clock.setFromHttpDate("garbage"));
+  assertMoreOrEqual(clock.epochMs(0), (uint64_t)1709164800000ULL);
+  assertEqual(clock.getSource(), CLOCK_HTTP_DATE);
+
+  assertEqual(clock.epochMs(1750000000000ULL), (uint64_t)1750000000000ULL);
+  assertEqual(clock.getSource(), CLOCK_SNTP);
+
+  clock.setFromFeed(0); //Feed with no ETIMEs doesn't count
+  clock.epochMs(1750000000000ULL);
+  assertEqual(clock.getSource(), CLOCK_SNTP);
+
+  clock.setFromFeed(1760000000000ULL);
+  assertLess(clock.epochMs(1750000000000ULL) - 1760000000000ULL, (uint64_t)5);
+  assertEqual(clock.getSource(), CLOCK_FEED);
+}
+
+test(feed_time_advances_with_millis){
+  WallClock clock;
+  clock.setFromFeed(1760000000000ULL);
+  delay(30);
+  uint64_t elapsed = clock.epochMs(0) - 1760000000000ULL;
+  assertMoreOrEqual(elapsed, (uint64_t)30);
+  assertLess(elapsed, (uint64_t)100);
+}
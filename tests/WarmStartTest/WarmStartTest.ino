@@ -0,0 +1,155 @@
+#line 2 "WarmStartTest.ino"
+
+#include <AUnit.h>
+
+//Values normally defined in config.h
+#define CYCLES_AT_END 2
+#define TOTAL_SYSTEM_STATIONS 100
+#define MAX_SPECIAL_TRAINS 4
+
+#include "../../DCTransistor/FlashData.h"
+#include "../../DCTransistor/TrainLine.h"
+#include "../../DCTransistor/FlashFile.h"
+#include "../../DCTransistor/SpecialTrains.h"
+#include "../../DCTransistor/WarmStart.h"
+
+/*
+Unit tests for WarmStart save / restore round trip (line states and special trains), rejecting corrupt or mismatched snapshots, and write batching.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+#define NUM_TEST_LINES 2
+
+const StationCode test_codes[3] FLASH_TABLE = {"A01", "A02", "A03"};
+const uint8_t test_leds[3] FLASH_TABLE = {10, 11, 12};
+
+typedef TrainLine<2, 34> TestLine;
+
+TestLine red(3, test_codes, "Red", 0xFF0000, 100, 100, test_leds, test_leds);
+TestLine blue(3, test_codes, "Blue", 0x0000FF, 100, 100, test_leds, test_leds);
+TestLine* test_lines[NUM_TEST_LINES] = {&red, &blue};
+
+//Flash file stand-in
+struct RamStore {
+  static uint8_t data[256];
+  static size_t len;
+  static uint32_t writes;
+  static bool read(uint8_t* out, size_t n){
+    if(n != len){return false;}
+    memcpy(out, data, n);
+    return true;
+  }
+  static bool write(const uint8_t* in, size_t n){
+    if(n > sizeof(data)){return false;}
+    memcpy(data, in, n);
+    len = n;
+    writes++;
+    return true;
+  }
+};
+uint8_t RamStore::data[256];
+size_t RamStore::len = 0;
+uint32_t RamStore::writes = 0;
+
+typedef WarmStart<RamStore, NUM_TEST_LINES, 2, 34> TestWarmStart;
+
+SpecialTrains<4> no_specials;
+
+void clearLines(){
+  red.clearState();
+  blue.clearState();
+}
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(crc32_check_value){
+  assertEqual(crc32((const uint8_t*)"123456789", 9), (uint32_t)0xCBF43926);
+}
+
+test(round_trip){
+  RamStore::len = 0;
+  clearLines();
+  red.setTrainStateByCode("A02-A1-010", 0);
+  blue.setTrainStateByCode("A01-A1-010", 1);
+  blue.setTrainStateByCode("A03-A1-010", 1);
+
+  SpecialTrains<4> specials;
+  specials.add(123, 0);
+  specials.add(456, 2);
+  specials.sight(0, 1, 2, 1);
+  TestWarmStart saver(600000);
+  assertTrue(saver.update(test_lines, specials));
+  clearLines();
+
+  SpecialTrains<4> loaded_specials;
+  TestWarmStart loader(600000);
+  assertTrue(loader.load());
+  loader.restore(test_lines, loaded_specials);
+
+  assertTrue(red.getState(0).isSet(1));
+  assertEqual(red.getTrainCount(), (uint8_t)1);
+  assertTrue(blue.getState(1).isSet(0));
+  assertTrue(blue.getState(1).isSet(2));
+  assertEqual(blue.getTrainCount(), (uint8_t)2);
+
+  assertEqual(loaded_specials.getCount(), (uint8_t)2);
+  assertEqual(loaded_specials.getId(0), (int16_t)123);
+  assertEqual(loaded_specials.getLine(0), (int8_t)1);
+  assertEqual(loaded_specials.getIndex(0), (uint8_t)2);
+  assertEqual(loaded_specials.getDir(0), (uint8_t)1);
+  assertEqual(loaded_specials.find(456), (int8_t)1);
+  assertEqual(loaded_specials.getPalette(1), (uint8_t)2);
+  assertEqual(loaded_specials.getLine(1), (int8_t)-1); //Not on the board when saved
+  clearLines();
+}
+
+test(rejects_corrupt_or_other_shape){
+  RamStore::len = 0;
+  TestWarmStart empty(0);
+  assertFalse(empty.load());
+
+  clearLines();
+  red.setTrainStateByCode("A02-A1-010", 0);
+  TestWarmStart saver(0);
+  assertTrue(saver.update(test_lines, no_specials));
+
+  //Saved by a board with a different number of lines
+  WarmStart<RamStore, 1, 2, 34> other_board(0);
+  assertFalse(other_board.load());
+
+  RamStore::data[20] ^= 0x01;
+  TestWarmStart loader(0);
+  assertFalse(loader.load());
+  assertFalse(loader.wasLoaded());
+  clearLines();
+}
+
+test(writes_are_batched){
+  RamStore::len = 0;
+  RamStore::writes = 0;
+  clearLines();
+  TestWarmStart warm(60000);
+
+  //First live frame is written straight away
+  red.setTrainStateByCode("A01-A1-010", 0);
+  assertTrue(warm.update(test_lines, no_specials));
+
+  //Same frame never rewritten, new frame waits out the interval
+  assertFalse(warm.update(test_lines, no_specials));
+  red.setTrainStateByCode("A02-A1-010", 0);
+  assertFalse(warm.update(test_lines, no_specials));
+  assertEqual(RamStore::writes, (uint32_t)1);
+
+  //Flush writes the waiting frame once
+  assertTrue(warm.flush());
+  assertFalse(warm.flush());
+  assertEqual(warm.getWrites(), (uint32_t)2);
+  clearLines();
+}
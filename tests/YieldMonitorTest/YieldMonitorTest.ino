@@ -0,0 +1,99 @@
+#line 2 "YieldMonitorTest.ino"
+
+#include <AUnit.h>
+
+#include "../../DCTransistor/LoopProfiler.h"
+#include "../../DCTransistor/YieldMonitor.h"
+
+/*
+Unit tests for YieldMonitor gap measurement, phase attribution, budget handler and metrics format.
+Compiles for EpoxyDuino - can run on both Arduino and linux.
+*/
+
+//Print into a fixed buffer to check formatted output
+class BufferPrint : public Print {
+  public:
+    char buf[1024];
+    size_t len;
+    BufferPrint() : len(0) {buf[0] = '\0';}
+    size_t write(uint8_t c) override {
+      if(len >= sizeof(buf) - 1){return 0;}
+      buf[len++] = c;
+      buf[len] = '\0';
+      return 1;
+    }
+};
+
+//Budget handler calls
+uint32_t exceeded_calls = 0;
+uint8_t exceeded_phase = 0;
+
+void countExceeded(uint8_t phase, uint32_t gap_us){
+  exceeded_calls++;
+  exceeded_phase = phase;
+}
+
+void setup() {
+  Serial.begin(9600);
+}//END SETUP
+
+void loop() {
+  aunit::TestRunner::run();
+}//END LOOP
+
+
+test(gap_charged_to_current_phase){
+  YieldMonitor monitor;
+  monitor.setPhase(PROF_DESERIALIZE);
+  delay(5);
+  monitor.yieldPoint();
+
+  assertMoreOrEqual(monitor.getMaxGap(PROF_DESERIALIZE), (uint32_t)5000);
+  assertEqual(monitor.getMaxGap(PROF_SETUP), (uint32_t)0);
+  assertEqual(monitor.getMaxGapAll(), monitor.getMaxGap(PROF_DESERIALIZE));
+
+  //Short gap doesn't lower the max
+  uint32_t longest = monitor.getMaxGap(PROF_DESERIALIZE);
+  monitor.yieldPoint();
+  assertEqual(monitor.getMaxGap(PROF_DESERIALIZE), longest);
+
+  //Out of range phase is ignored
+  monitor.setPhase(NUM_PROFILE_PHASES);
+  monitor.markYield();
+  assertEqual(monitor.getMaxGap(PROF_DESERIALIZE), longest);
+
+  monitor.reset();
+  assertEqual(monitor.getMaxGapAll(), (uint32_t)0);
+}
+
+test(over_budget_calls_handler){
+  YieldMonitor monitor;
+  exceeded_calls = 0;
+  monitor.setBudget(2000, countExceeded);
+  monitor.setPhase(PROF_COMPOSITE);
+
+  monitor.yieldPoint(); //Well under budget
+  assertEqual(exceeded_calls, (uint32_t)0);
+
+  delay(4);
+  monitor.markYield();
+  assertEqual(exceeded_calls, (uint32_t)1);
+  assertEqual(exceeded_phase, (uint8_t)PROF_COMPOSITE);
+  assertEqual(monitor.getOverBudget(PROF_COMPOSITE), (uint32_t)1);
+  assertEqual(monitor.getOverBudget(PROF_SETUP), (uint32_t)0);
+}
+
+test(metrics_skip_unused_phases){
+  YieldMonitor monitor;
+  monitor.setBudget(1000, countExceeded);
+  monitor.setPhase(PROF_SHOW);
+  delay(2);
+  monitor.yieldPoint();
+
+  BufferPrint out;
+  monitor.printMetrics(out);
+
+  assertNotEqual(strstr(out.buf, "dctransistor_yield_gap_max_us{phase=\"show\"} "), (char*)NULL);
+  assertNotEqual(strstr(out.buf, "dctransistor_yield_over_budget_total{phase=\"show\"} 1\n"), (char*)NULL);
+  assertEqual(strstr(out.buf, "phase=\"dns\""), (char*)NULL);
+}